@@ -116,6 +116,8 @@ BinaryDataType type2BinaryDataType(Type *type) {
 BinaryDataType getLagerBinaryDataType(BinaryDataType binaryDataType1, BinaryDataType binaryDataType2) {
     if (binaryDataType1 == BinaryDataType::F64 || binaryDataType2 == BinaryDataType::F64) {
         return BinaryDataType::F64;
+    } else if (binaryDataType1 == BinaryDataType::F32 || binaryDataType2 == BinaryDataType::F32) {
+        return BinaryDataType::F32;
     } else if (binaryDataType1 == BinaryDataType::U64 || binaryDataType2 == BinaryDataType::U64) {
         return BinaryDataType::U64;
     } else if (binaryDataType1 == BinaryDataType::I64 || binaryDataType2 == BinaryDataType::I64) {
@@ -136,6 +138,49 @@ BinaryDataType getLagerBinaryDataType(BinaryDataType binaryDataType1, BinaryData
     assert(false);
 }
 
+/**
+ * 表达式为整数、字符或浮点数字面量时，得到它入栈后再经过从sourceBinaryDataType到targetBinaryDataType的转换所得到的值，
+ * 用作带立即数的运算指令的右值，与先压入字面量、再转换、再运算的指令序列的结果完全相同。
+ */
+bool getLiteralImmediate(Expression *expression, BinaryDataType sourceBinaryDataType, BinaryDataType targetBinaryDataType, std::uint64_t &immediate) {
+    switch (expression->getClass()) {
+        case ExpressionClass::INT_LITERAL_EXPRESSION:
+            immediate = Instruction(Opcode::PUSH_64, (std::int32_t) reinterpret_cast<IntegerLiteralExpression *>(expression)->value).operand.u64;
+            break;
+        case ExpressionClass::CHAR_LITERAL_EXPRESSION:
+            immediate = Instruction(Opcode::PUSH_64, (std::int8_t) reinterpret_cast<CharacterLiteralExpression *>(expression)->value).operand.u64;
+            break;
+        case ExpressionClass::FLOAT_LITERAL_EXPRESSION:
+            immediate = Instruction(Opcode::PUSH_64, (double) reinterpret_cast<FloatingPointLiteralExpression *>(expression)->value).operand.u64;
+            break;
+        default:
+            return false;
+    }
+    immediate = InstructionSequenceBuilder::castConstant(immediate, sourceBinaryDataType, targetBinaryDataType);
+    return true;
+}
+
+/**
+ * 自增和自减运算中数值类型的步长1。
+ */
+std::uint64_t getUnitImmediate(BinaryDataType binaryDataType) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            return 1;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            return Instruction(Opcode::PUSH_64, static_cast<double>(1)).operand.u64;
+    }
+    assert(false);
+}
+
 CodeGenerateVisitor::CodeGenerateVisitor(SymbolTable *symbolTable, StringConstantPool *stringConstantPool) : symbolTable(symbolTable), stringConstantPool(stringConstantPool) {
     this->symbolTableIterator = std::unique_ptr<SymbolTableIterator>(this->symbolTable->createIterator());
 }
@@ -143,7 +188,7 @@ CodeGenerateVisitor::CodeGenerateVisitor(SymbolTable *symbolTable, StringConstan
 void CodeGenerateVisitor::patchFunctionPlaceholderAddress(const std::string& identifier, std::uint64_t realAddress) {
     if (functionPlaceholderIndexMap.contains(identifier)) {
         for (auto instructionIndex : functionPlaceholderIndexMap[identifier]) {
-            instructionSequenceBuilder->modifyPush(instructionIndex, realAddress);
+            instructionSequenceBuilder->modifyAddress(instructionIndex, realAddress);
         }
         functionPlaceholderIndexMap.erase(identifier);
     }
@@ -152,7 +197,7 @@ void CodeGenerateVisitor::patchFunctionPlaceholderAddress(const std::string& ide
 void CodeGenerateVisitor::patchStatementPlaceholderAddress(const std::string& identifier, std::uint64_t realAddress) {
     if (statementPlaceholderIndexMap.contains(identifier)) {
         for (auto instructionIndex : statementPlaceholderIndexMap[identifier]) {
-            instructionSequenceBuilder->modifyPush(instructionIndex, realAddress);
+            instructionSequenceBuilder->modifyAddress(instructionIndex, realAddress);
         }
         statementPlaceholderIndexMap.erase(identifier);
     }
@@ -160,13 +205,129 @@ void CodeGenerateVisitor::patchStatementPlaceholderAddress(const std::string& id
 
 void CodeGenerateVisitor::patchBreakPushAddress(std::uint64_t realAddress) {
     for (auto instructionIndex : breakPushIndexListStack.top()) {
-        instructionSequenceBuilder->modifyPush(instructionIndex, realAddress);
+        instructionSequenceBuilder->modifyAddress(instructionIndex, realAddress);
     }
 }
 
 void CodeGenerateVisitor::patchContinuePushAddress(std::uint64_t realAddress) {
     for (auto instructionIndex : continuePushIndexListStack.top()) {
-        instructionSequenceBuilder->modifyPush(instructionIndex, realAddress);
+        instructionSequenceBuilder->modifyAddress(instructionIndex, realAddress);
+    }
+}
+
+void CodeGenerateVisitor::patchJumpAddress(const std::vector<int> &jumpIndexList, std::uint64_t realAddress) {
+    for (auto instructionIndex : jumpIndexList) {
+        instructionSequenceBuilder->modifyAddress(instructionIndex, realAddress);
+    }
+}
+
+/**
+ * 生成条件判断的跳转指令，条件的真假与jumpCondition相同时跳转到address，否则继续执行后面的指令。
+ * 条件为关系或相等表达式时直接生成比较并跳转的指令，不再把比较的结果压入栈中再判断。
+ * 条件为逻辑与、逻辑或、逻辑非表达式时按短路求值的规则拆分为操作数各自的条件跳转，同样不计算出逻辑值。
+ * 生成的跳转指令的索引会记录到jumpIndexList中，用于在跳转地址确定后修改占位地址。
+ */
+void CodeGenerateVisitor::generateConditionalJump(Expression *condition, bool jumpCondition, std::uint64_t address, std::vector<int> &jumpIndexList) {
+    if (condition->getClass() == ExpressionClass::UNARY_EXPRESSION && reinterpret_cast<UnaryExpression *>(condition)->unaryOperator == UnaryOperator::LOGICAL_NOT) {
+        generateConditionalJump(reinterpret_cast<UnaryExpression *>(condition)->operand, !jumpCondition, address, jumpIndexList);
+        return;
+    }
+    if (condition->getClass() == ExpressionClass::BINARY_EXPRESSION) {
+        auto binaryExpression = reinterpret_cast<BinaryExpression *>(condition);
+        switch (binaryExpression->binaryOperator) {
+            case BinaryOperator::LOGICAL_AND:
+            case BinaryOperator::LOGICAL_OR: {
+                // 逻辑与在左操作数为假时、逻辑或在左操作数为真时短路，不再计算右操作数
+                bool shortCircuitCondition = binaryExpression->binaryOperator == BinaryOperator::LOGICAL_OR;
+                if (shortCircuitCondition == jumpCondition) {
+                    // 短路时整个条件的真假正好需要跳转，左右操作数都直接跳转到address
+                    generateConditionalJump(binaryExpression->leftOperand, jumpCondition, address, jumpIndexList);
+                    generateConditionalJump(binaryExpression->rightOperand, jumpCondition, address, jumpIndexList);
+                } else {
+                    // 短路时整个条件的真假不需要跳转，左操作数短路时跳过右操作数的判断
+                    std::vector<int> shortCircuitJumpIndexList;
+                    generateConditionalJump(binaryExpression->leftOperand, shortCircuitCondition, 0, shortCircuitJumpIndexList); // 占位
+                    generateConditionalJump(binaryExpression->rightOperand, jumpCondition, address, jumpIndexList);
+                    patchJumpAddress(shortCircuitJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
+                }
+                return;
+            }
+            case BinaryOperator::LESS:
+            case BinaryOperator::GREATER:
+            case BinaryOperator::LESS_EQUAL:
+            case BinaryOperator::GREATER_EQUAL:
+            case BinaryOperator::EQUAL:
+            case BinaryOperator::NOT_EQUAL: {
+                BinaryDataType leftBinaryDataType = type2BinaryDataType(binaryExpression->leftOperand->resultType);
+                BinaryDataType rightBinaryDataType = type2BinaryDataType(binaryExpression->rightOperand->resultType);
+                BinaryDataType compareBinaryDataType = getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType);
+                needLoadValue = true;
+                visit(binaryExpression->leftOperand);
+                instructionSequenceBuilder->appendCast(leftBinaryDataType, compareBinaryDataType);
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, compareBinaryDataType);
+                jumpIndexList.push_back(instructionSequenceBuilder->getNextInstructionIndex());
+                // 与求值时相同，a <= b按!(a > b)、a >= b按!(a < b)、a != b按!(a == b)判断，浮点数为NaN时的结果保持一致
+                switch (binaryExpression->binaryOperator) {
+                    case BinaryOperator::LESS:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBlt(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBge(compareBinaryDataType, address);
+                        }
+                        break;
+                    case BinaryOperator::GREATER:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBgt(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBle(compareBinaryDataType, address);
+                        }
+                        break;
+                    case BinaryOperator::LESS_EQUAL:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBle(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBgt(compareBinaryDataType, address);
+                        }
+                        break;
+                    case BinaryOperator::GREATER_EQUAL:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBge(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBlt(compareBinaryDataType, address);
+                        }
+                        break;
+                    case BinaryOperator::EQUAL:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBeq(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBne(compareBinaryDataType, address);
+                        }
+                        break;
+                    case BinaryOperator::NOT_EQUAL:
+                        if (jumpCondition) {
+                            instructionSequenceBuilder->appendBne(compareBinaryDataType, address);
+                        } else {
+                            instructionSequenceBuilder->appendBeq(compareBinaryDataType, address);
+                        }
+                        break;
+                    default:
+                        assert(false);
+                }
+                return;
+            }
+            default:
+                break;
+        }
+    }
+    needLoadValue = true;
+    visit(condition);
+    jumpIndexList.push_back(instructionSequenceBuilder->getNextInstructionIndex());
+    if (jumpCondition) {
+        instructionSequenceBuilder->appendJnz(address);
+    } else {
+        instructionSequenceBuilder->appendJz(address);
     }
 }
 
@@ -290,18 +451,22 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
     BinaryDataType leftBinaryDataType = type2BinaryDataType(binaryExpression->leftOperand->resultType);
     BinaryDataType rightBinaryDataType = type2BinaryDataType(binaryExpression->rightOperand->resultType);
     BinaryDataType resultBinaryDataType = type2BinaryDataType(binaryExpression->resultType);
+    std::uint64_t immediate; // 右操作数为字面量时使用带立即数的指令，不再压入右操作数
     switch (binaryExpression->binaryOperator) {
         case BinaryOperator::SUBSCRIPT: {
             bool originNeedLoadValue = needLoadValue;
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, BinaryDataType::U64);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(binaryExpression->resultType)));
-            instructionSequenceBuilder->appendMul(BinaryDataType::U64);
-            instructionSequenceBuilder->appendAdd(BinaryDataType::U64);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                instructionSequenceBuilder->appendAdd(BinaryDataType::U64, immediate * static_cast<std::uint64_t>(getTypeByteNum(binaryExpression->resultType)));
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(binaryExpression->resultType)));
+                instructionSequenceBuilder->appendAdd(BinaryDataType::U64);
+            }
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->resultType));
             }
@@ -311,186 +476,248 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
-            instructionSequenceBuilder->appendMul(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendMul(resultBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendMul(resultBinaryDataType);
+            }
             break;
         case BinaryOperator::DIV:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
-            instructionSequenceBuilder->appendDiv(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendDiv(resultBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendDiv(resultBinaryDataType);
+            }
             break;
         case BinaryOperator::ADD:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             if (binaryExpression->rightOperand->resultType->getClass() == TypeClass::POINTER_TYPE || binaryExpression->rightOperand->resultType->getClass() == TypeClass::ARRAY_TYPE) {
                 instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
             } else {
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
             }
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
             if (binaryExpression->leftOperand->resultType->getClass() == TypeClass::POINTER_TYPE || binaryExpression->leftOperand->resultType->getClass() == TypeClass::ARRAY_TYPE) {
-                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                    instructionSequenceBuilder->appendAdd(resultBinaryDataType, immediate * static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                } else {
+                    needLoadValue = true;
+                    visit(binaryExpression->rightOperand);
+                    instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                    instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                    instructionSequenceBuilder->appendAdd(resultBinaryDataType);
+                }
+            } else if (getLiteralImmediate(binaryExpression->rightOperand, leftBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendAdd(resultBinaryDataType, immediate);
             } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendAdd(resultBinaryDataType);
             }
-            instructionSequenceBuilder->appendAdd(resultBinaryDataType);
             break;
         case BinaryOperator::SUB:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             if (binaryExpression->rightOperand->resultType->getClass() == TypeClass::POINTER_TYPE || binaryExpression->rightOperand->resultType->getClass() == TypeClass::ARRAY_TYPE) {
                 instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
             } else {
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
             }
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
             if (binaryExpression->leftOperand->resultType->getClass() == TypeClass::POINTER_TYPE || binaryExpression->leftOperand->resultType->getClass() == TypeClass::ARRAY_TYPE) {
-                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                    instructionSequenceBuilder->appendSub(resultBinaryDataType, immediate * static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                } else {
+                    needLoadValue = true;
+                    visit(binaryExpression->rightOperand);
+                    instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                    instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                    instructionSequenceBuilder->appendSub(resultBinaryDataType);
+                }
+            } else if (getLiteralImmediate(binaryExpression->rightOperand, leftBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendSub(resultBinaryDataType, immediate);
             } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendSub(resultBinaryDataType);
             }
-            instructionSequenceBuilder->appendSub(resultBinaryDataType);
             break;
         case BinaryOperator::MOD:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
-            instructionSequenceBuilder->appendMod(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendMod(resultBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendMod(resultBinaryDataType);
+            }
             break;
         case BinaryOperator::SHIFT_LEFT:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-            instructionSequenceBuilder->appendSl(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                instructionSequenceBuilder->appendSl(resultBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                instructionSequenceBuilder->appendSl(resultBinaryDataType);
+            }
             break;
         case BinaryOperator::SHIFT_RIGHT:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-            instructionSequenceBuilder->appendSr(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                instructionSequenceBuilder->appendSr(resultBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                instructionSequenceBuilder->appendSr(resultBinaryDataType);
+            }
             break;
         case BinaryOperator::BITWISE_AND:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendAnd();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, rightBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendAnd(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendAnd();
+            }
             break;
         case BinaryOperator::BITWISE_XOR:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendXor();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, rightBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendXor(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendXor();
+            }
             break;
         case BinaryOperator::BITWISE_OR:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendOr();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, rightBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendOr(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendOr();
+            }
             break;
         case BinaryOperator::LESS:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendLt(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendLt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendLt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
             break;
         case BinaryOperator::GREATER:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendGt(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendGt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendGt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
             break;
         case BinaryOperator::LESS_EQUAL:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendGt(resultBinaryDataType);
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-            instructionSequenceBuilder->appendXor();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendGt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendGt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
+            instructionSequenceBuilder->appendXor(static_cast<std::uint64_t>(1));
             break;
         case BinaryOperator::GREATER_EQUAL:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendLt(resultBinaryDataType);
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-            instructionSequenceBuilder->appendXor();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendLt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendLt(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
+            instructionSequenceBuilder->appendXor(static_cast<std::uint64_t>(1));
             break;
         case BinaryOperator::EQUAL:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendEq(resultBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendEq(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendEq(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
             break;
         case BinaryOperator::NOT_EQUAL:
             needLoadValue = true;
             visit(binaryExpression->leftOperand);
             instructionSequenceBuilder->appendCast(leftBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
-            instructionSequenceBuilder->appendEq(resultBinaryDataType);
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-            instructionSequenceBuilder->appendXor();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate)) {
+                instructionSequenceBuilder->appendEq(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType), immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+                instructionSequenceBuilder->appendEq(getLagerBinaryDataType(leftBinaryDataType, rightBinaryDataType));
+            }
+            instructionSequenceBuilder->appendXor(static_cast<std::uint64_t>(1));
             break;
         case BinaryOperator::LOGICAL_AND:
-            needLoadValue = true;
-            visit(binaryExpression->leftOperand);
-            instructionSequenceBuilder->appendTb();
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendTb();
-            instructionSequenceBuilder->appendAnd();
-            break;
-        case BinaryOperator::LOGICAL_OR:
-            needLoadValue = true;
-            visit(binaryExpression->leftOperand);
-            instructionSequenceBuilder->appendTb();
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendTb();
-            instructionSequenceBuilder->appendOr();
+        case BinaryOperator::LOGICAL_OR: {
+            // 按短路求值的规则生成条件跳转，再根据跳转的结果压入1或0
+            std::vector<int> falseJumpIndexList;
+            generateConditionalJump(binaryExpression, false, 0, falseJumpIndexList); // 占位
+            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
+            int instructionIndex1 = instructionSequenceBuilder->getNextInstructionIndex();
+            instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(0)); // 占位
+            patchJumpAddress(falseJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
+            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0));
+            instructionSequenceBuilder->modifyAddress(instructionIndex1, instructionSequenceBuilder->getNextInstructionAddress());
             break;
+        }
         case BinaryOperator::ASSIGN: {
             bool originNeedLoadValue = needLoadValue;
             needLoadValue = false;
@@ -512,10 +739,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
-            instructionSequenceBuilder->appendMul(leftBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, leftBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendMul(leftBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
+                instructionSequenceBuilder->appendMul(leftBinaryDataType);
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -529,10 +760,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
-            instructionSequenceBuilder->appendDiv(leftBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, leftBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendDiv(leftBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
+                instructionSequenceBuilder->appendDiv(leftBinaryDataType);
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -546,16 +781,24 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
             if (binaryExpression->leftOperand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                    instructionSequenceBuilder->appendAdd(leftBinaryDataType, immediate * static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                } else {
+                    needLoadValue = true;
+                    visit(binaryExpression->rightOperand);
+                    instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                    instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                    instructionSequenceBuilder->appendAdd(leftBinaryDataType);
+                }
+            } else if (getLiteralImmediate(binaryExpression->rightOperand, leftBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendAdd(leftBinaryDataType, immediate);
             } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendAdd(leftBinaryDataType);
             }
-            instructionSequenceBuilder->appendAdd(leftBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -569,16 +812,24 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
             if (binaryExpression->leftOperand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
-                instructionSequenceBuilder->appendMul(BinaryDataType::U64);
+                if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                    instructionSequenceBuilder->appendSub(leftBinaryDataType, immediate * static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                } else {
+                    needLoadValue = true;
+                    visit(binaryExpression->rightOperand);
+                    instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                    instructionSequenceBuilder->appendMul(BinaryDataType::U64, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(binaryExpression->resultType)->sourceType)));
+                    instructionSequenceBuilder->appendSub(leftBinaryDataType);
+                }
+            } else if (getLiteralImmediate(binaryExpression->rightOperand, leftBinaryDataType, resultBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendSub(leftBinaryDataType, immediate);
             } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
                 instructionSequenceBuilder->appendCast(leftBinaryDataType, resultBinaryDataType);
+                instructionSequenceBuilder->appendSub(leftBinaryDataType);
             }
-            instructionSequenceBuilder->appendSub(leftBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -592,10 +843,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
-            instructionSequenceBuilder->appendMod(leftBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, leftBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendMod(leftBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
+                instructionSequenceBuilder->appendMod(leftBinaryDataType);
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -609,10 +864,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-            instructionSequenceBuilder->appendSl(leftBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                instructionSequenceBuilder->appendSl(leftBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                instructionSequenceBuilder->appendSl(leftBinaryDataType);
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -626,10 +885,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
-            instructionSequenceBuilder->appendSr(leftBinaryDataType);
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, BinaryDataType::U64, immediate)) {
+                instructionSequenceBuilder->appendSr(leftBinaryDataType, immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, BinaryDataType::U64);
+                instructionSequenceBuilder->appendSr(leftBinaryDataType);
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -643,9 +906,13 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendAnd();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, rightBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendAnd(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendAnd();
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -659,9 +926,13 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendXor();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, rightBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendXor(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendXor();
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -675,10 +946,14 @@ void CodeGenerateVisitor::visit(BinaryExpression *binaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
-            needLoadValue = true;
-            visit(binaryExpression->rightOperand);
-            instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
-            instructionSequenceBuilder->appendOr();
+            if (getLiteralImmediate(binaryExpression->rightOperand, rightBinaryDataType, leftBinaryDataType, immediate)) {
+                instructionSequenceBuilder->appendOr(immediate);
+            } else {
+                needLoadValue = true;
+                visit(binaryExpression->rightOperand);
+                instructionSequenceBuilder->appendCast(rightBinaryDataType, leftBinaryDataType);
+                instructionSequenceBuilder->appendOr();
+            }
             instructionSequenceBuilder->appendStore(type2BinaryDataType(binaryExpression->leftOperand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(binaryExpression->leftOperand->resultType));
@@ -707,9 +982,24 @@ void CodeGenerateVisitor::visit(CallExpression *callExpression) {
         visit(callExpression->argumentList[i]);
         instructionSequenceBuilder->appendCast(type2BinaryDataType(callExpression->argumentList[i]->resultType), type2BinaryDataType(functionType->parameterTypeList[i]));
     }
-    needLoadValue = true;
-    visit(callExpression->functionAddress);
-    instructionSequenceBuilder->appendCall();
+    // 直接调用函数时将函数地址作为调用指令的操作数，通过函数指针调用时函数地址在运行时才能确定，仍然从栈中取出
+    if (callExpression->functionAddress->getClass() == ExpressionClass::IDENTIFIER_EXPRESSION
+        && (*symbolTableIterator)[reinterpret_cast<IdentifierExpression *>(callExpression->functionAddress)->identifier]->getClass() == SymbolClass::FUNCTION_SYMBOL) {
+        std::string identifier = reinterpret_cast<IdentifierExpression *>(callExpression->functionAddress)->identifier;
+        auto functionSymbol = reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)[identifier]);
+        // 内建的数学函数直接在调用处插入对应的指令，不产生函数调用
+        if (!definedFunctionSet.contains(identifier) && BuiltInFunctionInserter::insertIntrinsic(identifier, instructionSequenceBuilder)) {
+            return;
+        }
+        if (functionSymbol->address == 0) {
+            functionPlaceholderIndexMap[identifier].push_back(instructionSequenceBuilder->getNextInstructionIndex());
+        }
+        instructionSequenceBuilder->appendCall(static_cast<std::uint64_t>(functionSymbol->address));
+    } else {
+        needLoadValue = true;
+        visit(callExpression->functionAddress);
+        instructionSequenceBuilder->appendCall();
+    }
     if (functionType->returnType->getClass() == TypeClass::SCALAR_TYPE && reinterpret_cast<ScalarType *>(functionType->returnType)->baseType == BaseType::VOID) {
         instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 用于保证所有的表达式计算后都会在栈中压入一个结果，
     }
@@ -789,22 +1079,18 @@ void CodeGenerateVisitor::visit(TernaryExpression *ternaryExpression) {
     BinaryDataType resultBinaryDataType = type2BinaryDataType(ternaryExpression->resultType);
     switch (ternaryExpression->ternaryOperator) {
         case TernaryOperator::CONDITION: {
-            needLoadValue = true;
-            visit(ternaryExpression->leftOperand);
-            int instructionIndex1 = instructionSequenceBuilder->getNextInstructionIndex();
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0));
-            instructionSequenceBuilder->appendJz();
+            std::vector<int> falseJumpIndexList;
+            generateConditionalJump(ternaryExpression->leftOperand, false, 0, falseJumpIndexList); // 占位
             needLoadValue = true;
             visit(ternaryExpression->middleOperand);
             instructionSequenceBuilder->appendCast(middleBinaryDataType, resultBinaryDataType);
             int instructionIndex2 = instructionSequenceBuilder->getNextInstructionIndex();
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0));
-            instructionSequenceBuilder->appendJmp();
-            instructionSequenceBuilder->modifyPush(instructionIndex1, instructionSequenceBuilder->getNextInstructionAddress());
+            instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(0));
+            patchJumpAddress(falseJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
             needLoadValue = true;
             visit(ternaryExpression->rightOperand);
             instructionSequenceBuilder->appendCast(rightBinaryDataType, resultBinaryDataType);
-            instructionSequenceBuilder->modifyPush(instructionIndex2, instructionSequenceBuilder->getNextInstructionAddress());
+            instructionSequenceBuilder->modifyAddress(instructionIndex2, instructionSequenceBuilder->getNextInstructionAddress());
             break;
         }
     }
@@ -822,28 +1108,10 @@ void CodeGenerateVisitor::visit(UnaryExpression *unaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             if (unaryExpression->operand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
+                instructionSequenceBuilder->appendAdd(operandBinaryDataType, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
             } else {
-                switch (operandBinaryDataType) {
-                    case BinaryDataType::I8:
-                    case BinaryDataType::I16:
-                    case BinaryDataType::I32:
-                    case BinaryDataType::I64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::int64_t>(1));
-                        break;
-                    case BinaryDataType::U8:
-                    case BinaryDataType::U16:
-                    case BinaryDataType::U32:
-                    case BinaryDataType::U64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-                        break;
-                    case BinaryDataType::F32:
-                    case BinaryDataType::F64:
-                        instructionSequenceBuilder->appendPush(static_cast<double>(1));
-                        break;
-                }
+                instructionSequenceBuilder->appendAdd(operandBinaryDataType, getUnitImmediate(operandBinaryDataType));
             }
-            instructionSequenceBuilder->appendAdd(operandBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(unaryExpression->operand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
@@ -858,28 +1126,10 @@ void CodeGenerateVisitor::visit(UnaryExpression *unaryExpression) {
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             if (unaryExpression->operand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
+                instructionSequenceBuilder->appendSub(operandBinaryDataType, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
             } else {
-                switch (operandBinaryDataType) {
-                    case BinaryDataType::I8:
-                    case BinaryDataType::I16:
-                    case BinaryDataType::I32:
-                    case BinaryDataType::I64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::int64_t>(1));
-                        break;
-                    case BinaryDataType::U8:
-                    case BinaryDataType::U16:
-                    case BinaryDataType::U32:
-                    case BinaryDataType::U64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-                        break;
-                    case BinaryDataType::F32:
-                    case BinaryDataType::F64:
-                        instructionSequenceBuilder->appendPush(static_cast<double>(1));
-                        break;
-                }
+                instructionSequenceBuilder->appendSub(operandBinaryDataType, getUnitImmediate(operandBinaryDataType));
             }
-            instructionSequenceBuilder->appendSub(operandBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(unaryExpression->operand->resultType));
             if (originNeedLoadValue) {
                 instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
@@ -890,34 +1140,15 @@ void CodeGenerateVisitor::visit(UnaryExpression *unaryExpression) {
             needLoadValue = false;
             visit(unaryExpression->operand);
             instructionSequenceBuilder->appendCopy();
-            instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             instructionSequenceBuilder->appendSwap();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             if (unaryExpression->operand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
+                instructionSequenceBuilder->appendAdd(operandBinaryDataType, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
             } else {
-                switch (operandBinaryDataType) {
-                    case BinaryDataType::I8:
-                    case BinaryDataType::I16:
-                    case BinaryDataType::I32:
-                    case BinaryDataType::I64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::int64_t>(1));
-                        break;
-                    case BinaryDataType::U8:
-                    case BinaryDataType::U16:
-                    case BinaryDataType::U32:
-                    case BinaryDataType::U64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-                        break;
-                    case BinaryDataType::F32:
-                    case BinaryDataType::F64:
-                        instructionSequenceBuilder->appendPush(static_cast<double>(1));
-                        break;
-                }
+                instructionSequenceBuilder->appendAdd(operandBinaryDataType, getUnitImmediate(operandBinaryDataType));
             }
-            instructionSequenceBuilder->appendAdd(operandBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(unaryExpression->operand->resultType));
             break;
         }
@@ -925,34 +1156,15 @@ void CodeGenerateVisitor::visit(UnaryExpression *unaryExpression) {
             needLoadValue = false;
             visit(unaryExpression->operand);
             instructionSequenceBuilder->appendCopy();
-            instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             instructionSequenceBuilder->appendSwap();
             instructionSequenceBuilder->appendCopy();
             instructionSequenceBuilder->appendLoad(type2BinaryDataType(unaryExpression->operand->resultType));
             if (unaryExpression->operand->resultType->getClass() == TypeClass::POINTER_TYPE) {
-                instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
+                instructionSequenceBuilder->appendSub(operandBinaryDataType, static_cast<std::uint64_t>(getTypeByteNum(reinterpret_cast<PointerType *>(unaryExpression->operand->resultType)->sourceType)));
             } else {
-                switch (operandBinaryDataType) {
-                    case BinaryDataType::I8:
-                    case BinaryDataType::I16:
-                    case BinaryDataType::I32:
-                    case BinaryDataType::I64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::int64_t>(1));
-                        break;
-                    case BinaryDataType::U8:
-                    case BinaryDataType::U16:
-                    case BinaryDataType::U32:
-                    case BinaryDataType::U64:
-                        instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(1));
-                        break;
-                    case BinaryDataType::F32:
-                    case BinaryDataType::F64:
-                        instructionSequenceBuilder->appendPush(static_cast<double>(1));
-                        break;
-                }
+                instructionSequenceBuilder->appendSub(operandBinaryDataType, getUnitImmediate(operandBinaryDataType));
             }
-            instructionSequenceBuilder->appendSub(operandBinaryDataType);
             instructionSequenceBuilder->appendStore(type2BinaryDataType(unaryExpression->operand->resultType));
             break;
         }
@@ -1100,13 +1312,12 @@ void CodeGenerateVisitor::visit(VariableDeclaration *variableDeclaration) {
 
 void CodeGenerateVisitor::visit(BreakStatement *breakStatement) {
     breakPushIndexListStack.top().push_back(instructionSequenceBuilder->getNextInstructionIndex());
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位地址，需要后续for、while、do-while语句确定地址后再进行修改
-    instructionSequenceBuilder->appendJmp();
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(0)); // 占位地址，需要后续for、while、do-while语句确定地址后再进行修改
 }
 
 void CodeGenerateVisitor::visit(CaseStatement *caseStatement) {
     // 对switch语句设置的占位地址进行修改
-    instructionSequenceBuilder->modifyPush(switchPushIndexListStack.top().front(), instructionSequenceBuilder->getNextInstructionAddress());
+    instructionSequenceBuilder->modifyAddress(switchPushIndexListStack.top().front(), instructionSequenceBuilder->getNextInstructionAddress());
     switchPushIndexListStack.top().pop_back();
     visit(caseStatement->statement);
 }
@@ -1121,8 +1332,7 @@ void CodeGenerateVisitor::visit(CompoundStatement *compoundStatement) {
 
 void CodeGenerateVisitor::visit(ContinueStatement *continueStatement) {
     continuePushIndexListStack.top().push_back(instructionSequenceBuilder->getNextInstructionIndex());
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(continueJumpAddressStack.top())); // 这个不一定是真实的跳转地址，当位于for和while循环时才是真实地址，当位于do-while循环时则是占位地址
-    instructionSequenceBuilder->appendJmp();
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(continueJumpAddressStack.top())); // 这个不一定是真实的跳转地址，当位于for和while循环时才是真实地址，当位于do-while循环时则是占位地址
 }
 
 void CodeGenerateVisitor::visit(DeclarationStatement *declarationStatement) {
@@ -1133,7 +1343,7 @@ void CodeGenerateVisitor::visit(DeclarationStatement *declarationStatement) {
 
 void CodeGenerateVisitor::visit(DefaultStatement *defaultStatement) {
     // 对switch语句设置的占位地址进行修改
-    instructionSequenceBuilder->modifyPush(switchPushIndexListStack.top().front(), instructionSequenceBuilder->getNextInstructionAddress());
+    instructionSequenceBuilder->modifyAddress(switchPushIndexListStack.top().front(), instructionSequenceBuilder->getNextInstructionAddress());
     switchPushIndexListStack.top().pop_back();
     visit(defaultStatement->statement);
 }
@@ -1145,10 +1355,8 @@ void CodeGenerateVisitor::visit(DoWhileStatement *doWhileStatement) {
     std::uint64_t jumpAddress1 = instructionSequenceBuilder->getNextInstructionAddress();
     visit(doWhileStatement->body);
     patchContinuePushAddress(instructionSequenceBuilder->getNextInstructionAddress());
-    needLoadValue = true;
-    visit(doWhileStatement->condition);
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(jumpAddress1));
-    instructionSequenceBuilder->appendJnz();
+    std::vector<int> trueJumpIndexList; // 跳转地址已经确定，不需要修改
+    generateConditionalJump(doWhileStatement->condition, true, jumpAddress1, trueJumpIndexList);
     patchBreakPushAddress(instructionSequenceBuilder->getNextInstructionAddress());
     continuePushIndexListStack.pop();
     breakPushIndexListStack.pop();
@@ -1179,16 +1387,9 @@ void CodeGenerateVisitor::visit(ForStatement *forStatement) {
     continueJumpAddressStack.push(jumpAddress1);
     breakPushIndexListStack.emplace();
     continuePushIndexListStack.emplace();
+    std::vector<int> falseJumpIndexList; // 条件为空时为无限循环，没有跳出循环的条件跳转
     if (forStatement->condition != nullptr) {
-        needLoadValue = true;
-        visit(forStatement->condition);
-    }
-    int instructionIndex1 = instructionSequenceBuilder->getNextInstructionIndex();
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0));
-    if (forStatement->condition != nullptr) {
-        instructionSequenceBuilder->appendJz();
-    } else {
-        instructionSequenceBuilder->appendJmp();
+        generateConditionalJump(forStatement->condition, false, 0, falseJumpIndexList); // 占位
     }
     visit(forStatement->body);
     if (forStatement->update != nullptr) {
@@ -1196,9 +1397,8 @@ void CodeGenerateVisitor::visit(ForStatement *forStatement) {
         visit(forStatement->update);
         instructionSequenceBuilder->appendPop(); // 表达式的值没有用
     }
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(jumpAddress1));
-    instructionSequenceBuilder->appendJmp();
-    instructionSequenceBuilder->modifyPush(instructionIndex1, instructionSequenceBuilder->getNextInstructionAddress());
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(jumpAddress1));
+    patchJumpAddress(falseJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
     patchBreakPushAddress(instructionSequenceBuilder->getNextInstructionAddress());
     continuePushIndexListStack.pop();
     breakPushIndexListStack.pop();
@@ -1211,27 +1411,22 @@ void CodeGenerateVisitor::visit(GotoStatement *gotoStatement) {
     if (statementSymbol->address == 0) {
         statementPlaceholderIndexMap[gotoStatement->identifier].push_back(instructionSequenceBuilder->getNextInstructionIndex());
     }
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(statementSymbol->address));
-    instructionSequenceBuilder->appendJmp();
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(statementSymbol->address));
 }
 
 void CodeGenerateVisitor::visit(IfStatement *ifStatement) {
-    needLoadValue = true;
-    visit(ifStatement->condition);
-    int instructionIndex1 = instructionSequenceBuilder->getNextInstructionIndex();
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位
-    instructionSequenceBuilder->appendJz();
+    std::vector<int> falseJumpIndexList;
+    generateConditionalJump(ifStatement->condition, false, 0, falseJumpIndexList); // 占位
     visit(ifStatement->trueBody);
     int instructionIndex2;
     if (ifStatement->falseBody != nullptr) {
         instructionIndex2 = instructionSequenceBuilder->getNextInstructionIndex();
-        instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位
-        instructionSequenceBuilder->appendJmp();
+        instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(0)); // 占位
     }
-    instructionSequenceBuilder->modifyPush(instructionIndex1, instructionSequenceBuilder->getNextInstructionAddress());
+    patchJumpAddress(falseJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
     if (ifStatement->falseBody != nullptr) {
         visit(ifStatement->falseBody);
-        instructionSequenceBuilder->modifyPush(instructionIndex2, instructionSequenceBuilder->getNextInstructionAddress());
+        instructionSequenceBuilder->modifyAddress(instructionIndex2, instructionSequenceBuilder->getNextInstructionAddress());
     }
 }
 
@@ -1272,14 +1467,12 @@ void CodeGenerateVisitor::visit(SwitchStatement *switchStatement) {
             instructionSequenceBuilder->appendCast(BinaryDataType::I64, type2BinaryDataType(switchStatement->expression->resultType));
             instructionSequenceBuilder->appendEq(type2BinaryDataType(switchStatement->expression->resultType));
             switchPushIndexList[i] = instructionSequenceBuilder->getNextInstructionIndex();
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位跳转地址，需要后续case语句确定地址后再进行修改
-            instructionSequenceBuilder->appendJnz();
+            instructionSequenceBuilder->appendJnz(static_cast<std::uint64_t>(0)); // 占位跳转地址，需要后续case语句确定地址后再进行修改
         }
     }
     // 再处理default语句
     switchPushIndexList[defaultStatementIndex] = instructionSequenceBuilder->getNextInstructionIndex();
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位跳转地址，需要后续case语句的visit函数确定地址后再进行修改
-    instructionSequenceBuilder->appendJmp();
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(0)); // 占位跳转地址，需要后续case语句的visit函数确定地址后再进行修改
     switchPushIndexListStack.push(switchPushIndexList);
     breakPushIndexListStack.emplace();
     visit(switchStatement->body);
@@ -1294,15 +1487,11 @@ void CodeGenerateVisitor::visit(WhileStatement *whileStatement) {
     continueJumpAddressStack.push(jumpAddress1);
     breakPushIndexListStack.emplace();
     continuePushIndexListStack.emplace();
-    needLoadValue = true;
-    visit(whileStatement->condition);
-    int instructionIndex1 = instructionSequenceBuilder->getNextInstructionIndex();
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0));
-    instructionSequenceBuilder->appendJz();
+    std::vector<int> falseJumpIndexList;
+    generateConditionalJump(whileStatement->condition, false, 0, falseJumpIndexList); // 占位
     visit(whileStatement->body);
-    instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(jumpAddress1));
-    instructionSequenceBuilder->appendJmp();
-    instructionSequenceBuilder->modifyPush(instructionIndex1, instructionSequenceBuilder->getNextInstructionAddress());
+    instructionSequenceBuilder->appendJmp(static_cast<std::uint64_t>(jumpAddress1));
+    patchJumpAddress(falseJumpIndexList, instructionSequenceBuilder->getNextInstructionAddress());
     patchBreakPushAddress(instructionSequenceBuilder->getNextInstructionAddress());
     continuePushIndexListStack.pop();
     breakPushIndexListStack.pop();
@@ -1313,6 +1502,7 @@ void CodeGenerateVisitor::visit(TranslationUnit *translationUnit) {
     std::deque<Declaration *> declarationDeque;
     for (auto declaration : translationUnit->declarationList) {
         if (declaration->getClass() == DeclarationClass::FUNCTION_DEFINITION) {
+            definedFunctionSet.insert(reinterpret_cast<FunctionDefinition *>(declaration)->identifier);
             declarationDeque.push_back(declaration);
         } else {
             declarationDeque.push_front(declaration);
@@ -1324,8 +1514,7 @@ void CodeGenerateVisitor::visit(TranslationUnit *translationUnit) {
         if (!beginFunctionDefinition && declaration->getClass() == DeclarationClass::FUNCTION_DEFINITION) {
             beginFunctionDefinition = true;
             functionPlaceholderIndexMap["main"].push_back(instructionSequenceBuilder->getNextInstructionIndex());
-            instructionSequenceBuilder->appendPush(static_cast<std::uint64_t>(0)); // 占位地址
-            instructionSequenceBuilder->appendCall();
+            instructionSequenceBuilder->appendCall(static_cast<std::uint64_t>(0)); // 占位地址
             instructionSequenceBuilder->appendHlt();
             BuiltInFunctionInserter::insertCode(symbolTableIterator, instructionSequenceBuilder);
         }
@@ -3,6 +3,7 @@
 #include <memory>
 #include <stack>
 #include <queue>
+#include <set>
 #include "Visitor.h"
 #include "../../constant/StringConstantPool.h"
 #include "../../symbol/SymbolTable.h"
@@ -22,6 +23,7 @@ private:
     std::stack<std::vector<int>> breakPushIndexListStack; // 用于记录多个break语句中压入占位地址的push指令的索引，需要后续修改
     std::stack<std::vector<int>> continuePushIndexListStack; // 用于记录多个continue语句中压入占位地址的push指令的索引，需要后续修改（do-while循环使用）
     std::stack<std::uint64_t> continueJumpAddressStack; // 用于记录在continue的语句可以跳转的地址（while和for循环使用）
+    std::set<std::string> definedFunctionSet; // 用于记录源代码中定义的函数，与内建的数学函数同名时调用源代码中的定义，不再内联
     bool needLoadValue = false; // 用于表示表达式的visit函数的调用者是否需要取值（前提是表达式返回的是左值）
 
 private:
@@ -29,6 +31,8 @@ private:
     void patchStatementPlaceholderAddress(const std::string& identifier, std::uint64_t realAddress);
     void patchBreakPushAddress(std::uint64_t realAddress);
     void patchContinuePushAddress(std::uint64_t realAddress);
+    void patchJumpAddress(const std::vector<int> &jumpIndexList, std::uint64_t realAddress);
+    void generateConditionalJump(Expression *condition, bool jumpCondition, std::uint64_t address, std::vector<int> &jumpIndexList);
 
 public:
     CodeGenerateVisitor(SymbolTable *symbolTable, StringConstantPool *stringConstantPool);
@@ -185,11 +185,11 @@ bool canImplicitCastOneWay(Type *sourceType, Type *targetType) {
     }
     switch (sourceType->getClass()) {
         case TypeClass::ARRAY_TYPE:
-            return isPointerType(targetType) && isSameType(reinterpret_cast<ArrayType *>(sourceType)->elemType, reinterpret_cast<PointerType *>(targetType)->sourceType);
+            return isVoidPointerType(targetType) || (isPointerType(targetType) && isSameType(reinterpret_cast<ArrayType *>(sourceType)->elemType, reinterpret_cast<PointerType *>(targetType)->sourceType));
         case TypeClass::FUNCTION_TYPE:
             return isPointerType(targetType) && isSameType(sourceType, reinterpret_cast<PointerType *>(targetType)->sourceType);
         case TypeClass::POINTER_TYPE:
-            return isVoidPointerType(targetType);
+            return isVoidPointerType(targetType) || (isVoidPointerType(sourceType) && isPointerType(targetType));
         case TypeClass::SCALAR_TYPE:
             switch (reinterpret_cast<ScalarType *>(sourceType)->baseType) {
                 case BaseType::VOID:
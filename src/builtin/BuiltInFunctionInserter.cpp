@@ -38,6 +38,74 @@ void BuiltInFunctionInserter::insertSymbol(std::unique_ptr<SymbolTableBuilder> &
     symbolTableBuilder->createScope("print_s");
     symbolTableBuilder->insertSymbol(new PointerSymbol("address", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::CHAR, {}), {})));
     symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("mem_copy", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})})));
+    symbolTableBuilder->createScope("mem_copy");
+    symbolTableBuilder->insertSymbol(new PointerSymbol("destination", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new PointerSymbol("source", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("size", new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("mem_set", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new ScalarType(-1, -1, BaseType::INT, {}), new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})})));
+    symbolTableBuilder->createScope("mem_set");
+    symbolTableBuilder->insertSymbol(new PointerSymbol("destination", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::INT, {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("size", new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("mem_cmp", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::INT, {}), {new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})})));
+    symbolTableBuilder->createScope("mem_cmp");
+    symbolTableBuilder->insertSymbol(new PointerSymbol("left", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new PointerSymbol("right", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("size", new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("sqrt", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("sqrt");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("fabs", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("fabs");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("floor", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("floor");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("ceil", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("ceil");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("pow", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {}), new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("pow");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("base", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("exponent", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("exp", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("exp");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("log", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("log");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("sin", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("sin");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("cos", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::DOUBLE, {}), {new ScalarType(-1, -1, BaseType::DOUBLE, {})})));
+    symbolTableBuilder->createScope("cos");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("value", new ScalarType(-1, -1, BaseType::DOUBLE, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("malloc", new FunctionType(-1, -1, new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), {new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})})));
+    symbolTableBuilder->createScope("malloc");
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("size", new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("free", new FunctionType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})})));
+    symbolTableBuilder->createScope("free");
+    symbolTableBuilder->insertSymbol(new PointerSymbol("address", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->exitScope();
+    symbolTableBuilder->insertSymbol(new FunctionSymbol("realloc", new FunctionType(-1, -1, new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), {new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {}), new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})})));
+    symbolTableBuilder->createScope("realloc");
+    symbolTableBuilder->insertSymbol(new PointerSymbol("address", new PointerType(-1, -1, new ScalarType(-1, -1, BaseType::VOID, {}), {})));
+    symbolTableBuilder->insertSymbol(new ScalarSymbol("size", new ScalarType(-1, -1, BaseType::UNSIGNED_LONG_LONG_INT, {})));
+    symbolTableBuilder->exitScope();
 }
 
 void BuiltInFunctionInserter::insertCode(std::unique_ptr<SymbolTableIterator> &symbolTableIterator, std::unique_ptr<InstructionSequenceBuilder> &instructionSequenceBuilder) {
@@ -81,6 +149,106 @@ void BuiltInFunctionInserter::insertCode(std::unique_ptr<SymbolTableIterator> &s
     instructionSequenceBuilder->appendOut();
     instructionSequenceBuilder->appendRet();
     symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["mem_copy"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendMemcpy();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["mem_set"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendMemset();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["mem_cmp"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendMemcmp();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["sqrt"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendSqrt();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["fabs"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendFabs();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["floor"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendFloor();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["ceil"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendCeil();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["pow"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendPow();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["exp"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendExp();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["log"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendLog();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["sin"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendSin();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["cos"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendCos();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["malloc"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendMalloc();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["free"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendFree();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+    reinterpret_cast<FunctionSymbol *>((*symbolTableIterator)["realloc"])->address = instructionSequenceBuilder->getNextInstructionAddress();
+    symbolTableIterator->switchScope();
+    instructionSequenceBuilder->appendRealloc();
+    instructionSequenceBuilder->appendRet();
+    symbolTableIterator->switchScope();
+}
+
+bool BuiltInFunctionInserter::insertIntrinsic(const std::string &identifier, std::unique_ptr<InstructionSequenceBuilder> &instructionSequenceBuilder) {
+    if (identifier == "sqrt") {
+        instructionSequenceBuilder->appendSqrt();
+    } else if (identifier == "fabs") {
+        instructionSequenceBuilder->appendFabs();
+    } else if (identifier == "floor") {
+        instructionSequenceBuilder->appendFloor();
+    } else if (identifier == "ceil") {
+        instructionSequenceBuilder->appendCeil();
+    } else if (identifier == "pow") {
+        instructionSequenceBuilder->appendPow();
+    } else if (identifier == "exp") {
+        instructionSequenceBuilder->appendExp();
+    } else if (identifier == "log") {
+        instructionSequenceBuilder->appendLog();
+    } else if (identifier == "sin") {
+        instructionSequenceBuilder->appendSin();
+    } else if (identifier == "cos") {
+        instructionSequenceBuilder->appendCos();
+    } else {
+        return false;
+    }
+    return true;
 }
 
 
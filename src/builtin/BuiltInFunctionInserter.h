@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 #include "../symbol/SymbolTableBuilder.h"
 #include "../symbol/SymbolTable.h"
 #include "../instruction/InstructionSequenceBuilder.h"
@@ -13,4 +14,10 @@ class BuiltInFunctionInserter{
 public:
     static void insertSymbol(std::unique_ptr<SymbolTableBuilder> &symbolTableBuilder);
     static void insertCode(std::unique_ptr<SymbolTableIterator> &symbolTableIterator, std::unique_ptr<InstructionSequenceBuilder> &instructionSequenceBuilder);
+
+    /**
+     * 直接调用数学函数时在调用处插入对应的指令代替函数调用，参数已经在栈中，指令执行后结果留在栈中。
+     * identifier不是可以内联的内建函数时返回false，不插入任何指令。
+     */
+    static bool insertIntrinsic(const std::string &identifier, std::unique_ptr<InstructionSequenceBuilder> &instructionSequenceBuilder);
 };
@@ -166,6 +166,254 @@ std::string opcode2String(Opcode opcode) {
             return "fbp";
         case Opcode::HLT:
             return "hlt";
+        case Opcode::JMP_IMM:
+            return "jmp_imm";
+        case Opcode::JZ_64_IMM:
+            return "jz_64_imm";
+        case Opcode::JNZ_64_IMM:
+            return "jnz_64_imm";
+        case Opcode::CALL_IMM:
+            return "call_imm";
+        case Opcode::MEMCPY:
+            return "memcpy";
+        case Opcode::MEMSET:
+            return "memset";
+        case Opcode::MEMCMP:
+            return "memcmp";
+        case Opcode::SQRT_F64:
+            return "sqrt_f64";
+        case Opcode::FABS_F64:
+            return "fabs_f64";
+        case Opcode::FLOOR_F64:
+            return "floor_f64";
+        case Opcode::CEIL_F64:
+            return "ceil_f64";
+        case Opcode::POW_F64:
+            return "pow_f64";
+        case Opcode::EXP_F64:
+            return "exp_f64";
+        case Opcode::LOG_F64:
+            return "log_f64";
+        case Opcode::SIN_F64:
+            return "sin_f64";
+        case Opcode::COS_F64:
+            return "cos_f64";
+        case Opcode::MALLOC:
+            return "malloc";
+        case Opcode::FREE:
+            return "free";
+        case Opcode::REALLOC:
+            return "realloc";
+        case Opcode::ADD_I64_IMM:
+            return "add_i64_imm";
+        case Opcode::ADD_U64_IMM:
+            return "add_u64_imm";
+        case Opcode::ADD_F64_IMM:
+            return "add_f64_imm";
+        case Opcode::SUB_I64_IMM:
+            return "sub_i64_imm";
+        case Opcode::SUB_U64_IMM:
+            return "sub_u64_imm";
+        case Opcode::SUB_F64_IMM:
+            return "sub_f64_imm";
+        case Opcode::MUL_I64_IMM:
+            return "mul_i64_imm";
+        case Opcode::MUL_U64_IMM:
+            return "mul_u64_imm";
+        case Opcode::MUL_F64_IMM:
+            return "mul_f64_imm";
+        case Opcode::DIV_I64_IMM:
+            return "div_i64_imm";
+        case Opcode::DIV_U64_IMM:
+            return "div_u64_imm";
+        case Opcode::DIV_F64_IMM:
+            return "div_f64_imm";
+        case Opcode::MOD_I64_IMM:
+            return "mod_i64_imm";
+        case Opcode::MOD_U64_IMM:
+            return "mod_u64_imm";
+        case Opcode::SL_I64_IMM:
+            return "sl_i64_imm";
+        case Opcode::SL_U64_IMM:
+            return "sl_u64_imm";
+        case Opcode::SR_I64_IMM:
+            return "sr_i64_imm";
+        case Opcode::SR_U64_IMM:
+            return "sr_u64_imm";
+        case Opcode::AND_64_IMM:
+            return "and_64_imm";
+        case Opcode::OR_64_IMM:
+            return "or_64_imm";
+        case Opcode::XOR_64_IMM:
+            return "xor_64_imm";
+        case Opcode::GT_I64_IMM:
+            return "gt_i64_imm";
+        case Opcode::GT_U64_IMM:
+            return "gt_u64_imm";
+        case Opcode::GT_F64_IMM:
+            return "gt_f64_imm";
+        case Opcode::LT_I64_IMM:
+            return "lt_i64_imm";
+        case Opcode::LT_U64_IMM:
+            return "lt_u64_imm";
+        case Opcode::LT_F64_IMM:
+            return "lt_f64_imm";
+        case Opcode::EQ_I64_IMM:
+            return "eq_i64_imm";
+        case Opcode::EQ_U64_IMM:
+            return "eq_u64_imm";
+        case Opcode::EQ_F64_IMM:
+            return "eq_f64_imm";
+        case Opcode::BLT_I64:
+            return "blt_i64";
+        case Opcode::BLT_U64:
+            return "blt_u64";
+        case Opcode::BLT_F64:
+            return "blt_f64";
+        case Opcode::BGT_I64:
+            return "bgt_i64";
+        case Opcode::BGT_U64:
+            return "bgt_u64";
+        case Opcode::BGT_F64:
+            return "bgt_f64";
+        case Opcode::BEQ_I64:
+            return "beq_i64";
+        case Opcode::BEQ_U64:
+            return "beq_u64";
+        case Opcode::BEQ_F64:
+            return "beq_f64";
+        case Opcode::BGE_I64:
+            return "bge_i64";
+        case Opcode::BGE_U64:
+            return "bge_u64";
+        case Opcode::BGE_F64:
+            return "bge_f64";
+        case Opcode::BLE_I64:
+            return "ble_i64";
+        case Opcode::BLE_U64:
+            return "ble_u64";
+        case Opcode::BLE_F64:
+            return "ble_f64";
+        case Opcode::BNE_I64:
+            return "bne_i64";
+        case Opcode::BNE_U64:
+            return "bne_u64";
+        case Opcode::BNE_F64:
+            return "bne_f64";
+        case Opcode::ADD_I32:
+            return "add_i32";
+        case Opcode::ADD_U32:
+            return "add_u32";
+        case Opcode::ADD_F32:
+            return "add_f32";
+        case Opcode::SUB_I32:
+            return "sub_i32";
+        case Opcode::SUB_U32:
+            return "sub_u32";
+        case Opcode::SUB_F32:
+            return "sub_f32";
+        case Opcode::MUL_I32:
+            return "mul_i32";
+        case Opcode::MUL_U32:
+            return "mul_u32";
+        case Opcode::MUL_F32:
+            return "mul_f32";
+        case Opcode::DIV_I32:
+            return "div_i32";
+        case Opcode::DIV_U32:
+            return "div_u32";
+        case Opcode::DIV_F32:
+            return "div_f32";
+        case Opcode::MOD_I32:
+            return "mod_i32";
+        case Opcode::MOD_U32:
+            return "mod_u32";
+        case Opcode::NEG_I32:
+            return "neg_i32";
+        case Opcode::NEG_F32:
+            return "neg_f32";
+        case Opcode::SL_I32:
+            return "sl_i32";
+        case Opcode::SL_U32:
+            return "sl_u32";
+        case Opcode::SR_I32:
+            return "sr_i32";
+        case Opcode::SR_U32:
+            return "sr_u32";
+        case Opcode::ADD_I32_IMM:
+            return "add_i32_imm";
+        case Opcode::ADD_U32_IMM:
+            return "add_u32_imm";
+        case Opcode::ADD_F32_IMM:
+            return "add_f32_imm";
+        case Opcode::SUB_I32_IMM:
+            return "sub_i32_imm";
+        case Opcode::SUB_U32_IMM:
+            return "sub_u32_imm";
+        case Opcode::SUB_F32_IMM:
+            return "sub_f32_imm";
+        case Opcode::MUL_I32_IMM:
+            return "mul_i32_imm";
+        case Opcode::MUL_U32_IMM:
+            return "mul_u32_imm";
+        case Opcode::MUL_F32_IMM:
+            return "mul_f32_imm";
+        case Opcode::DIV_I32_IMM:
+            return "div_i32_imm";
+        case Opcode::DIV_U32_IMM:
+            return "div_u32_imm";
+        case Opcode::DIV_F32_IMM:
+            return "div_f32_imm";
+        case Opcode::MOD_I32_IMM:
+            return "mod_i32_imm";
+        case Opcode::MOD_U32_IMM:
+            return "mod_u32_imm";
+        case Opcode::SL_I32_IMM:
+            return "sl_i32_imm";
+        case Opcode::SL_U32_IMM:
+            return "sl_u32_imm";
+        case Opcode::SR_I32_IMM:
+            return "sr_i32_imm";
+        case Opcode::SR_U32_IMM:
+            return "sr_u32_imm";
+        case Opcode::LOCAL_ADDRESS:
+            return "local_address";
+        case Opcode::LOAD_LOCAL_I32:
+            return "load_local_i32";
+        case Opcode::LOAD_LOCAL_I64:
+            return "load_local_i64";
+        case Opcode::LOAD_LOCAL_U64:
+            return "load_local_u64";
+        case Opcode::LOAD_LOCAL_F64:
+            return "load_local_f64";
+        case Opcode::STORE_LOCAL_I32:
+            return "store_local_i32";
+        case Opcode::STORE_LOCAL_I64:
+            return "store_local_i64";
+        case Opcode::STORE_POP_I32:
+            return "store_pop_i32";
+        case Opcode::STORE_POP_I64:
+            return "store_pop_i64";
+        case Opcode::CMP_BRANCH_GT_I64:
+            return "cmp_branch_gt_i64";
+        case Opcode::CMP_BRANCH_LT_I64:
+            return "cmp_branch_lt_i64";
+        case Opcode::CMP_BRANCH_EQ_I64:
+            return "cmp_branch_eq_i64";
+        case Opcode::POP_PUSH:
+            return "pop_push";
+        case Opcode::PUSH_BLT_I64:
+            return "push_blt_i64";
+        case Opcode::PUSH_BGT_I64:
+            return "push_bgt_i64";
+        case Opcode::PUSH_BEQ_I64:
+            return "push_beq_i64";
+        case Opcode::PUSH_BGE_I64:
+            return "push_bge_i64";
+        case Opcode::PUSH_BLE_I64:
+            return "push_ble_i64";
+        case Opcode::PUSH_BNE_I64:
+            return "push_bne_i64";
     }
     assert(false);
 }
@@ -174,6 +422,10 @@ const std::map<std::uint64_t, std::uint64_t> &Bytecode::getMemoryUseMap() const
     return functionMemoryUseMap;
 }
 
+const std::vector<FunctionTableEntry> &Bytecode::getFunctionTable() const {
+    return functionTable;
+}
+
 const std::vector<std::uint8_t> &Bytecode::getCodeArea() const {
     return codeArea;
 }
@@ -182,18 +434,333 @@ const std::vector<std::uint8_t> &Bytecode::getDataArea() const {
     return dataArea;
 }
 
+std::uint32_t Bytecode::getFileVersion() const {
+    return fileVersion;
+}
+
+std::uint64_t Bytecode::getRepairedSequenceCount() const {
+    return repairedSequenceCount;
+}
+
+static constexpr std::uint8_t OPCODE_ESCAPE = 0xFF; // 其后为2字节操作码和8字节操作数的完整形式，用于无法按变长形式编码的指令
+static constexpr std::uint8_t OPERAND_SHORT_LIMIT = 0xF0; // 小于该值的操作数格式字节本身即为操作数，其后没有其他字节
+static constexpr std::uint8_t OPERAND_WIDTH_8 = 0xF1; // 其后为1字节有符号数
+static constexpr std::uint8_t OPERAND_WIDTH_16 = 0xF2; // 其后为2字节有符号数
+static constexpr std::uint8_t OPERAND_WIDTH_32 = 0xF4; // 其后为4字节有符号数
+static constexpr std::uint8_t OPERAND_WIDTH_64 = 0xF8; // 其后为8字节的原始操作数
+static constexpr std::int64_t NEAR_JUMP_BIAS = 0x78; // 短格式的跳转偏移加上该值后存储，可以表示-120到119条指令的偏移
+
+static_assert(static_cast<std::uint16_t>(Opcode::PUSH_BNE_I64) < OPCODE_ESCAPE, "opcode must fit in one byte");
+
+/**
+ * 指令在字节码文件中的操作数类型。
+ */
+enum class OperandKind {
+    NONE, // 没有操作数
+    IMMEDIATE, // 立即数，短格式为0到239的无符号数，1、2、4字节格式为符号扩展的值
+    ADDRESS, // 跳转或调用的目标地址，短格式以及1、2、4字节格式为相对于本条指令的以指令为单位的偏移，8字节格式为绝对地址
+};
+
+static OperandKind operandKind(Opcode opcode) {
+    switch (opcode) {
+        case Opcode::PUSH_64:
+        case Opcode::ADD_I64_IMM:
+        case Opcode::ADD_U64_IMM:
+        case Opcode::ADD_F64_IMM:
+        case Opcode::SUB_I64_IMM:
+        case Opcode::SUB_U64_IMM:
+        case Opcode::SUB_F64_IMM:
+        case Opcode::MUL_I64_IMM:
+        case Opcode::MUL_U64_IMM:
+        case Opcode::MUL_F64_IMM:
+        case Opcode::DIV_I64_IMM:
+        case Opcode::DIV_U64_IMM:
+        case Opcode::DIV_F64_IMM:
+        case Opcode::MOD_I64_IMM:
+        case Opcode::MOD_U64_IMM:
+        case Opcode::SL_I64_IMM:
+        case Opcode::SL_U64_IMM:
+        case Opcode::SR_I64_IMM:
+        case Opcode::SR_U64_IMM:
+        case Opcode::AND_64_IMM:
+        case Opcode::OR_64_IMM:
+        case Opcode::XOR_64_IMM:
+        case Opcode::GT_I64_IMM:
+        case Opcode::GT_U64_IMM:
+        case Opcode::GT_F64_IMM:
+        case Opcode::LT_I64_IMM:
+        case Opcode::LT_U64_IMM:
+        case Opcode::LT_F64_IMM:
+        case Opcode::EQ_I64_IMM:
+        case Opcode::EQ_U64_IMM:
+        case Opcode::EQ_F64_IMM:
+        case Opcode::ADD_I32_IMM:
+        case Opcode::ADD_U32_IMM:
+        case Opcode::ADD_F32_IMM:
+        case Opcode::SUB_I32_IMM:
+        case Opcode::SUB_U32_IMM:
+        case Opcode::SUB_F32_IMM:
+        case Opcode::MUL_I32_IMM:
+        case Opcode::MUL_U32_IMM:
+        case Opcode::MUL_F32_IMM:
+        case Opcode::DIV_I32_IMM:
+        case Opcode::DIV_U32_IMM:
+        case Opcode::DIV_F32_IMM:
+        case Opcode::MOD_I32_IMM:
+        case Opcode::MOD_U32_IMM:
+        case Opcode::SL_I32_IMM:
+        case Opcode::SL_U32_IMM:
+        case Opcode::SR_I32_IMM:
+        case Opcode::SR_U32_IMM:
+            return OperandKind::IMMEDIATE;
+        case Opcode::JMP_IMM:
+        case Opcode::JZ_64_IMM:
+        case Opcode::JNZ_64_IMM:
+        case Opcode::CALL_IMM:
+        case Opcode::BLT_I64:
+        case Opcode::BLT_U64:
+        case Opcode::BLT_F64:
+        case Opcode::BGT_I64:
+        case Opcode::BGT_U64:
+        case Opcode::BGT_F64:
+        case Opcode::BEQ_I64:
+        case Opcode::BEQ_U64:
+        case Opcode::BEQ_F64:
+        case Opcode::BGE_I64:
+        case Opcode::BGE_U64:
+        case Opcode::BGE_F64:
+        case Opcode::BLE_I64:
+        case Opcode::BLE_U64:
+        case Opcode::BLE_F64:
+        case Opcode::BNE_I64:
+        case Opcode::BNE_U64:
+        case Opcode::BNE_F64:
+            return OperandKind::ADDRESS;
+        default:
+            return OperandKind::NONE;
+    }
+}
+
+/**
+ * 写入8字节格式的原始操作数。
+ */
+static void writeRawOperand(std::vector<std::uint8_t> &byteList, std::uint64_t rawOperand) {
+    byteList.push_back(OPERAND_WIDTH_64);
+    byteList.insert(byteList.end(), reinterpret_cast<const std::uint8_t *>(&rawOperand), reinterpret_cast<const std::uint8_t *>(&rawOperand) + sizeof(rawOperand));
+}
+
+/**
+ * 按能容纳value的最小宽度写入有符号数，4字节也无法容纳时写入rawOperand。
+ */
+static void writeOperand(std::vector<std::uint8_t> &byteList, std::int64_t value, std::uint64_t rawOperand) {
+    if (value >= INT8_MIN && value <= INT8_MAX) {
+        auto narrowValue = static_cast<std::int8_t>(value);
+        byteList.push_back(OPERAND_WIDTH_8);
+        byteList.insert(byteList.end(), reinterpret_cast<const std::uint8_t *>(&narrowValue), reinterpret_cast<const std::uint8_t *>(&narrowValue) + sizeof(narrowValue));
+    } else if (value >= INT16_MIN && value <= INT16_MAX) {
+        auto narrowValue = static_cast<std::int16_t>(value);
+        byteList.push_back(OPERAND_WIDTH_16);
+        byteList.insert(byteList.end(), reinterpret_cast<const std::uint8_t *>(&narrowValue), reinterpret_cast<const std::uint8_t *>(&narrowValue) + sizeof(narrowValue));
+    } else if (value >= INT32_MIN && value <= INT32_MAX) {
+        auto narrowValue = static_cast<std::int32_t>(value);
+        byteList.push_back(OPERAND_WIDTH_32);
+        byteList.insert(byteList.end(), reinterpret_cast<const std::uint8_t *>(&narrowValue), reinterpret_cast<const std::uint8_t *>(&narrowValue) + sizeof(narrowValue));
+    } else {
+        writeRawOperand(byteList, rawOperand);
+    }
+}
+
+/**
+ * 从byteList的position处读取size字节的有符号数并符号扩展，越界时返回false。
+ */
+static bool readSigned(const std::vector<std::uint8_t> &byteList, std::uint64_t &position, std::uint64_t size, std::int64_t &value) {
+    if (byteList.size() - position < size) {
+        return false;
+    }
+    switch (size) {
+        case 1: {
+            std::int8_t narrowValue;
+            std::memcpy(&narrowValue, &byteList[position], size);
+            value = narrowValue;
+            break;
+        }
+        case 2: {
+            std::int16_t narrowValue;
+            std::memcpy(&narrowValue, &byteList[position], size);
+            value = narrowValue;
+            break;
+        }
+        case 4: {
+            std::int32_t narrowValue;
+            std::memcpy(&narrowValue, &byteList[position], size);
+            value = narrowValue;
+            break;
+        }
+        default:
+            std::memcpy(&value, &byteList[position], size);
+            break;
+    }
+    position += size;
+    return true;
+}
+
+/*
+ * 旧版编译器为后置自增和自减生成的序列是copy、copy、load、swap、copy、load，第一个copy是多余的，
+ * 每执行一次都会在操作数栈上遗留一个地址，循环中的后置自增执行上百万次就会使定长的操作数栈溢出。
+ * 将多余的copy替换为加0的立即数加法，指令条数和地址都不变，跳转目标和函数表无需调整。
+ * 新版编译器生成的序列只有一个copy，不会被误判。
+ */
+void Bytecode::repairLegacyPostfixSequences() {
+    auto opcodeAt = [this](std::uint64_t index) {
+        Opcode opcode;
+        std::memcpy(&opcode, &codeArea[index * 10], sizeof(opcode));
+        return opcode;
+    };
+    auto isLoad = [](Opcode opcode) {
+        return opcode >= Opcode::LOAD_I8 && opcode <= Opcode::LOAD_F64;
+    };
+    std::uint64_t instructionCount = codeArea.size() / 10;
+    for (std::uint64_t i = 0; i + 6 <= instructionCount; i++) {
+        if (opcodeAt(i) == Opcode::COPY_64 && opcodeAt(i + 1) == Opcode::COPY_64 && isLoad(opcodeAt(i + 2)) && opcodeAt(i + 3) == Opcode::SWAP_64
+            && opcodeAt(i + 4) == Opcode::COPY_64 && opcodeAt(i + 5) == opcodeAt(i + 2)) {
+            Opcode opcode = Opcode::ADD_U64_IMM;
+            std::uint64_t operand = 0;
+            std::memcpy(&codeArea[i * 10], &opcode, sizeof(opcode));
+            std::memcpy(&codeArea[i * 10 + 2], &operand, sizeof(operand));
+            repairedSequenceCount++;
+            i += 5;
+        }
+    }
+}
+
+void Bytecode::createFunctionTable() {
+    functionTable.clear();
+    for (const auto &[address, frameSize] : functionMemoryUseMap) {
+        functionTable.push_back({address, frameSize});
+    }
+}
+
+std::vector<std::uint8_t> Bytecode::encodeCodeArea() const {
+    std::vector<std::uint8_t> byteList;
+    byteList.reserve(codeArea.size() / 4);
+    for (std::uint64_t i = 0; i < codeArea.size() / 10; i++) {
+        std::uint16_t opcode;
+        std::uint64_t operand;
+        std::memcpy(&opcode, &codeArea[i * 10], sizeof(opcode));
+        std::memcpy(&operand, &codeArea[i * 10 + 2], sizeof(operand));
+        auto kind = operandKind(static_cast<Opcode>(opcode));
+        if (opcode >= OPCODE_ESCAPE || (kind == OperandKind::NONE && operand != 0)) {
+            byteList.push_back(OPCODE_ESCAPE);
+            byteList.insert(byteList.end(), &codeArea[i * 10], &codeArea[i * 10] + 10);
+            continue;
+        }
+        byteList.push_back(static_cast<std::uint8_t>(opcode));
+        if (kind == OperandKind::IMMEDIATE) {
+            if (operand < OPERAND_SHORT_LIMIT) {
+                byteList.push_back(static_cast<std::uint8_t>(operand));
+            } else {
+                writeOperand(byteList, static_cast<std::int64_t>(operand), operand);
+            }
+        } else if (kind == OperandKind::ADDRESS) {
+            if (operand % 10 != 0) {
+                writeRawOperand(byteList, operand);
+                continue;
+            }
+            // 跳转目标大多在附近，按相对于本条指令的偏移编码
+            auto offset = static_cast<std::int64_t>(operand / 10) - static_cast<std::int64_t>(i);
+            if (offset >= -NEAR_JUMP_BIAS && offset < OPERAND_SHORT_LIMIT - NEAR_JUMP_BIAS) {
+                byteList.push_back(static_cast<std::uint8_t>(offset + NEAR_JUMP_BIAS));
+            } else {
+                writeOperand(byteList, offset, operand);
+            }
+        }
+    }
+    return byteList;
+}
+
+bool Bytecode::decodeCodeArea(const std::vector<std::uint8_t> &encodedCodeArea, std::uint64_t instructionCount) {
+    // 每条指令至少占1字节
+    if (instructionCount > encodedCodeArea.size()) {
+        return false;
+    }
+    codeArea.assign(instructionCount * 10, 0);
+    std::uint64_t position = 0;
+    for (std::uint64_t i = 0; i < instructionCount; i++) {
+        if (position == encodedCodeArea.size()) {
+            return false;
+        }
+        std::uint16_t opcode = encodedCodeArea[position++];
+        std::uint64_t operand = 0;
+        if (opcode == OPCODE_ESCAPE) {
+            if (encodedCodeArea.size() - position < 10) {
+                return false;
+            }
+            std::memcpy(&codeArea[i * 10], &encodedCodeArea[position], 10);
+            position += 10;
+            continue;
+        }
+        auto kind = operandKind(static_cast<Opcode>(opcode));
+        if (kind != OperandKind::NONE) {
+            if (position == encodedCodeArea.size()) {
+                return false;
+            }
+            std::uint8_t format = encodedCodeArea[position++];
+            std::int64_t value;
+            bool success = true;
+            switch (format) {
+                case OPERAND_WIDTH_8:
+                    success = readSigned(encodedCodeArea, position, 1, value);
+                    break;
+                case OPERAND_WIDTH_16:
+                    success = readSigned(encodedCodeArea, position, 2, value);
+                    break;
+                case OPERAND_WIDTH_32:
+                    success = readSigned(encodedCodeArea, position, 4, value);
+                    break;
+                case OPERAND_WIDTH_64:
+                    success = readSigned(encodedCodeArea, position, 8, value);
+                    break;
+                default:
+                    if (format >= OPERAND_SHORT_LIMIT) {
+                        return false;
+                    }
+                    value = kind == OperandKind::ADDRESS ? format - NEAR_JUMP_BIAS : format;
+                    break;
+            }
+            if (!success) {
+                return false;
+            }
+            if (kind == OperandKind::ADDRESS && format != OPERAND_WIDTH_64) {
+                operand = (i + static_cast<std::uint64_t>(value)) * 10;
+            } else {
+                operand = static_cast<std::uint64_t>(value);
+            }
+        }
+        std::memcpy(&codeArea[i * 10], &opcode, sizeof(opcode));
+        std::memcpy(&codeArea[i * 10 + 2], &operand, sizeof(operand));
+    }
+    return position == encodedCodeArea.size();
+}
+
 void Bytecode::outputToBinaryFile(std::unique_ptr<std::ofstream> file) {
+    std::vector<std::uint8_t> encodedCodeArea = encodeCodeArea();
+    std::uint32_t magic = BYTECODE_FILE_MAGIC;
+    std::uint32_t version = BYTECODE_FILE_VERSION;
     std::uint64_t functionMemoryUseMapSize = functionMemoryUseMap.size();
-    std::uint64_t codeAreaByteSize = codeArea.size();
+    std::uint64_t instructionCount = codeArea.size() / 10;
+    std::uint64_t codeAreaByteSize = encodedCodeArea.size();
     std::uint64_t dataAreaByteSize = dataArea.size();
+    file->write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+    file->write(reinterpret_cast<const char *>(&version), sizeof(version));
     file->write(reinterpret_cast<const char *>(&functionMemoryUseMapSize), sizeof(functionMemoryUseMapSize));
+    file->write(reinterpret_cast<const char *>(&instructionCount), sizeof(instructionCount));
     file->write(reinterpret_cast<const char *>(&codeAreaByteSize), sizeof(codeAreaByteSize));
     file->write(reinterpret_cast<const char *>(&dataAreaByteSize), sizeof(dataAreaByteSize));
     for (auto pair : functionMemoryUseMap) {
         file->write(reinterpret_cast<const char *>(&pair.first), sizeof(pair.first));
         file->write(reinterpret_cast<const char *>(&pair.second), sizeof(pair.second));
     }
-    for (auto byte : codeArea) {
+    for (auto byte : encodedCodeArea) {
         file->write(reinterpret_cast<const char *>(&byte), sizeof(byte));
     }
     for (auto byte : dataArea) {
@@ -231,31 +798,71 @@ Bytecode *Bytecode::build(SymbolTable *symbolTable, StringConstantPool *stringCo
     std::vector<std::uint8_t> stringConstantArea = stringConstantPool->serialize();
     bytecode->dataArea = std::vector<std::uint8_t>(8, 0);
     bytecode->dataArea.insert(bytecode->dataArea.end(), stringConstantArea.begin(), stringConstantArea.end());
+    bytecode->createFunctionTable();
     return bytecode;
 }
 
-Bytecode *Bytecode::build(std::unique_ptr<std::ifstream> file) {
-    auto *bytecode = new Bytecode();
+Bytecode *Bytecode::build(std::unique_ptr<std::ifstream> file, std::string &errorMessage) {
+    std::unique_ptr<Bytecode> bytecode(new Bytecode());
+    std::uint32_t magic = 0;
+    std::uint32_t version = BYTECODE_FILE_VERSION_FIXED_LENGTH;
     std::uint64_t functionMemoryUseMapSize;
+    std::uint64_t instructionCount = 0;
     std::uint64_t codeAreaByteSize;
     std::uint64_t dataAreaByteSize;
+    // 版本1的文件没有文件头，以函数内存使用映射表的大小开头，其低32位不会等于魔数
+    file->read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    if (magic == BYTECODE_FILE_MAGIC) {
+        file->read(reinterpret_cast<char *>(&version), sizeof(version));
+    } else {
+        file->clear();
+        file->seekg(0);
+    }
+    if (version != BYTECODE_FILE_VERSION_FIXED_LENGTH && version != BYTECODE_FILE_VERSION_VARIABLE_LENGTH) {
+        errorMessage = "unsupported bytecode file version: " + std::to_string(version);
+        return nullptr;
+    }
+    bytecode->fileVersion = version;
     file->read(reinterpret_cast<char *>(&functionMemoryUseMapSize), sizeof(functionMemoryUseMapSize));
+    if (version == BYTECODE_FILE_VERSION_VARIABLE_LENGTH) {
+        file->read(reinterpret_cast<char *>(&instructionCount), sizeof(instructionCount));
+    }
     file->read(reinterpret_cast<char *>(&codeAreaByteSize), sizeof(codeAreaByteSize));
     file->read(reinterpret_cast<char *>(&dataAreaByteSize), sizeof(dataAreaByteSize));
+    if (file->fail()) {
+        errorMessage = "invalid bytecode file: truncated header";
+        return nullptr;
+    }
     std::pair<std::uint64_t, std::uint64_t> pair;
     std::uint8_t byte;
-    for (int i = 0; i < functionMemoryUseMapSize; i++) {
+    // 各部分的大小都来自文件，读取失败时立即停止，截断的文件不会按照错误的大小继续读取
+    for (std::uint64_t i = 0; i < functionMemoryUseMapSize && !file->fail(); i++) {
         file->read(reinterpret_cast<char *>(&pair.first), sizeof(pair.first));
         file->read(reinterpret_cast<char *>(&pair.second), sizeof(pair.second));
         bytecode->functionMemoryUseMap.insert(pair);
     }
-    for (int i = 0; i < codeAreaByteSize; i++) {
-        file->read(reinterpret_cast<char *>(&byte), sizeof(byte));
-        bytecode->codeArea.push_back(byte);
+    std::vector<std::uint8_t> encodedCodeArea;
+    for (std::uint64_t i = 0; i < codeAreaByteSize && file->read(reinterpret_cast<char *>(&byte), sizeof(byte)); i++) {
+        encodedCodeArea.push_back(byte);
+    }
+    if (file->fail()) {
+        errorMessage = "invalid bytecode file: truncated code area";
+        return nullptr;
+    }
+    if (version == BYTECODE_FILE_VERSION_FIXED_LENGTH) {
+        bytecode->codeArea = std::move(encodedCodeArea);
+        bytecode->repairLegacyPostfixSequences();
+    } else if (!bytecode->decodeCodeArea(encodedCodeArea, instructionCount)) {
+        errorMessage = "invalid bytecode file: malformed code area";
+        return nullptr;
     }
-    for (int i = 0; i < dataAreaByteSize; i++) {
-        file->read(reinterpret_cast<char *>(&byte), sizeof(byte));
+    for (std::uint64_t i = 0; i < dataAreaByteSize && file->read(reinterpret_cast<char *>(&byte), sizeof(byte)); i++) {
         bytecode->dataArea.push_back(byte);
     }
-    return bytecode;
+    if (file->fail()) {
+        errorMessage = "invalid bytecode file: truncated data area";
+        return nullptr;
+    }
+    bytecode->createFunctionTable();
+    return bytecode.release();
 }
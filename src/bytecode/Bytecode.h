@@ -7,19 +7,56 @@
 #include "../constant/StringConstantPool.h"
 #include "../instruction/InstructionSequence.h"
 
+/**
+ * 操作码的助记符，用于输出人类可读的字节码。
+ */
+std::string opcode2String(Opcode opcode);
+
+/**
+ * 函数表中的一项。
+ */
+struct FunctionTableEntry {
+    std::uint64_t address; // 函数入口的指令地址
+    std::uint64_t frameSize; // 函数在数据区中占用的内存大小
+};
+
+/**
+ * 字节码文件的版本。
+ * 版本1没有文件头，代码区中每条指令固定占10字节；版本2以魔数和版本号开头，代码区使用变长编码。
+ */
+constexpr std::uint32_t BYTECODE_FILE_MAGIC = 0x43424343; // 文件开头的"CCBC"
+constexpr std::uint32_t BYTECODE_FILE_VERSION_FIXED_LENGTH = 1;
+constexpr std::uint32_t BYTECODE_FILE_VERSION_VARIABLE_LENGTH = 2;
+constexpr std::uint32_t BYTECODE_FILE_VERSION = BYTECODE_FILE_VERSION_VARIABLE_LENGTH;
+
 class Bytecode {
 private:
     Bytecode() = default;
+    std::uint32_t fileVersion = BYTECODE_FILE_VERSION; // 从文件加载时为文件的版本
     std::map<std::uint64_t, std::uint64_t> functionMemoryUseMap;
+    std::vector<FunctionTableEntry> functionTable; // 由functionMemoryUseMap生成的按入口地址排序的稠密函数表，函数在表中的下标即为函数编号，编号0为全局区
     std::vector<std::uint8_t> codeArea;
     std::vector<std::uint8_t> dataArea;
+    std::uint64_t repairedSequenceCount = 0; // 加载版本1的文件时修复的后置自增和自减序列数
+
+    void createFunctionTable();
+    // 修复旧版编译器为后置自增和自减生成的多复制了一次地址的指令序列
+    void repairLegacyPostfixSequences();
+    // 将每条指令10字节的代码区编码为字节码文件中的变长形式
+    [[nodiscard]] std::vector<std::uint8_t> encodeCodeArea() const;
+    // 将字节码文件中的变长形式解码为每条指令10字节的代码区，格式错误时返回false
+    bool decodeCodeArea(const std::vector<std::uint8_t> &encodedCodeArea, std::uint64_t instructionCount);
 
 public:
     void outputToBinaryFile(std::unique_ptr<std::ofstream> file);
     void outputToHumanReadableFile(std::unique_ptr<std::ofstream> file);
     [[nodiscard]] const std::map<std::uint64_t, std::uint64_t> &getMemoryUseMap() const;
+    [[nodiscard]] const std::vector<FunctionTableEntry> &getFunctionTable() const;
     [[nodiscard]] const std::vector<std::uint8_t> &getCodeArea() const;
     [[nodiscard]] const std::vector<std::uint8_t> &getDataArea() const;
+    [[nodiscard]] std::uint32_t getFileVersion() const;
+    [[nodiscard]] std::uint64_t getRepairedSequenceCount() const;
     static Bytecode *build(SymbolTable *symbolTable, StringConstantPool *stringConstantPool, InstructionSequence *instructionSequence);
-    static Bytecode *build(std::unique_ptr<std::ifstream> file);
+    // 读取字节码文件，版本不支持或者文件格式错误时返回nullptr，错误信息写入errorMessage
+    static Bytecode *build(std::unique_ptr<std::ifstream> file, std::string &errorMessage);
 };
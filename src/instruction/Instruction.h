@@ -82,6 +82,133 @@ enum class Opcode : std::uint16_t {
     SWAP_64, // 交换栈顶的两个值
     FBP, // 基地址入栈
     HLT, // 停机
+    // 以下指令为后续加入的指令，追加在末尾以保证已有字节码文件中的操作码不变
+    JMP_IMM, // 跳转到操作数给出的指令地址
+    JZ_64_IMM, // 值出栈，若全0则跳转到操作数给出的指令地址
+    JNZ_64_IMM, // 值出栈，若非全0则跳转到操作数给出的指令地址
+    CALL_IMM, // 调用操作数给出的指令地址处的函数
+    MEMCPY, // 字节数出栈，源地址出栈，目的地址出栈，复制内存，两段内存可以重叠
+    MEMSET, // 字节数出栈，值出栈，地址出栈，将每个字节设置为值的低8位
+    MEMCMP, // 字节数出栈，右地址出栈，左地址出栈，按无符号字节比较，小于则-1入栈，等于则0入栈，大于则1入栈
+    SQRT_F64, // 值出栈，求平方根，结果入栈
+    FABS_F64, // 值出栈，求绝对值，结果入栈
+    FLOOR_F64, // 值出栈，向下取整，结果入栈
+    CEIL_F64, // 值出栈，向上取整，结果入栈
+    POW_F64, // 右值出栈，左值出栈，求左值的右值次幂，结果入栈
+    EXP_F64, // 值出栈，求e的值次幂，结果入栈
+    LOG_F64, // 值出栈，求自然对数，结果入栈
+    SIN_F64, // 值出栈，求正弦，结果入栈
+    COS_F64, // 值出栈，求余弦，结果入栈
+    MALLOC, // 字节数出栈，在堆区分配内存块，块的地址入栈，空间不足时0入栈
+    FREE, // 地址出栈，释放堆区中的内存块，地址为0时什么也不做
+    REALLOC, // 字节数出栈，地址出栈，调整内存块的大小，新块的地址入栈，空间不足时0入栈且原来的块保持不变
+    ADD_I64_IMM, // 值出栈，与操作数给出的立即数相加，结果入栈，以下带立即数的运算指令的立即数均为右值，语义与同名的不带立即数的指令相同
+    ADD_U64_IMM,
+    ADD_F64_IMM,
+    SUB_I64_IMM, // 值出栈，减去立即数，结果入栈
+    SUB_U64_IMM,
+    SUB_F64_IMM,
+    MUL_I64_IMM, // 值出栈，乘以立即数，结果入栈
+    MUL_U64_IMM,
+    MUL_F64_IMM,
+    DIV_I64_IMM, // 值出栈，除以立即数，结果入栈
+    DIV_U64_IMM,
+    DIV_F64_IMM,
+    MOD_I64_IMM, // 值出栈，对立即数取模，结果入栈
+    MOD_U64_IMM,
+    SL_I64_IMM, // 值出栈，算术左移立即数位，结果入栈
+    SL_U64_IMM, // 值出栈，逻辑左移立即数位，结果入栈
+    SR_I64_IMM, // 值出栈，算术右移立即数位，结果入栈
+    SR_U64_IMM, // 值出栈，逻辑右移立即数位，结果入栈
+    AND_64_IMM, // 值出栈，与立即数按位与，结果入栈
+    OR_64_IMM, // 值出栈，与立即数按位或，结果入栈
+    XOR_64_IMM, // 值出栈，与立即数按位异或，结果入栈
+    GT_I64_IMM, // 值出栈，大于立即数则1入栈，否则0入栈
+    GT_U64_IMM,
+    GT_F64_IMM,
+    LT_I64_IMM, // 值出栈，小于立即数则1入栈，否则0入栈
+    LT_U64_IMM,
+    LT_F64_IMM,
+    EQ_I64_IMM, // 值出栈，等于立即数则1入栈，否则0入栈
+    EQ_U64_IMM,
+    EQ_F64_IMM,
+    BLT_I64, // 右值出栈，左值出栈，左值小于右值则跳转到操作数给出的地址
+    BLT_U64,
+    BLT_F64,
+    BGT_I64, // 右值出栈，左值出栈，左值大于右值则跳转
+    BGT_U64,
+    BGT_F64,
+    BEQ_I64, // 右值出栈，左值出栈，左值等于右值则跳转
+    BEQ_U64,
+    BEQ_F64,
+    BGE_I64, // 右值出栈，左值出栈，左值不小于右值则跳转，浮点数任一值为NaN时也跳转，以下两条同理
+    BGE_U64,
+    BGE_F64,
+    BLE_I64, // 右值出栈，左值出栈，左值不大于右值则跳转
+    BLE_U64,
+    BLE_F64,
+    BNE_I64, // 右值出栈，左值出栈，左值不等于右值则跳转
+    BNE_U64,
+    BNE_F64,
+    ADD_I32, // 右值出栈，左值出栈，按32位相加，结果入栈，以下32位运算指令只使用操作数的低32位（f32为转换成float后的值），按32位回绕，结果经符号扩展、零扩展或转换成double后入栈
+    ADD_U32,
+    ADD_F32,
+    SUB_I32, // 右值出栈，左值出栈，按32位相减，结果入栈
+    SUB_U32,
+    SUB_F32,
+    MUL_I32, // 右值出栈，左值出栈，按32位相乘，结果入栈
+    MUL_U32,
+    MUL_F32,
+    DIV_I32, // 右值出栈，左值出栈，按32位相除，结果入栈
+    DIV_U32,
+    DIV_F32,
+    MOD_I32, // 右值出栈，左值出栈，按32位取模，结果入栈
+    MOD_U32,
+    NEG_I32, // 值出栈，按32位取负，结果入栈
+    NEG_F32,
+    SL_I32, // 右值出栈，左值出栈，按32位左移，移位数只取低5位，结果入栈
+    SL_U32,
+    SR_I32, // 右值出栈，左值出栈，按32位算术右移，移位数只取低5位，结果入栈
+    SR_U32, // 右值出栈，左值出栈，按32位逻辑右移，移位数只取低5位，结果入栈
+    ADD_I32_IMM, // 值出栈，按32位与立即数相加，结果入栈，以下带立即数的32位运算指令的语义与同名的不带立即数的指令相同
+    ADD_U32_IMM,
+    ADD_F32_IMM,
+    SUB_I32_IMM,
+    SUB_U32_IMM,
+    SUB_F32_IMM,
+    MUL_I32_IMM,
+    MUL_U32_IMM,
+    MUL_F32_IMM,
+    DIV_I32_IMM,
+    DIV_U32_IMM,
+    DIV_F32_IMM,
+    MOD_I32_IMM,
+    MOD_U32_IMM,
+    SL_I32_IMM,
+    SL_U32_IMM,
+    SR_I32_IMM,
+    SR_U32_IMM,
+    // 以下为虚拟机加载字节码时融合得到的超级指令，只在虚拟机内部使用，不会出现在字节码文件中
+    // 后续加入的字节码指令应插入在这些指令之前
+    LOCAL_ADDRESS, // push_64 fbp add_u64，局部变量地址入栈
+    LOAD_LOCAL_I32, // push_64 fbp add_u64 load_i32，加载局部变量
+    LOAD_LOCAL_I64,
+    LOAD_LOCAL_U64,
+    LOAD_LOCAL_F64,
+    STORE_LOCAL_I32, // push_64 fbp add_u64 push_64 store_i32，将常量存储到局部变量
+    STORE_LOCAL_I64,
+    STORE_POP_I32, // store_i32 load_i32 pop_64，存储并丢弃赋值表达式的值
+    STORE_POP_I64,
+    CMP_BRANCH_GT_I64, // gt_i64 jz_64_imm，比较，不满足时跳转
+    CMP_BRANCH_LT_I64,
+    CMP_BRANCH_EQ_I64,
+    POP_PUSH, // pop_64 push_64，用立即数替换栈顶值
+    PUSH_BLT_I64, // push_64 blt_i64，与常量比较并跳转，跳转地址保存在序列第2条指令的操作数中
+    PUSH_BGT_I64,
+    PUSH_BEQ_I64,
+    PUSH_BGE_I64,
+    PUSH_BLE_I64,
+    PUSH_BNE_I64,
 };
 
 struct Instruction {
@@ -97,7 +224,7 @@ struct Instruction {
         std::uint64_t u64 = 0;
         float f32;
         double f64;
-    } operand; // 只有push指令拥有操作数
+    } operand; // 只有push指令和带立即数的运算、跳转、调用指令拥有操作数
 
     explicit Instruction(Opcode opcode) {
         this->opcode = opcode;
@@ -1,25 +1,32 @@
 #include "InstructionSequenceBuilder.h"
 
+#include <bit>
 #include <cassert>
 
 void InstructionSequenceBuilder::appendAdd(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::ADD_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::ADD_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::ADD_U64);
             break;
-        case BinaryDataType::F32:
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::ADD_U32);
+            break;
         case BinaryDataType::F64:
             instructionList.emplace_back(Opcode::ADD_F64);
             break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::ADD_F32);
+            break;
     }
 }
 
@@ -27,20 +34,26 @@ void InstructionSequenceBuilder::appendSub(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::SUB_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SUB_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::SUB_U64);
             break;
-        case BinaryDataType::F32:
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SUB_U32);
+            break;
         case BinaryDataType::F64:
             instructionList.emplace_back(Opcode::SUB_F64);
             break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::SUB_F32);
+            break;
     }
 }
 
@@ -48,20 +61,26 @@ void InstructionSequenceBuilder::appendMul(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::MUL_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::MUL_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::MUL_U64);
             break;
-        case BinaryDataType::F32:
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::MUL_U32);
+            break;
         case BinaryDataType::F64:
             instructionList.emplace_back(Opcode::MUL_F64);
             break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::MUL_F32);
+            break;
     }
 }
 
@@ -69,20 +88,26 @@ void InstructionSequenceBuilder::appendDiv(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::DIV_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::DIV_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::DIV_U64);
             break;
-        case BinaryDataType::F32:
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::DIV_U32);
+            break;
         case BinaryDataType::F64:
             instructionList.emplace_back(Opcode::DIV_F64);
             break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::DIV_F32);
+            break;
     }
 }
 
@@ -90,16 +115,20 @@ void InstructionSequenceBuilder::appendMod(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::MOD_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::MOD_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::MOD_U64);
             break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::MOD_U32);
+            break;
         case BinaryDataType::F32:
         case BinaryDataType::F64:
             assert(false);
@@ -110,19 +139,23 @@ void InstructionSequenceBuilder::appendNeg(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::NEG_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::NEG_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
         case BinaryDataType::U32:
         case BinaryDataType::U64:
             assert(false);
-        case BinaryDataType::F32:
         case BinaryDataType::F64:
             instructionList.emplace_back(Opcode::NEG_F64);
             break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::NEG_F32);
+            break;
     }
 }
 
@@ -130,16 +163,20 @@ void InstructionSequenceBuilder::appendSl(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::SL_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SL_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::SL_U64);
             break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SL_U32);
+            break;
         case BinaryDataType::F32:
         case BinaryDataType::F64:
             assert(false);
@@ -150,16 +187,20 @@ void InstructionSequenceBuilder::appendSr(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
         case BinaryDataType::I16:
-        case BinaryDataType::I32:
         case BinaryDataType::I64:
             instructionList.emplace_back(Opcode::SR_I64);
             break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SR_I32);
+            break;
         case BinaryDataType::U8:
         case BinaryDataType::U16:
-        case BinaryDataType::U32:
         case BinaryDataType::U64:
             instructionList.emplace_back(Opcode::SR_U64);
             break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SR_U32);
+            break;
         case BinaryDataType::F32:
         case BinaryDataType::F64:
             assert(false);
@@ -285,6 +326,284 @@ void InstructionSequenceBuilder::appendCast(BinaryDataType sourceBinaryDataType,
     }
 }
 
+void InstructionSequenceBuilder::appendAdd(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::ADD_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::ADD_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::ADD_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::ADD_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::ADD_F64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::ADD_F32_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendSub(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::SUB_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SUB_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::SUB_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SUB_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::SUB_F64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::SUB_F32_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendMul(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::MUL_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::MUL_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::MUL_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::MUL_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::MUL_F64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::MUL_F32_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendDiv(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::DIV_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::DIV_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::DIV_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::DIV_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::DIV_F64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+            instructionList.emplace_back(Opcode::DIV_F32_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendMod(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::MOD_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::MOD_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::MOD_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::MOD_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            assert(false);
+    }
+}
+
+void InstructionSequenceBuilder::appendSl(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::SL_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SL_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::SL_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SL_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            assert(false);
+    }
+}
+
+void InstructionSequenceBuilder::appendSr(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::SR_I64_IMM, immediate);
+            break;
+        case BinaryDataType::I32:
+            instructionList.emplace_back(Opcode::SR_I32_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::SR_U64_IMM, immediate);
+            break;
+        case BinaryDataType::U32:
+            instructionList.emplace_back(Opcode::SR_U32_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            assert(false);
+    }
+}
+
+void InstructionSequenceBuilder::appendAnd(std::uint64_t immediate) {
+    instructionList.emplace_back(Opcode::AND_64_IMM, immediate);
+}
+
+void InstructionSequenceBuilder::appendOr(std::uint64_t immediate) {
+    instructionList.emplace_back(Opcode::OR_64_IMM, immediate);
+}
+
+void InstructionSequenceBuilder::appendXor(std::uint64_t immediate) {
+    instructionList.emplace_back(Opcode::XOR_64_IMM, immediate);
+}
+
+void InstructionSequenceBuilder::appendGt(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::GT_I64_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::GT_U64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::GT_F64_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendLt(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::LT_I64_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::LT_U64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::LT_F64_IMM, immediate);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendEq(BinaryDataType binaryDataType, std::uint64_t immediate) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::EQ_I64_IMM, immediate);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::EQ_U64_IMM, immediate);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::EQ_F64_IMM, immediate);
+            break;
+    }
+}
+
+std::uint64_t InstructionSequenceBuilder::castConstant(std::uint64_t value, BinaryDataType sourceBinaryDataType, BinaryDataType targetBinaryDataType) {
+    bool sourceSigned = sourceBinaryDataType == BinaryDataType::I8 || sourceBinaryDataType == BinaryDataType::I16 || sourceBinaryDataType == BinaryDataType::I32 || sourceBinaryDataType == BinaryDataType::I64;
+    bool sourceUnsigned = sourceBinaryDataType == BinaryDataType::U8 || sourceBinaryDataType == BinaryDataType::U16 || sourceBinaryDataType == BinaryDataType::U32 || sourceBinaryDataType == BinaryDataType::U64;
+    bool targetFloat = targetBinaryDataType == BinaryDataType::F32 || targetBinaryDataType == BinaryDataType::F64;
+    bool sourceFloat = !sourceSigned && !sourceUnsigned;
+    bool targetSigned = targetBinaryDataType == BinaryDataType::I8 || targetBinaryDataType == BinaryDataType::I16 || targetBinaryDataType == BinaryDataType::I32 || targetBinaryDataType == BinaryDataType::I64;
+    bool targetUnsigned = !targetSigned && !targetFloat;
+    // 整数之间的转换不改变64位的值，与appendCast不生成指令或者生成cast_i64_u64、cast_u64_i64的情况一致
+    if (sourceSigned && targetFloat) {
+        return std::bit_cast<std::uint64_t>(static_cast<double>(std::bit_cast<std::int64_t>(value)));
+    }
+    if (sourceUnsigned && targetFloat) {
+        return std::bit_cast<std::uint64_t>(static_cast<double>(value));
+    }
+    if (sourceFloat && targetSigned) {
+        return std::bit_cast<std::uint64_t>(static_cast<std::int64_t>(std::bit_cast<double>(value)));
+    }
+    if (sourceFloat && targetUnsigned) {
+        return static_cast<std::uint64_t>(std::bit_cast<double>(value));
+    }
+    return value;
+}
+
 void InstructionSequenceBuilder::appendJmp() {
     instructionList.emplace_back(Opcode::JMP);
 }
@@ -297,6 +616,144 @@ void InstructionSequenceBuilder::appendJnz() {
     instructionList.emplace_back(Opcode::JNZ_64);
 }
 
+void InstructionSequenceBuilder::appendJmp(std::uint64_t address) {
+    instructionList.emplace_back(Opcode::JMP_IMM, address);
+}
+
+void InstructionSequenceBuilder::appendJz(std::uint64_t address) {
+    instructionList.emplace_back(Opcode::JZ_64_IMM, address);
+}
+
+void InstructionSequenceBuilder::appendJnz(std::uint64_t address) {
+    instructionList.emplace_back(Opcode::JNZ_64_IMM, address);
+}
+
+void InstructionSequenceBuilder::appendBlt(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BLT_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BLT_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BLT_F64, address);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendBgt(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BGT_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BGT_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BGT_F64, address);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendBeq(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BEQ_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BEQ_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BEQ_F64, address);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendBge(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BGE_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BGE_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BGE_F64, address);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendBle(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BLE_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BLE_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BLE_F64, address);
+            break;
+    }
+}
+
+void InstructionSequenceBuilder::appendBne(BinaryDataType binaryDataType, std::uint64_t address) {
+    switch (binaryDataType) {
+        case BinaryDataType::I8:
+        case BinaryDataType::I16:
+        case BinaryDataType::I32:
+        case BinaryDataType::I64:
+            instructionList.emplace_back(Opcode::BNE_I64, address);
+            break;
+        case BinaryDataType::U8:
+        case BinaryDataType::U16:
+        case BinaryDataType::U32:
+        case BinaryDataType::U64:
+            instructionList.emplace_back(Opcode::BNE_U64, address);
+            break;
+        case BinaryDataType::F32:
+        case BinaryDataType::F64:
+            instructionList.emplace_back(Opcode::BNE_F64, address);
+            break;
+    }
+}
+
 void InstructionSequenceBuilder::appendLoad(BinaryDataType binaryDataType) {
     switch (binaryDataType) {
         case BinaryDataType::I8:
@@ -421,10 +878,74 @@ void InstructionSequenceBuilder::appendCall() {
     instructionList.emplace_back(Opcode::CALL);
 }
 
+void InstructionSequenceBuilder::appendCall(std::uint64_t address) {
+    instructionList.emplace_back(Opcode::CALL_IMM, address);
+}
+
 void InstructionSequenceBuilder::appendRet() {
     instructionList.emplace_back(Opcode::RET);
 }
 
+void InstructionSequenceBuilder::appendMemcpy() {
+    instructionList.emplace_back(Opcode::MEMCPY);
+}
+
+void InstructionSequenceBuilder::appendMemset() {
+    instructionList.emplace_back(Opcode::MEMSET);
+}
+
+void InstructionSequenceBuilder::appendMemcmp() {
+    instructionList.emplace_back(Opcode::MEMCMP);
+}
+
+void InstructionSequenceBuilder::appendSqrt() {
+    instructionList.emplace_back(Opcode::SQRT_F64);
+}
+
+void InstructionSequenceBuilder::appendFabs() {
+    instructionList.emplace_back(Opcode::FABS_F64);
+}
+
+void InstructionSequenceBuilder::appendFloor() {
+    instructionList.emplace_back(Opcode::FLOOR_F64);
+}
+
+void InstructionSequenceBuilder::appendCeil() {
+    instructionList.emplace_back(Opcode::CEIL_F64);
+}
+
+void InstructionSequenceBuilder::appendPow() {
+    instructionList.emplace_back(Opcode::POW_F64);
+}
+
+void InstructionSequenceBuilder::appendExp() {
+    instructionList.emplace_back(Opcode::EXP_F64);
+}
+
+void InstructionSequenceBuilder::appendLog() {
+    instructionList.emplace_back(Opcode::LOG_F64);
+}
+
+void InstructionSequenceBuilder::appendSin() {
+    instructionList.emplace_back(Opcode::SIN_F64);
+}
+
+void InstructionSequenceBuilder::appendCos() {
+    instructionList.emplace_back(Opcode::COS_F64);
+}
+
+void InstructionSequenceBuilder::appendMalloc() {
+    instructionList.emplace_back(Opcode::MALLOC);
+}
+
+void InstructionSequenceBuilder::appendFree() {
+    instructionList.emplace_back(Opcode::FREE);
+}
+
+void InstructionSequenceBuilder::appendRealloc() {
+    instructionList.emplace_back(Opcode::REALLOC);
+}
+
 void InstructionSequenceBuilder::appendPush(std::int8_t value) {
     instructionList.emplace_back(Opcode::PUSH_64, value);
 }
@@ -525,6 +1046,16 @@ void InstructionSequenceBuilder::modifyPush(int instructionIndex, std::uint64_t
     instructionList[instructionIndex].operand.u64 = value;
 }
 
+void InstructionSequenceBuilder::modifyAddress(int instructionIndex, std::uint64_t address) {
+    assert(instructionList[instructionIndex].opcode == Opcode::PUSH_64
+           || instructionList[instructionIndex].opcode == Opcode::JMP_IMM
+           || instructionList[instructionIndex].opcode == Opcode::JZ_64_IMM
+           || instructionList[instructionIndex].opcode == Opcode::JNZ_64_IMM
+           || (instructionList[instructionIndex].opcode >= Opcode::BLT_I64 && instructionList[instructionIndex].opcode <= Opcode::BNE_F64)
+           || instructionList[instructionIndex].opcode == Opcode::CALL_IMM);
+    instructionList[instructionIndex].operand.u64 = address;
+}
+
 Instruction InstructionSequenceBuilder::getLastInstruction() {
     return instructionList.back();
 }
@@ -31,9 +31,33 @@ public:
     void appendLt(BinaryDataType binaryDataType);
     void appendEq(BinaryDataType binaryDataType);
     void appendCast(BinaryDataType sourceBinaryDataType, BinaryDataType targetBinaryDataType);
+    // 以下带立即数的版本的右值由immediate给出，immediate为右值入栈后的64位原始值
+    void appendAdd(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendSub(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendMul(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendDiv(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendMod(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendSl(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendSr(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendAnd(std::uint64_t immediate);
+    void appendOr(std::uint64_t immediate);
+    void appendXor(std::uint64_t immediate);
+    void appendGt(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendLt(BinaryDataType binaryDataType, std::uint64_t immediate);
+    void appendEq(BinaryDataType binaryDataType, std::uint64_t immediate);
+    static std::uint64_t castConstant(std::uint64_t value, BinaryDataType sourceBinaryDataType, BinaryDataType targetBinaryDataType); // 在编译期对常量做与appendCast生成的指令相同的转换
     void appendJmp();
     void appendJz();
     void appendJnz();
+    void appendJmp(std::uint64_t address);
+    void appendJz(std::uint64_t address);
+    void appendJnz(std::uint64_t address);
+    void appendBlt(BinaryDataType binaryDataType, std::uint64_t address);
+    void appendBgt(BinaryDataType binaryDataType, std::uint64_t address);
+    void appendBeq(BinaryDataType binaryDataType, std::uint64_t address);
+    void appendBge(BinaryDataType binaryDataType, std::uint64_t address);
+    void appendBle(BinaryDataType binaryDataType, std::uint64_t address);
+    void appendBne(BinaryDataType binaryDataType, std::uint64_t address);
     void appendLoad(BinaryDataType binaryDataType);
     void appendStore(BinaryDataType binaryDataType);
     void appendIn(BinaryDataType binaryDataType);
@@ -41,7 +65,23 @@ public:
     void appendOut(BinaryDataType binaryDataType);
     void appendOut();
     void appendCall();
+    void appendCall(std::uint64_t address);
     void appendRet();
+    void appendMemcpy();
+    void appendMemset();
+    void appendMemcmp();
+    void appendSqrt();
+    void appendFabs();
+    void appendFloor();
+    void appendCeil();
+    void appendPow();
+    void appendExp();
+    void appendLog();
+    void appendSin();
+    void appendCos();
+    void appendMalloc();
+    void appendFree();
+    void appendRealloc();
     void appendPush(std::int8_t value);
     void appendPush(std::int16_t value);
     void appendPush(std::int32_t value);
@@ -65,6 +105,7 @@ public:
     void modifyPush(int instructionIndex, std::uint16_t value);
     void modifyPush(int instructionIndex, std::uint32_t value);
     void modifyPush(int instructionIndex, std::uint64_t value);
+    void modifyAddress(int instructionIndex, std::uint64_t address); // 修改PUSH指令压入的地址或带立即数的跳转、比较并跳转、调用指令的目标地址
     Instruction getLastInstruction();
     int getNextInstructionIndex();
     std::uint64_t getNextInstructionAddress() const;
@@ -0,0 +1,1214 @@
+#include "JitCompiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if VM_JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+/*
+ * 本地代码中固定用途的寄存器，均为被调用者保存的寄存器，调用辅助函数时不会被破坏。
+ */
+static constexpr X86Register STACK_POINTER = X86Register::R12; // 栈顶元素的下一个位置
+static constexpr X86Register DATA_AREA = X86Register::R13; // 数据区的起始地址
+static constexpr X86Register BASE_POINTER = X86Register::R14; // 当前基地址
+static constexpr X86Register STATE = X86Register::R15; // JitState的地址
+static constexpr X86Register FRAME_BASE = X86Register::RBX; // 数据区中当前基地址的本地地址，即DATA_AREA + BASE_POINTER
+
+/*
+ * 本地代码直接读写解释器的调用栈帧，布局与CallFrame一致。
+ */
+static constexpr std::int32_t CALL_FRAME_SIZE = 24;
+static constexpr std::int32_t CALL_FRAME_RETURN_INDEX = 0;
+static constexpr std::int32_t CALL_FRAME_SAVED_BP = 8;
+static constexpr std::int32_t CALL_FRAME_FUNCTION_INDEX = 16;
+
+static bool fitsInt32(std::uint64_t value) {
+    auto signedValue = static_cast<std::int64_t>(value);
+    return signedValue >= INT32_MIN && signedValue <= INT32_MAX;
+}
+
+static std::uint64_t castU64ToF64(std::uint64_t value) {
+    auto result = static_cast<double>(value);
+    std::uint64_t bits;
+    std::memcpy(&bits, &result, sizeof(bits));
+    return bits;
+}
+
+static std::uint64_t castF64ToU64(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return static_cast<std::uint64_t>(value);
+}
+
+/*
+ * 数学函数指令的辅助函数，参数和结果都是double的位模式。
+ */
+template<double (*function)(double)>
+static std::uint64_t applyF64(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    auto result = function(value);
+    std::memcpy(&bits, &result, sizeof(bits));
+    return bits;
+}
+
+static double sqrtF64(double value) {
+    return std::sqrt(value);
+}
+
+static double fabsF64(double value) {
+    return std::fabs(value);
+}
+
+static double floorF64(double value) {
+    return std::floor(value);
+}
+
+static double ceilF64(double value) {
+    return std::ceil(value);
+}
+
+static double expF64(double value) {
+    return std::exp(value);
+}
+
+static double logF64(double value) {
+    return std::log(value);
+}
+
+static double sinF64(double value) {
+    return std::sin(value);
+}
+
+static double cosF64(double value) {
+    return std::cos(value);
+}
+
+static std::uint64_t powF64(std::uint64_t leftBits, std::uint64_t rightBits) {
+    double leftValue;
+    double rightValue;
+    std::memcpy(&leftValue, &leftBits, sizeof(leftValue));
+    std::memcpy(&rightValue, &rightBits, sizeof(rightValue));
+    auto result = std::pow(leftValue, rightValue);
+    std::uint64_t bits;
+    std::memcpy(&bits, &result, sizeof(bits));
+    return bits;
+}
+
+static bool isJump(Opcode opcode) {
+    return opcode == Opcode::JMP || opcode == Opcode::JZ_64 || opcode == Opcode::JNZ_64;
+}
+
+static bool isImmediateJump(Opcode opcode) {
+    return opcode == Opcode::JMP_IMM || opcode == Opcode::JZ_64_IMM || opcode == Opcode::JNZ_64_IMM || (opcode >= Opcode::BLT_I64 && opcode <= Opcode::BNE_F64);
+}
+
+static bool isImmediateOperation(Opcode opcode) {
+    return (opcode >= Opcode::ADD_I64_IMM && opcode <= Opcode::EQ_F64_IMM) || (opcode >= Opcode::ADD_I32_IMM && opcode <= Opcode::SR_U32_IMM);
+}
+
+JitCompiler::JitCompiler(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, std::uint64_t threshold)
+        : instructionList(instructionList), functionTable(functionTable), threshold(threshold) {
+    counterList.resize(instructionList.size(), 0);
+    compiledList.resize(functionTable.size(), false);
+    functionEntryList.resize(functionTable.size(), nullptr);
+    nativeEntryList.resize(instructionList.size());
+}
+
+JitCompiler::~JitCompiler() {
+#if VM_JIT_SUPPORTED
+    for (auto &codeRegion : codeRegionList) {
+        munmap(codeRegion.memory, codeRegion.size);
+    }
+#endif
+}
+
+std::uint32_t JitCompiler::functionIndexOf(std::uint64_t index) const {
+    auto iterator = std::upper_bound(functionTable.begin(), functionTable.end(), index * 10, [](std::uint64_t address, const FunctionTableEntry &entry) {
+        return address < entry.address;
+    });
+    return static_cast<std::uint32_t>(iterator - functionTable.begin() - 1);
+}
+
+std::uint64_t JitCompiler::fusedJumpTarget(std::uint64_t index) const {
+    return instructionList[index - 1].operand / 10;
+}
+
+bool JitCompiler::isJumpFusable(std::uint64_t index, std::uint64_t begin, std::uint64_t end, const std::vector<bool> &jumpTargetList) const {
+    // 栈式跳转只有在紧跟一条压入常量地址的指令、且自身不是跳转目标时，目标地址才能在编译时确定
+    if (index <= begin || instructionList[index - 1].opcode != Opcode::PUSH_64 || jumpTargetList[index - begin]) {
+        return false;
+    }
+    auto address = instructionList[index - 1].operand;
+    return address % 10 == 0 && address / 10 >= begin && address / 10 < end;
+}
+
+std::vector<std::uint64_t> JitCompiler::createCountPointList() const {
+    std::vector<std::uint64_t> countPointList;
+    for (std::uint64_t i = 1; i < functionTable.size(); i++) {
+        if (functionTable[i].address / 10 < instructionList.size()) {
+            countPointList.push_back(functionTable[i].address / 10);
+        }
+    }
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        std::uint64_t target;
+        if (isImmediateJump(instructionList[i].opcode)) {
+            target = instructionList[i].operand / 10;
+        } else if (isJump(instructionList[i].opcode) && i > 0 && instructionList[i - 1].opcode == Opcode::PUSH_64) {
+            target = fusedJumpTarget(i);
+        } else {
+            continue;
+        }
+        if (target <= i) {
+            countPointList.push_back(target);
+        }
+    }
+    std::sort(countPointList.begin(), countPointList.end());
+    countPointList.erase(std::unique(countPointList.begin(), countPointList.end()), countPointList.end());
+    return countPointList;
+}
+
+bool JitCompiler::count(std::uint64_t index) {
+    return ++counterList[index] == threshold;
+}
+
+std::vector<std::uint64_t> JitCompiler::compile(std::uint64_t index) {
+#if VM_JIT_SUPPORTED
+    auto functionIndex = functionIndexOf(index);
+    if (compiledList[functionIndex]) {
+        return {};
+    }
+    compiledList[functionIndex] = true;
+    std::uint64_t begin = functionTable[functionIndex].address / 10;
+    std::uint64_t end = functionIndex + 1 < functionTable.size() ? std::min<std::uint64_t>(functionTable[functionIndex + 1].address / 10, instructionList.size()) : instructionList.size();
+    if (begin >= end) {
+        return {};
+    }
+    // 找出函数内的跳转目标
+    std::vector<bool> jumpTargetList(end - begin, false);
+    for (std::uint64_t i = begin; i < end; i++) {
+        std::uint64_t target;
+        if (isImmediateJump(instructionList[i].opcode)) {
+            target = instructionList[i].operand / 10;
+        } else if (isJump(instructionList[i].opcode) && i > begin && instructionList[i - 1].opcode == Opcode::PUSH_64) {
+            target = fusedJumpTarget(i);
+        } else {
+            continue;
+        }
+        if (target >= begin && target < end) {
+            jumpTargetList[target - begin] = true;
+        }
+    }
+    X86Assembler assembler;
+    std::vector<std::uint64_t> labelOffsetList(end - begin, 0);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> forwardJumpList; // 待回填的函数内跳转，rel32的位置和目标指令索引
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> exitJumpList; // 待回填的退出跳转，rel32的位置和解释器继续执行的指令索引
+    std::vector<std::uint64_t> entryIndexList;
+    auto jumpTo = [&](std::uint64_t position, std::uint64_t offset) {
+        assembler.patchInt32(position, static_cast<std::int32_t>(offset - (position + 4)));
+    };
+    auto emitJump = [&](std::uint64_t position, std::uint64_t target) {
+        if (target >= begin && target < end) {
+            forwardJumpList.emplace_back(position, target);
+        } else {
+            exitJumpList.emplace_back(position, target);
+        }
+    };
+    // 序言：保存被调用者保存的寄存器和进入时的rsp，加载虚拟机状态后调用第二个参数给出的地址，
+    // 这样最外层的本地函数执行ret时回到序言之后，由解释器从调用栈帧给出的返回地址继续执行
+    assembler.push(X86Register::RBX);
+    assembler.push(X86Register::RBP);
+    assembler.push(X86Register::R12);
+    assembler.push(X86Register::R13);
+    assembler.push(X86Register::R14);
+    assembler.push(X86Register::R15);
+    assembler.move(X86Register::RBP, X86Register::RSP);
+    assembler.move(STATE, X86Register::RDI);
+    assembler.load(STACK_POINTER, STATE, offsetof(JitState, sp));
+    assembler.load(DATA_AREA, STATE, offsetof(JitState, dataArea));
+    assembler.load(BASE_POINTER, STATE, offsetof(JitState, bp));
+    assembler.move(FRAME_BASE, DATA_AREA);
+    assembler.alu(X86AluOperation::ADD, FRAME_BASE, BASE_POINTER);
+    assembler.callRegister(X86Register::RSI);
+    // 返回指令把返回地址的指令索引放在rcx中
+    assembler.store(STATE, offsetof(JitState, nextIndex), X86Register::RCX);
+    assembler.moveImmediate(X86Register::RAX, static_cast<std::uint64_t>(JitExitStatus::RETURN));
+    // 尾声：写回栈顶位置和基地址，丢弃本地调用留下的返回地址，退出原因已经放在eax中
+    std::uint64_t epilogueOffset = assembler.size();
+    assembler.store(STATE, offsetof(JitState, sp), STACK_POINTER);
+    assembler.store(STATE, offsetof(JitState, bp), BASE_POINTER);
+    assembler.move(X86Register::RSP, X86Register::RBP);
+    assembler.pop(X86Register::R15);
+    assembler.pop(X86Register::R14);
+    assembler.pop(X86Register::R13);
+    assembler.pop(X86Register::R12);
+    assembler.pop(X86Register::RBP);
+    assembler.pop(X86Register::RBX);
+    assembler.ret();
+    std::uint64_t overflowOffset = assembler.size();
+    assembler.moveImmediate(X86Register::RAX, static_cast<std::uint64_t>(JitExitStatus::OPERAND_STACK_OVERFLOW));
+    jumpTo(assembler.jump(), epilogueOffset);
+    auto emitExit = [&](std::uint64_t target) {
+        assembler.moveImmediate(X86Register::RAX, target);
+        assembler.store(STATE, offsetof(JitState, nextIndex), X86Register::RAX);
+        assembler.alu(X86AluOperation::XOR, X86Register::RAX, X86Register::RAX);
+        jumpTo(assembler.jump(), epilogueOffset);
+    };
+    auto emitStoreConstant = [&](X86Register base, std::int32_t displacement, std::uint64_t value) {
+        if (fitsInt32(value)) {
+            assembler.storeImmediate(base, displacement, static_cast<std::int32_t>(value));
+        } else {
+            assembler.moveImmediate(X86Register::RDX, value);
+            assembler.store(base, displacement, X86Register::RDX);
+        }
+    };
+    /*
+     * 虚拟操作数栈。
+     * 栈顶附近的元素在编译时表示为常量、基地址加偏移或者寄存器，只在跳转目标、跳转、调用、返回、辅助函数调用和退出之前写回内存，
+     * 因此基本块内的压栈、交换和常量运算不产生代码，运算结果也不必经过内存。
+     * 写回时一次性检查操作数栈是否溢出，只有写回内存的元素占用操作数栈，延迟在寄存器中的元素不会导致溢出。
+     * 写回和分配寄存器只使用rdx作为临时寄存器，rax和rcx留给各个指令模板使用。
+     */
+    enum class StackItemKind {
+        CONSTANT, // value为常量
+        FRAME_ADDRESS, // 值为bp + value，value可以表示为32位有符号数
+        REGISTER, // 值在reg中
+    };
+    struct StackItem {
+        StackItemKind kind;
+        std::uint64_t value;
+        X86Register reg;
+    };
+    std::vector<StackItem> virtualStack;
+    std::vector<X86Register> freeRegisterList = {X86Register::RDI, X86Register::RSI, X86Register::R11, X86Register::R10, X86Register::R9, X86Register::R8};
+    auto releaseRegister = [&](X86Register reg) {
+        freeRegisterList.push_back(reg);
+    };
+    // 将元素的值放入reg，寄存器元素的寄存器随之释放
+    auto emitItemTo = [&](const StackItem &item, X86Register reg) {
+        if (item.kind == StackItemKind::CONSTANT) {
+            if (item.value == 0) {
+                assembler.alu(X86AluOperation::XOR, reg, reg);
+            } else {
+                assembler.moveImmediate(reg, item.value);
+            }
+        } else if (item.kind == StackItemKind::FRAME_ADDRESS) {
+            assembler.loadAddress(reg, BASE_POINTER, static_cast<std::int32_t>(item.value));
+        } else {
+            if (item.reg != reg) {
+                assembler.move(reg, item.reg);
+            }
+            releaseRegister(item.reg);
+        }
+    };
+    auto flushVirtualStack = [&]() {
+        if (virtualStack.empty()) {
+            return;
+        }
+        auto size = static_cast<std::int32_t>(virtualStack.size() * sizeof(std::uint64_t));
+        assembler.loadAddress(X86Register::RDX, STACK_POINTER, size);
+        assembler.compareMemory(X86Register::RDX, STATE, offsetof(JitState, operandStackEnd));
+        jumpTo(assembler.jumpIf(X86Condition::A), overflowOffset);
+        for (std::size_t k = 0; k < virtualStack.size(); k++) {
+            const auto &item = virtualStack[k];
+            auto displacement = static_cast<std::int32_t>(k * sizeof(std::uint64_t));
+            if (item.kind == StackItemKind::CONSTANT) {
+                emitStoreConstant(STACK_POINTER, displacement, item.value);
+            } else if (item.kind == StackItemKind::FRAME_ADDRESS) {
+                assembler.loadAddress(X86Register::RDX, BASE_POINTER, static_cast<std::int32_t>(item.value));
+                assembler.store(STACK_POINTER, displacement, X86Register::RDX);
+            } else {
+                assembler.store(STACK_POINTER, displacement, item.reg);
+                releaseRegister(item.reg);
+            }
+        }
+        assembler.addImmediate(STACK_POINTER, size);
+        virtualStack.clear();
+    };
+    // 没有空闲寄存器时把虚拟栈全部写回，正在使用的寄存器不在虚拟栈中，最多只有两个
+    auto allocateRegister = [&]() {
+        if (freeRegisterList.empty()) {
+            flushVirtualStack();
+        }
+        auto reg = freeRegisterList.back();
+        freeRegisterList.pop_back();
+        return reg;
+    };
+    // 虚拟栈中的元素不足count个时，从内存中的栈顶取出元素补到虚拟栈底部
+    auto ensureItems = [&](std::size_t count) {
+        while (virtualStack.size() < count) {
+            auto reg = allocateRegister();
+            assembler.load(reg, STACK_POINTER, -8);
+            assembler.subImmediate(STACK_POINTER, 8);
+            virtualStack.insert(virtualStack.begin(), {StackItemKind::REGISTER, 0, reg});
+        }
+    };
+    auto popItem = [&]() {
+        ensureItems(1);
+        auto item = virtualStack.back();
+        virtualStack.pop_back();
+        return item;
+    };
+    auto popToRegister = [&](X86Register reg) {
+        emitItemTo(popItem(), reg);
+    };
+    // 弹出栈顶元素放入一个归调用者所有的寄存器，用完后需要释放或者重新压入虚拟栈
+    auto popToAnyRegister = [&]() {
+        auto item = popItem();
+        if (item.kind == StackItemKind::REGISTER) {
+            return item.reg;
+        }
+        auto reg = allocateRegister();
+        emitItemTo(item, reg);
+        return reg;
+    };
+    auto pushRegister = [&](X86Register reg) {
+        virtualStack.push_back({StackItemKind::REGISTER, 0, reg});
+    };
+    auto pushResult = [&]() {
+        auto reg = allocateRegister();
+        assembler.move(reg, X86Register::RAX);
+        pushRegister(reg);
+    };
+    // 二元运算的右值，带立即数的指令直接由立即数给出
+    bool immediateOperand = false;
+    std::uint64_t immediate = 0;
+    auto popRightOperand = [&]() {
+        return immediateOperand ? StackItem{StackItemKind::CONSTANT, immediate, X86Register::RAX} : popItem();
+    };
+    // 用右值的寄存器或者立即数执行op left, right，右值的寄存器随之释放
+    auto emitWithRightOperand = [&](const StackItem &right, X86Register left, X86AluOperation operation, bool isMultiply) {
+        if (right.kind == StackItemKind::CONSTANT && fitsInt32(right.value)) {
+            if (isMultiply) {
+                assembler.multiplyImmediate(left, static_cast<std::int32_t>(right.value));
+            } else {
+                assembler.aluImmediate(operation, left, static_cast<std::int32_t>(right.value));
+            }
+            return;
+        }
+        auto rightRegister = right.kind == StackItemKind::REGISTER ? right.reg : X86Register::RCX;
+        emitItemTo(right, rightRegister);
+        if (isMultiply) {
+            assembler.multiply(left, rightRegister);
+        } else {
+            assembler.alu(operation, left, rightRegister);
+        }
+    };
+    // 64位整数的加减乘和位运算直接在虚拟栈的寄存器上进行，两个常量之间以及基地址加减常量时在编译时求值
+    auto emitInteger = [&](X86AluOperation operation, bool isMultiply, std::uint64_t (*fold)(std::uint64_t, std::uint64_t)) {
+        auto right = popRightOperand();
+        ensureItems(1);
+        auto &left = virtualStack.back();
+        if (left.kind == StackItemKind::CONSTANT && right.kind == StackItemKind::CONSTANT) {
+            left.value = fold(left.value, right.value);
+            return;
+        }
+        if (!isMultiply && operation == X86AluOperation::ADD && left.kind == StackItemKind::CONSTANT && right.kind == StackItemKind::FRAME_ADDRESS
+            && fitsInt32(left.value + right.value)) {
+            left = {StackItemKind::FRAME_ADDRESS, left.value + right.value, X86Register::RAX};
+            return;
+        }
+        if (!isMultiply && (operation == X86AluOperation::ADD || operation == X86AluOperation::SUB) && left.kind == StackItemKind::FRAME_ADDRESS
+            && right.kind == StackItemKind::CONSTANT) {
+            auto value = fold(left.value, right.value);
+            if (fitsInt32(value)) {
+                left.value = value;
+                return;
+            }
+        }
+        auto leftRegister = popToAnyRegister();
+        emitWithRightOperand(right, leftRegister, operation, isMultiply);
+        pushRegister(leftRegister);
+    };
+    auto emitIntegerCompare = [&](X86Condition condition) {
+        auto right = popRightOperand();
+        auto leftRegister = popToAnyRegister();
+        emitWithRightOperand(right, leftRegister, X86AluOperation::CMP, false);
+        assembler.setCondition(condition, X86Register::RAX);
+        assembler.zeroExtendAl();
+        assembler.move(leftRegister, X86Register::RAX);
+        pushRegister(leftRegister);
+    };
+    auto emitShift = [&](bool left) {
+        X86Register reg;
+        if (immediateOperand) {
+            reg = popToAnyRegister();
+            if (left) {
+                assembler.shiftLeftImmediate(reg, static_cast<std::uint8_t>(immediate & 63));
+            } else {
+                assembler.shiftRightLogicalImmediate(reg, static_cast<std::uint8_t>(immediate & 63));
+            }
+        } else {
+            popToRegister(X86Register::RCX);
+            reg = popToAnyRegister();
+            if (left) {
+                assembler.shiftLeft(reg);
+            } else {
+                assembler.shiftRightLogical(reg);
+            }
+        }
+        pushRegister(reg);
+    };
+    // 其余二元运算的模板使用固定的寄存器：左值放入rax，右值放入rcx，结果在rax中
+    auto emitBinaryPrologue = [&]() {
+        if (immediateOperand) {
+            popToRegister(X86Register::RAX);
+            assembler.moveImmediate(X86Register::RCX, immediate);
+        } else {
+            popToRegister(X86Register::RCX);
+            popToRegister(X86Register::RAX);
+        }
+    };
+    auto emitFloatingPoint = [&](void (X86Assembler::*operation)()) {
+        emitBinaryPrologue();
+        assembler.moveToXmm(0, X86Register::RAX);
+        assembler.moveToXmm(1, X86Register::RCX);
+        (assembler.*operation)();
+        assembler.moveFromXmm(X86Register::RAX, 0);
+        pushResult();
+    };
+    auto emitFloatingPointCompare = [&](bool swap, X86Condition condition) {
+        emitBinaryPrologue();
+        assembler.moveToXmm(0, X86Register::RAX);
+        assembler.moveToXmm(1, X86Register::RCX);
+        if (swap) {
+            assembler.compareDouble(1, 0);
+        } else {
+            assembler.compareDouble(0, 1);
+        }
+        assembler.setCondition(condition, X86Register::RAX);
+        if (condition == X86Condition::E) {
+            // 任一操作数为NaN时ucomisd置ZF，需要同时检查PF
+            assembler.setCondition(X86Condition::NP, X86Register::RCX);
+            assembler.andAlCl();
+        }
+        assembler.zeroExtendAl();
+        pushResult();
+    };
+    auto emitDivide = [&](bool isSigned, X86Register result) {
+        emitBinaryPrologue();
+        if (isSigned) {
+            assembler.signExtendRaxToRdx();
+            assembler.signedDivide(X86Register::RCX);
+        } else {
+            assembler.alu(X86AluOperation::XOR, X86Register::RDX, X86Register::RDX);
+            assembler.unsignedDivide(X86Register::RCX);
+        }
+        if (result != X86Register::RAX) {
+            assembler.move(X86Register::RAX, result);
+        }
+        pushResult();
+    };
+    // 32位整数运算的结果只保留低32位，有符号的结果符号扩展到rax，无符号的结果零扩展到rax
+    auto emitNarrow = [&](bool isSigned) {
+        if (isSigned) {
+            assembler.signExtendEaxToRax();
+        } else {
+            assembler.zeroExtendEax();
+        }
+    };
+    auto emitAlu32 = [&](X86AluOperation operation, bool isSigned) {
+        emitBinaryPrologue();
+        assembler.alu(operation, X86Register::RAX, X86Register::RCX);
+        emitNarrow(isSigned);
+        pushResult();
+    };
+    auto emitMultiply32 = [&](bool isSigned) {
+        emitBinaryPrologue();
+        assembler.multiply(X86Register::RAX, X86Register::RCX);
+        emitNarrow(isSigned);
+        pushResult();
+    };
+    auto emitDivide32 = [&](bool isSigned, X86Register result) {
+        emitBinaryPrologue();
+        if (isSigned) {
+            // 符号扩展后按64位相除，INT_MIN / -1不会溢出，截断后商回绕为INT_MIN，余数为0
+            assembler.signExtendEaxToRax();
+            assembler.signExtendEcxToRcx();
+            assembler.signExtendRaxToRdx();
+            assembler.signedDivide(X86Register::RCX);
+        } else {
+            assembler.alu(X86AluOperation::XOR, X86Register::RDX, X86Register::RDX);
+            assembler.unsignedDivide32(X86Register::RCX);
+        }
+        if (result != X86Register::RAX) {
+            assembler.move(X86Register::RAX, result);
+        }
+        emitNarrow(isSigned);
+        pushResult();
+    };
+    auto emitShift32 = [&](void (X86Assembler::*shift)(X86Register), bool isSigned) {
+        emitBinaryPrologue();
+        (assembler.*shift)(X86Register::RAX);
+        emitNarrow(isSigned);
+        pushResult();
+    };
+    // f32运算先把两个double操作数转换成float，按float计算后再转换回double
+    auto emitFloatingPoint32 = [&](void (X86Assembler::*operation)()) {
+        emitBinaryPrologue();
+        assembler.moveToXmm(0, X86Register::RAX);
+        assembler.moveToXmm(1, X86Register::RCX);
+        assembler.convertDoubleToFloat(0);
+        assembler.convertDoubleToFloat(1);
+        (assembler.*operation)();
+        assembler.convertFloatToDouble(0);
+        assembler.moveFromXmm(X86Register::RAX, 0);
+        pushResult();
+    };
+    // 辅助函数会破坏调用者保存的寄存器，调用前先把虚拟栈写回内存
+    auto emitHelperCall = [&](std::uint64_t (*helper)(std::uint64_t)) {
+        flushVirtualStack();
+        assembler.load(X86Register::RDI, STACK_POINTER, -8);
+        assembler.moveImmediate(X86Register::RAX, reinterpret_cast<std::uint64_t>(helper));
+        assembler.callRegister(X86Register::RAX);
+        assembler.store(STACK_POINTER, -8, X86Register::RAX);
+    };
+    auto emitBinaryHelperCall = [&](std::uint64_t (*helper)(std::uint64_t, std::uint64_t)) {
+        flushVirtualStack();
+        assembler.load(X86Register::RDI, STACK_POINTER, -16);
+        assembler.load(X86Register::RSI, STACK_POINTER, -8);
+        assembler.moveImmediate(X86Register::RAX, reinterpret_cast<std::uint64_t>(helper));
+        assembler.callRegister(X86Register::RAX);
+        assembler.store(STACK_POINTER, -16, X86Register::RAX);
+        assembler.subImmediate(STACK_POINTER, 8);
+    };
+    // 地址是基地址加偏移时以FRAME_BASE为基址寻址，是较小的常量时以DATA_AREA为基址寻址，
+    // 否则在地址所在的寄存器或者reg中加上DATA_AREA，地址所在的寄存器仍归调用者所有
+    auto emitAddressOperand = [&](const StackItem &address, X86Register reg) -> std::pair<X86Register, std::int32_t> {
+        if (address.kind == StackItemKind::FRAME_ADDRESS) {
+            return {FRAME_BASE, static_cast<std::int32_t>(address.value)};
+        }
+        if (address.kind == StackItemKind::CONSTANT && address.value <= static_cast<std::uint64_t>(INT32_MAX)) {
+            return {DATA_AREA, static_cast<std::int32_t>(address.value)};
+        }
+        if (address.kind == StackItemKind::REGISTER) {
+            reg = address.reg;
+        } else {
+            emitItemTo(address, reg);
+        }
+        assembler.alu(X86AluOperation::ADD, reg, DATA_AREA);
+        return {reg, 0};
+    };
+    auto emitLoad = [&](void (X86Assembler::*load)(X86Register, X86Register, std::int32_t)) {
+        auto address = popItem();
+        auto reg = address.kind == StackItemKind::REGISTER ? address.reg : allocateRegister();
+        auto [base, displacement] = emitAddressOperand(address, reg);
+        (assembler.*load)(reg, base, displacement);
+        pushRegister(reg);
+    };
+    auto emitStore = [&](void (X86Assembler::*store)(X86Register, std::int32_t, X86Register)) {
+        auto valueRegister = popToAnyRegister();
+        auto address = popItem();
+        auto [base, displacement] = emitAddressOperand(address, X86Register::RAX);
+        (assembler.*store)(base, displacement, valueRegister);
+        releaseRegister(valueRegister);
+        if (address.kind == StackItemKind::REGISTER) {
+            releaseRegister(address.reg);
+        }
+    };
+    auto emitConditionalJump = [&](X86Condition condition, std::uint64_t target) {
+        auto reg = popToAnyRegister();
+        flushVirtualStack();
+        assembler.alu(X86AluOperation::TEST, reg, reg);
+        releaseRegister(reg);
+        emitJump(assembler.jumpIf(condition), target);
+    };
+    auto emitCompareBranch = [&](X86Condition condition, std::uint64_t target) {
+        auto right = popItem();
+        auto leftRegister = popToAnyRegister();
+        flushVirtualStack();
+        emitWithRightOperand(right, leftRegister, X86AluOperation::CMP, false);
+        releaseRegister(leftRegister);
+        emitJump(assembler.jumpIf(condition), target);
+    };
+    auto emitFloatingPointCompareBranch = [&](bool swap, X86Condition condition, std::uint64_t target) {
+        popToRegister(X86Register::RCX);
+        popToRegister(X86Register::RAX);
+        flushVirtualStack();
+        assembler.moveToXmm(0, X86Register::RAX);
+        assembler.moveToXmm(1, X86Register::RCX);
+        if (swap) {
+            assembler.compareDouble(1, 0);
+        } else {
+            assembler.compareDouble(0, 1);
+        }
+        // 任一操作数为NaN时ucomisd同时置ZF、PF和CF，相等需要排除无序的情况，不相等需要包含无序的情况
+        if (condition == X86Condition::E) {
+            auto unorderedPosition = assembler.jumpIf(X86Condition::P);
+            emitJump(assembler.jumpIf(X86Condition::E), target);
+            jumpTo(unorderedPosition, assembler.size());
+        } else if (condition == X86Condition::NE) {
+            emitJump(assembler.jumpIf(X86Condition::P), target);
+            emitJump(assembler.jumpIf(X86Condition::NE), target);
+        } else {
+            emitJump(assembler.jumpIf(condition), target);
+        }
+    };
+    /*
+     * 调用已经编译的函数时直接在本地代码中压入调用栈帧并用call进入被调用函数的本地代码。
+     * 调用栈已满、本地栈的用量超出限制或者被调用函数还没有编译时退出，由解释器执行这条调用指令。
+     */
+    auto emitCall = [&](std::uint64_t index, std::uint32_t calleeIndex) {
+        assembler.load(X86Register::RAX, STATE, offsetof(JitState, frame));
+        assembler.compareMemory(X86Register::RAX, STATE, offsetof(JitState, lastFrame));
+        exitJumpList.emplace_back(assembler.jumpIf(X86Condition::AE), index);
+        assembler.compareMemory(X86Register::RSP, STATE, offsetof(JitState, nativeStackLimit));
+        exitJumpList.emplace_back(assembler.jumpIf(X86Condition::B), index);
+        assembler.moveImmediate(X86Register::RCX, reinterpret_cast<std::uint64_t>(&functionEntryList[calleeIndex]));
+        assembler.load(X86Register::RCX, X86Register::RCX, 0);
+        assembler.alu(X86AluOperation::TEST, X86Register::RCX, X86Register::RCX);
+        exitJumpList.emplace_back(assembler.jumpIf(X86Condition::E), index);
+        assembler.addImmediate(X86Register::RAX, CALL_FRAME_SIZE);
+        assembler.store(STATE, offsetof(JitState, frame), X86Register::RAX);
+        emitStoreConstant(X86Register::RAX, CALL_FRAME_RETURN_INDEX, index + 1);
+        assembler.store(X86Register::RAX, CALL_FRAME_SAVED_BP, BASE_POINTER);
+        emitStoreConstant(X86Register::RAX, CALL_FRAME_FUNCTION_INDEX, calleeIndex);
+        auto callerFrameSize = static_cast<std::int32_t>(functionTable[functionIndex].frameSize);
+        assembler.addImmediate(BASE_POINTER, callerFrameSize);
+        assembler.addImmediate(FRAME_BASE, callerFrameSize);
+        // 保持被调用函数中rsp按16字节对齐，辅助函数调用依赖这一点
+        assembler.subImmediate(X86Register::RSP, 8);
+        assembler.callRegister(X86Register::RCX);
+        assembler.addImmediate(X86Register::RSP, 8);
+    };
+    auto emitReturn = [&]() {
+        assembler.load(X86Register::RAX, STATE, offsetof(JitState, frame));
+        assembler.load(X86Register::RCX, X86Register::RAX, CALL_FRAME_RETURN_INDEX);
+        assembler.load(BASE_POINTER, X86Register::RAX, CALL_FRAME_SAVED_BP);
+        assembler.subImmediate(X86Register::RAX, CALL_FRAME_SIZE);
+        assembler.store(STATE, offsetof(JitState, frame), X86Register::RAX);
+        assembler.move(FRAME_BASE, DATA_AREA);
+        assembler.alu(X86AluOperation::ADD, FRAME_BASE, BASE_POINTER);
+        assembler.ret();
+    };
+    entryIndexList.push_back(begin);
+    for (std::uint64_t i = begin; i < end; i++) {
+        // 跳转目标和入口处虚拟栈必须为空
+        if (jumpTargetList[i - begin] || entryIndexList.back() == i) {
+            flushVirtualStack();
+        }
+        labelOffsetList[i - begin] = assembler.size();
+        if (jumpTargetList[i - begin] && i != begin) {
+            entryIndexList.push_back(i);
+        }
+        const auto &instruction = instructionList[i];
+        bool exit = false;
+        immediateOperand = isImmediateOperation(instruction.opcode);
+        immediate = instruction.operand;
+        switch (instruction.opcode) {
+            case Opcode::ADD_I64:
+            case Opcode::ADD_I64_IMM:
+            case Opcode::ADD_U64:
+            case Opcode::ADD_U64_IMM:
+                emitInteger(X86AluOperation::ADD, false, [](std::uint64_t left, std::uint64_t right) { return left + right; });
+                break;
+            case Opcode::SUB_I64:
+            case Opcode::SUB_I64_IMM:
+            case Opcode::SUB_U64:
+            case Opcode::SUB_U64_IMM:
+                emitInteger(X86AluOperation::SUB, false, [](std::uint64_t left, std::uint64_t right) { return left - right; });
+                break;
+            case Opcode::AND_64:
+            case Opcode::AND_64_IMM:
+                emitInteger(X86AluOperation::AND, false, [](std::uint64_t left, std::uint64_t right) { return left & right; });
+                break;
+            case Opcode::OR_64:
+            case Opcode::OR_64_IMM:
+                emitInteger(X86AluOperation::OR, false, [](std::uint64_t left, std::uint64_t right) { return left | right; });
+                break;
+            case Opcode::XOR_64:
+            case Opcode::XOR_64_IMM:
+                emitInteger(X86AluOperation::XOR, false, [](std::uint64_t left, std::uint64_t right) { return left ^ right; });
+                break;
+            case Opcode::MUL_I64:
+            case Opcode::MUL_I64_IMM:
+            case Opcode::MUL_U64:
+            case Opcode::MUL_U64_IMM:
+                emitInteger(X86AluOperation::ADD, true, [](std::uint64_t left, std::uint64_t right) { return left * right; });
+                break;
+            case Opcode::DIV_I64:
+            case Opcode::DIV_I64_IMM:
+                emitDivide(true, X86Register::RAX);
+                break;
+            case Opcode::DIV_U64:
+            case Opcode::DIV_U64_IMM:
+                emitDivide(false, X86Register::RAX);
+                break;
+            case Opcode::MOD_I64:
+            case Opcode::MOD_I64_IMM:
+                emitDivide(true, X86Register::RDX);
+                break;
+            case Opcode::MOD_U64:
+            case Opcode::MOD_U64_IMM:
+                emitDivide(false, X86Register::RDX);
+                break;
+            case Opcode::ADD_F64:
+            case Opcode::ADD_F64_IMM:
+                emitFloatingPoint(&X86Assembler::addDouble);
+                break;
+            case Opcode::SUB_F64:
+            case Opcode::SUB_F64_IMM:
+                emitFloatingPoint(&X86Assembler::subDouble);
+                break;
+            case Opcode::MUL_F64:
+            case Opcode::MUL_F64_IMM:
+                emitFloatingPoint(&X86Assembler::multiplyDouble);
+                break;
+            case Opcode::DIV_F64:
+            case Opcode::DIV_F64_IMM:
+                emitFloatingPoint(&X86Assembler::divideDouble);
+                break;
+            case Opcode::NEG_I64: {
+                auto reg = popToAnyRegister();
+                assembler.negate(reg);
+                pushRegister(reg);
+                break;
+            }
+            case Opcode::NEG_F64:
+                popToRegister(X86Register::RAX);
+                assembler.moveImmediate(X86Register::RCX, 0x8000000000000000);
+                assembler.alu(X86AluOperation::XOR, X86Register::RAX, X86Register::RCX);
+                pushResult();
+                break;
+            case Opcode::ADD_I32:
+            case Opcode::ADD_I32_IMM:
+                emitAlu32(X86AluOperation::ADD, true);
+                break;
+            case Opcode::ADD_U32:
+            case Opcode::ADD_U32_IMM:
+                emitAlu32(X86AluOperation::ADD, false);
+                break;
+            case Opcode::SUB_I32:
+            case Opcode::SUB_I32_IMM:
+                emitAlu32(X86AluOperation::SUB, true);
+                break;
+            case Opcode::SUB_U32:
+            case Opcode::SUB_U32_IMM:
+                emitAlu32(X86AluOperation::SUB, false);
+                break;
+            case Opcode::MUL_I32:
+            case Opcode::MUL_I32_IMM:
+                emitMultiply32(true);
+                break;
+            case Opcode::MUL_U32:
+            case Opcode::MUL_U32_IMM:
+                emitMultiply32(false);
+                break;
+            case Opcode::DIV_I32:
+            case Opcode::DIV_I32_IMM:
+                emitDivide32(true, X86Register::RAX);
+                break;
+            case Opcode::DIV_U32:
+            case Opcode::DIV_U32_IMM:
+                emitDivide32(false, X86Register::RAX);
+                break;
+            case Opcode::MOD_I32:
+            case Opcode::MOD_I32_IMM:
+                emitDivide32(true, X86Register::RDX);
+                break;
+            case Opcode::MOD_U32:
+            case Opcode::MOD_U32_IMM:
+                emitDivide32(false, X86Register::RDX);
+                break;
+            case Opcode::SL_I32:
+            case Opcode::SL_I32_IMM:
+                emitShift32(&X86Assembler::shiftLeft32, true);
+                break;
+            case Opcode::SL_U32:
+            case Opcode::SL_U32_IMM:
+                emitShift32(&X86Assembler::shiftLeft32, false);
+                break;
+            case Opcode::SR_I32:
+            case Opcode::SR_I32_IMM:
+                emitShift32(&X86Assembler::shiftRightArithmetic32, true);
+                break;
+            case Opcode::SR_U32:
+            case Opcode::SR_U32_IMM:
+                emitShift32(&X86Assembler::shiftRightLogical32, false);
+                break;
+            case Opcode::ADD_F32:
+            case Opcode::ADD_F32_IMM:
+                emitFloatingPoint32(&X86Assembler::addFloat);
+                break;
+            case Opcode::SUB_F32:
+            case Opcode::SUB_F32_IMM:
+                emitFloatingPoint32(&X86Assembler::subFloat);
+                break;
+            case Opcode::MUL_F32:
+            case Opcode::MUL_F32_IMM:
+                emitFloatingPoint32(&X86Assembler::multiplyFloat);
+                break;
+            case Opcode::DIV_F32:
+            case Opcode::DIV_F32_IMM:
+                emitFloatingPoint32(&X86Assembler::divideFloat);
+                break;
+            case Opcode::NEG_I32:
+                popToRegister(X86Register::RAX);
+                assembler.negate(X86Register::RAX);
+                assembler.signExtendEaxToRax();
+                pushResult();
+                break;
+            case Opcode::NEG_F32:
+                popToRegister(X86Register::RAX);
+                assembler.moveToXmm(0, X86Register::RAX);
+                assembler.convertDoubleToFloat(0);
+                assembler.convertFloatToDouble(0);
+                assembler.moveFromXmm(X86Register::RAX, 0);
+                assembler.moveImmediate(X86Register::RCX, 0x8000000000000000);
+                assembler.alu(X86AluOperation::XOR, X86Register::RAX, X86Register::RCX);
+                pushResult();
+                break;
+            case Opcode::NOT_64: {
+                auto reg = popToAnyRegister();
+                assembler.bitwiseNot(reg);
+                pushRegister(reg);
+                break;
+            }
+            case Opcode::SL_I64:
+            case Opcode::SL_I64_IMM:
+            case Opcode::SL_U64:
+            case Opcode::SL_U64_IMM:
+                emitShift(true);
+                break;
+            case Opcode::SR_I64:
+            case Opcode::SR_I64_IMM:
+            case Opcode::SR_U64:
+            case Opcode::SR_U64_IMM:
+                // 与解释器一致，sr_i64也是逻辑右移
+                emitShift(false);
+                break;
+            case Opcode::TB_64: {
+                auto reg = popToAnyRegister();
+                assembler.alu(X86AluOperation::TEST, reg, reg);
+                assembler.setCondition(X86Condition::NE, X86Register::RAX);
+                assembler.zeroExtendAl();
+                assembler.move(reg, X86Register::RAX);
+                pushRegister(reg);
+                break;
+            }
+            case Opcode::GT_I64:
+            case Opcode::GT_I64_IMM:
+                emitIntegerCompare(X86Condition::G);
+                break;
+            case Opcode::GT_U64:
+            case Opcode::GT_U64_IMM:
+                emitIntegerCompare(X86Condition::A);
+                break;
+            case Opcode::LT_I64:
+            case Opcode::LT_I64_IMM:
+                emitIntegerCompare(X86Condition::L);
+                break;
+            case Opcode::LT_U64:
+            case Opcode::LT_U64_IMM:
+                emitIntegerCompare(X86Condition::B);
+                break;
+            case Opcode::EQ_I64:
+            case Opcode::EQ_I64_IMM:
+            case Opcode::EQ_U64:
+            case Opcode::EQ_U64_IMM:
+                emitIntegerCompare(X86Condition::E);
+                break;
+            case Opcode::GT_F64:
+            case Opcode::GT_F64_IMM:
+                emitFloatingPointCompare(false, X86Condition::A);
+                break;
+            case Opcode::LT_F64:
+            case Opcode::LT_F64_IMM:
+                emitFloatingPointCompare(true, X86Condition::A);
+                break;
+            case Opcode::EQ_F64:
+            case Opcode::EQ_F64_IMM:
+                emitFloatingPointCompare(false, X86Condition::E);
+                break;
+            case Opcode::CAST_I64_U64:
+            case Opcode::CAST_U64_I64:
+                break;
+            case Opcode::CAST_I64_F64:
+                popToRegister(X86Register::RAX);
+                assembler.convertInt64ToDouble();
+                assembler.moveFromXmm(X86Register::RAX, 0);
+                pushResult();
+                break;
+            case Opcode::CAST_F64_I64:
+                popToRegister(X86Register::RAX);
+                assembler.moveToXmm(0, X86Register::RAX);
+                assembler.convertDoubleToInt64();
+                pushResult();
+                break;
+            case Opcode::CAST_U64_F64:
+                emitHelperCall(castU64ToF64);
+                break;
+            case Opcode::CAST_F64_U64:
+                emitHelperCall(castF64ToU64);
+                break;
+            case Opcode::SQRT_F64:
+                emitHelperCall(applyF64<sqrtF64>);
+                break;
+            case Opcode::FABS_F64:
+                emitHelperCall(applyF64<fabsF64>);
+                break;
+            case Opcode::FLOOR_F64:
+                emitHelperCall(applyF64<floorF64>);
+                break;
+            case Opcode::CEIL_F64:
+                emitHelperCall(applyF64<ceilF64>);
+                break;
+            case Opcode::POW_F64:
+                emitBinaryHelperCall(powF64);
+                break;
+            case Opcode::EXP_F64:
+                emitHelperCall(applyF64<expF64>);
+                break;
+            case Opcode::LOG_F64:
+                emitHelperCall(applyF64<logF64>);
+                break;
+            case Opcode::SIN_F64:
+                emitHelperCall(applyF64<sinF64>);
+                break;
+            case Opcode::COS_F64:
+                emitHelperCall(applyF64<cosF64>);
+                break;
+            case Opcode::JMP:
+                if (isJumpFusable(i, begin, end, jumpTargetList)) {
+                    // 目标地址是前一条指令压入的常量，仍在虚拟栈中
+                    popItem();
+                    flushVirtualStack();
+                    emitJump(assembler.jump(), fusedJumpTarget(i));
+                } else {
+                    exit = true;
+                }
+                break;
+            case Opcode::JZ_64:
+            case Opcode::JNZ_64:
+                if (isJumpFusable(i, begin, end, jumpTargetList)) {
+                    popItem();
+                    emitConditionalJump(instruction.opcode == Opcode::JZ_64 ? X86Condition::E : X86Condition::NE, fusedJumpTarget(i));
+                } else {
+                    exit = true;
+                }
+                break;
+            case Opcode::JMP_IMM:
+                flushVirtualStack();
+                emitJump(assembler.jump(), instruction.operand / 10);
+                break;
+            case Opcode::JZ_64_IMM:
+                emitConditionalJump(X86Condition::E, instruction.operand / 10);
+                break;
+            case Opcode::JNZ_64_IMM:
+                emitConditionalJump(X86Condition::NE, instruction.operand / 10);
+                break;
+            case Opcode::BLT_I64:
+                emitCompareBranch(X86Condition::L, instruction.operand / 10);
+                break;
+            case Opcode::BLT_U64:
+                emitCompareBranch(X86Condition::B, instruction.operand / 10);
+                break;
+            case Opcode::BLT_F64:
+                emitFloatingPointCompareBranch(true, X86Condition::A, instruction.operand / 10);
+                break;
+            case Opcode::BGT_I64:
+                emitCompareBranch(X86Condition::G, instruction.operand / 10);
+                break;
+            case Opcode::BGT_U64:
+                emitCompareBranch(X86Condition::A, instruction.operand / 10);
+                break;
+            case Opcode::BGT_F64:
+                emitFloatingPointCompareBranch(false, X86Condition::A, instruction.operand / 10);
+                break;
+            case Opcode::BEQ_I64:
+                emitCompareBranch(X86Condition::E, instruction.operand / 10);
+                break;
+            case Opcode::BEQ_U64:
+                emitCompareBranch(X86Condition::E, instruction.operand / 10);
+                break;
+            case Opcode::BEQ_F64:
+                emitFloatingPointCompareBranch(false, X86Condition::E, instruction.operand / 10);
+                break;
+            case Opcode::BGE_I64:
+                emitCompareBranch(X86Condition::GE, instruction.operand / 10);
+                break;
+            case Opcode::BGE_U64:
+                emitCompareBranch(X86Condition::AE, instruction.operand / 10);
+                break;
+            case Opcode::BGE_F64:
+                emitFloatingPointCompareBranch(true, X86Condition::BE, instruction.operand / 10);
+                break;
+            case Opcode::BLE_I64:
+                emitCompareBranch(X86Condition::LE, instruction.operand / 10);
+                break;
+            case Opcode::BLE_U64:
+                emitCompareBranch(X86Condition::BE, instruction.operand / 10);
+                break;
+            case Opcode::BLE_F64:
+                emitFloatingPointCompareBranch(false, X86Condition::BE, instruction.operand / 10);
+                break;
+            case Opcode::BNE_I64:
+                emitCompareBranch(X86Condition::NE, instruction.operand / 10);
+                break;
+            case Opcode::BNE_U64:
+                emitCompareBranch(X86Condition::NE, instruction.operand / 10);
+                break;
+            case Opcode::BNE_F64:
+                emitFloatingPointCompareBranch(false, X86Condition::NE, instruction.operand / 10);
+                break;
+            case Opcode::LOAD_I8:
+                emitLoad(&X86Assembler::loadSignedByte);
+                break;
+            case Opcode::LOAD_I16:
+                emitLoad(&X86Assembler::loadSignedWord);
+                break;
+            case Opcode::LOAD_I32:
+                emitLoad(&X86Assembler::loadSignedDword);
+                break;
+            case Opcode::LOAD_U8:
+                emitLoad(&X86Assembler::loadUnsignedByte);
+                break;
+            case Opcode::LOAD_U16:
+                emitLoad(&X86Assembler::loadUnsignedWord);
+                break;
+            case Opcode::LOAD_U32:
+                emitLoad(&X86Assembler::loadUnsignedDword);
+                break;
+            case Opcode::LOAD_I64:
+            case Opcode::LOAD_U64:
+            case Opcode::LOAD_F64:
+                emitLoad(&X86Assembler::load);
+                break;
+            case Opcode::LOAD_F32:
+                popToRegister(X86Register::RAX);
+                assembler.alu(X86AluOperation::ADD, X86Register::RAX, DATA_AREA);
+                assembler.loadFloatAsDoubleFromRax();
+                assembler.moveFromXmm(X86Register::RAX, 0);
+                pushResult();
+                break;
+            case Opcode::STORE_I8:
+            case Opcode::STORE_U8:
+                emitStore(&X86Assembler::storeByte);
+                break;
+            case Opcode::STORE_I16:
+            case Opcode::STORE_U16:
+                emitStore(&X86Assembler::storeWord);
+                break;
+            case Opcode::STORE_I32:
+            case Opcode::STORE_U32:
+                emitStore(&X86Assembler::storeDword);
+                break;
+            case Opcode::STORE_I64:
+            case Opcode::STORE_U64:
+            case Opcode::STORE_F64:
+                emitStore(&X86Assembler::store);
+                break;
+            case Opcode::STORE_F32:
+                popToRegister(X86Register::RCX);
+                popToRegister(X86Register::RAX);
+                assembler.alu(X86AluOperation::ADD, X86Register::RAX, DATA_AREA);
+                assembler.moveToXmm(0, X86Register::RCX);
+                assembler.storeDoubleAsFloatToRax();
+                break;
+            case Opcode::PUSH_64:
+                virtualStack.push_back({StackItemKind::CONSTANT, instruction.operand, X86Register::RAX});
+                break;
+            case Opcode::POP_64:
+                if (virtualStack.empty()) {
+                    assembler.subImmediate(STACK_POINTER, 8);
+                } else {
+                    auto item = popItem();
+                    if (item.kind == StackItemKind::REGISTER) {
+                        releaseRegister(item.reg);
+                    }
+                }
+                break;
+            case Opcode::COPY_64: {
+                ensureItems(1);
+                auto item = virtualStack.back();
+                if (item.kind == StackItemKind::REGISTER) {
+                    // 分配寄存器时即使写回了虚拟栈，item.reg中的值也不会被破坏
+                    auto reg = allocateRegister();
+                    if (reg != item.reg) {
+                        assembler.move(reg, item.reg);
+                    }
+                    pushRegister(reg);
+                } else {
+                    virtualStack.push_back(item);
+                }
+                break;
+            }
+            case Opcode::SWAP_64:
+                ensureItems(2);
+                std::swap(virtualStack[virtualStack.size() - 1], virtualStack[virtualStack.size() - 2]);
+                break;
+            case Opcode::FBP:
+                virtualStack.push_back({StackItemKind::FRAME_ADDRESS, 0, X86Register::RAX});
+                break;
+            case Opcode::CALL_IMM:
+                flushVirtualStack();
+                if (fitsInt32(functionTable[functionIndex].frameSize)) {
+                    emitCall(i, instruction.functionIndex);
+                    if (i + 1 < end) {
+                        entryIndexList.push_back(i + 1);
+                    }
+                } else {
+                    exit = true;
+                }
+                break;
+            case Opcode::RET:
+                flushVirtualStack();
+                emitReturn();
+                break;
+            default:
+                // 间接调用、停机、输入输出以及未知的指令交给解释器执行
+                exit = true;
+                break;
+        }
+        if (exit) {
+            flushVirtualStack();
+            emitExit(i);
+            if (i + 1 < end) {
+                entryIndexList.push_back(i + 1);
+            }
+        }
+    }
+    // 执行到函数末尾时交给解释器继续执行
+    flushVirtualStack();
+    emitExit(end);
+    for (auto [position, target] : forwardJumpList) {
+        jumpTo(position, labelOffsetList[target - begin]);
+    }
+    for (auto [position, target] : exitJumpList) {
+        jumpTo(position, assembler.size());
+        emitExit(target);
+    }
+    const auto &code = assembler.getCode();
+    void *memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return {};
+    }
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, code.size());
+        return {};
+    }
+    codeRegionList.push_back({memory, code.size()});
+    auto function = reinterpret_cast<NativeFunction>(memory);
+    std::sort(entryIndexList.begin(), entryIndexList.end());
+    entryIndexList.erase(std::unique(entryIndexList.begin(), entryIndexList.end()), entryIndexList.end());
+    for (auto entryIndex : entryIndexList) {
+        nativeEntryList[entryIndex] = {function, static_cast<std::uint8_t *>(memory) + labelOffsetList[entryIndex - begin]};
+    }
+    functionEntryList[functionIndex] = nativeEntryList[begin].address;
+    return entryIndexList;
+#else
+    return {};
+#endif
+}
+
+JitExitStatus JitCompiler::enter(std::uint64_t index, JitState *state) {
+    // 本地代码之间的调用使用当前线程的栈，从这里开始最多使用NATIVE_STACK_LIMIT字节
+    state->nativeStackLimit = reinterpret_cast<std::uint64_t>(__builtin_frame_address(0)) - NATIVE_STACK_LIMIT;
+    const auto &nativeEntry = nativeEntryList[index];
+    return static_cast<JitExitStatus>(nativeEntry.function(state, nativeEntry.address));
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "X86Assembler.h"
+#include "../bytecode/Bytecode.h"
+#include "../vm/DecodedInstruction.h"
+
+/*
+ * JIT编译器只支持Linux x86-64，其他平台上-jit选项不起作用。
+ */
+#if defined(__x86_64__) && defined(__linux__)
+#define VM_JIT_SUPPORTED 1
+#else
+#define VM_JIT_SUPPORTED 0
+#endif
+
+/**
+ * 解释器与本地代码之间共享的虚拟机状态。
+ * 本地代码通过固定的偏移访问各个字段，因此字段顺序不能改变。
+ */
+struct JitState {
+    std::uint64_t *sp; // 栈顶元素的下一个位置，本地代码退出时写回
+    std::uint64_t *operandStackEnd;
+    std::uint8_t *dataArea;
+    std::uint64_t bp; // 本地代码退出时写回
+    std::uint64_t nextIndex; // 本地代码退出时，解释器接下来要执行的指令的索引
+    void *frame; // 当前调用栈帧，本地代码执行调用和返回时直接更新
+    const void *lastFrame; // 调用栈的最后一个栈帧，当前栈帧已经是它时调用交给解释器报告溢出
+    std::uint64_t nativeStackLimit; // 本地代码之间调用时rsp的下限，由enter设置
+};
+
+/**
+ * 本地代码退出的原因。
+ */
+enum class JitExitStatus : std::uint32_t {
+    INTERPRET = 0, // 遇到本地代码不支持的指令，由解释器从nextIndex处继续执行
+    OPERAND_STACK_OVERFLOW = 1, // 操作数栈溢出
+    RETURN = 2, // 最外层的本地函数返回，解释器从nextIndex处继续执行，nextIndex是本地代码的入口时直接重新进入
+};
+
+/**
+ * 模板JIT编译器。
+ * 以函数为单位将栈式指令翻译为x86-64机器码。基本块内的操作数栈是编译时的虚拟栈，常量、基地址偏移和运算结果保存在寄存器中，
+ * 只在跳转目标、跳转、调用、返回和退出处写回内存中的操作数栈，因此本地代码与解释器可以在这些边界上相互切换。
+ * 直接调用已经编译的函数时在本地代码中压入调用栈帧并用call进入被调用函数，返回指令弹出调用栈帧后用ret返回；
+ * 最外层的本地函数返回时退出到解释器，返回地址是本地代码的入口时再重新进入。
+ * 间接调用、停机、输入输出等指令不进行编译，本地代码执行到这些指令时退出，由解释器执行后再从下一条指令重新进入本地代码，
+ * 内置函数也因此总是由解释器执行。
+ * 函数入口和循环的回跳目标是计数点，执行次数达到阈值时编译所在的函数。
+ */
+class JitCompiler {
+private:
+    using NativeFunction = std::uint32_t (*)(JitState *, const void *);
+
+    static constexpr std::uint64_t NATIVE_STACK_LIMIT = 1024 * 1024; // 本地代码之间的调用最多使用的栈空间，超出后调用交给解释器执行
+
+    struct NativeEntry {
+        NativeFunction function = nullptr; // 所在函数的本地代码，入口处为序言
+        const void *address = nullptr; // 指令对应的本地代码地址
+    };
+
+    struct CodeRegion {
+        void *memory;
+        std::uint64_t size;
+    };
+
+    const std::vector<DecodedInstruction> &instructionList;
+    const std::vector<FunctionTableEntry> &functionTable;
+    std::uint64_t threshold;
+    std::vector<std::uint32_t> counterList; // 计数点的执行次数
+    std::vector<bool> compiledList; // 函数编号到该函数是否已经尝试编译的映射
+    std::vector<NativeEntry> nativeEntryList; // 指令索引到本地代码入口的映射
+    std::vector<const void *> functionEntryList; // 函数编号到函数入口的本地代码地址的映射，还没有编译的函数为空，本地代码调用时读取
+    std::vector<CodeRegion> codeRegionList;
+
+private:
+    std::uint32_t functionIndexOf(std::uint64_t index) const;
+    bool isJumpFusable(std::uint64_t index, std::uint64_t begin, std::uint64_t end, const std::vector<bool> &jumpTargetList) const;
+    std::uint64_t fusedJumpTarget(std::uint64_t index) const;
+
+public:
+    JitCompiler(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, std::uint64_t threshold);
+    JitCompiler(const JitCompiler &) = delete;
+    JitCompiler &operator=(const JitCompiler &) = delete;
+    ~JitCompiler();
+
+    /**
+     * 返回所有计数点的指令索引，包括函数入口和循环的回跳目标。
+     */
+    [[nodiscard]] std::vector<std::uint64_t> createCountPointList() const;
+
+    /**
+     * 计数点执行一次，恰好达到阈值时返回true。
+     */
+    bool count(std::uint64_t index);
+
+    /**
+     * 编译index所在的函数，返回解释器可以进入本地代码的指令索引。
+     * 函数已经编译过或编译失败时返回空列表。
+     */
+    std::vector<std::uint64_t> compile(std::uint64_t index);
+
+    /**
+     * 从index处进入本地代码执行，返回退出的原因。
+     */
+    JitExitStatus enter(std::uint64_t index, JitState *state);
+};
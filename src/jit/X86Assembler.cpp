@@ -0,0 +1,512 @@
+#include "X86Assembler.h"
+
+#include <cstring>
+
+void X86Assembler::emitRex(bool w, std::uint8_t reg, std::uint8_t index, std::uint8_t base, bool force) {
+    std::uint8_t rex = 0x40 | (w ? 0x08 : 0) | ((reg >> 3) << 2) | ((index >> 3) << 1) | (base >> 3);
+    if (rex != 0x40 || force) {
+        emitByte(rex);
+    }
+}
+
+void X86Assembler::emitRegisterOperand(std::uint8_t reg, std::uint8_t rm) {
+    emitByte(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+void X86Assembler::emitMemoryOperand(std::uint8_t reg, X86Register base, std::int32_t displacement) {
+    auto baseValue = static_cast<std::uint8_t>(base);
+    std::uint8_t mod;
+    if (displacement == 0 && (baseValue & 7) != 5) {
+        mod = 0;
+    } else if (displacement >= -128 && displacement <= 127) {
+        mod = 1;
+    } else {
+        mod = 2;
+    }
+    emitByte((mod << 6) | ((reg & 7) << 3) | (baseValue & 7));
+    // rsp和r12作为基址寄存器时必须使用SIB字节
+    if ((baseValue & 7) == 4) {
+        emitByte(0x24);
+    }
+    if (mod == 1) {
+        emitByte(static_cast<std::uint8_t>(displacement));
+    } else if (mod == 2) {
+        emitInt32(displacement);
+    }
+}
+
+void X86Assembler::emitByte(std::uint8_t byte) {
+    code.push_back(byte);
+}
+
+void X86Assembler::emitInt32(std::int32_t value) {
+    std::uint8_t bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    code.insert(code.end(), bytes, bytes + sizeof(value));
+}
+
+void X86Assembler::emitInt64(std::int64_t value) {
+    std::uint8_t bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+    code.insert(code.end(), bytes, bytes + sizeof(value));
+}
+
+std::uint64_t X86Assembler::size() const {
+    return code.size();
+}
+
+const std::vector<std::uint8_t> &X86Assembler::getCode() const {
+    return code;
+}
+
+void X86Assembler::patchInt32(std::uint64_t position, std::int32_t value) {
+    std::memcpy(&code[position], &value, sizeof(value));
+}
+
+void X86Assembler::push(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0x50 | (static_cast<std::uint8_t>(reg) & 7));
+}
+
+void X86Assembler::pop(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0x58 | (static_cast<std::uint8_t>(reg) & 7));
+}
+
+void X86Assembler::ret() {
+    emitByte(0xC3);
+}
+
+void X86Assembler::load(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x8B);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::store(X86Register base, std::int32_t displacement, X86Register source) {
+    emitRex(true, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x89);
+    emitMemoryOperand(static_cast<std::uint8_t>(source), base, displacement);
+}
+
+void X86Assembler::storeImmediate(X86Register base, std::int32_t displacement, std::int32_t value) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0xC7);
+    emitMemoryOperand(0, base, displacement);
+    emitInt32(value);
+}
+
+void X86Assembler::loadAddress(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x8D);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::compareMemory(X86Register reg, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(reg), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x3B);
+    emitMemoryOperand(static_cast<std::uint8_t>(reg), base, displacement);
+}
+
+void X86Assembler::move(X86Register destination, X86Register source) {
+    emitRex(true, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(destination), false);
+    emitByte(0x89);
+    emitRegisterOperand(static_cast<std::uint8_t>(source), static_cast<std::uint8_t>(destination));
+}
+
+void X86Assembler::moveImmediate(X86Register destination, std::uint64_t value) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(destination), false);
+    emitByte(0xB8 | (static_cast<std::uint8_t>(destination) & 7));
+    emitInt64(static_cast<std::int64_t>(value));
+}
+
+void X86Assembler::alu(X86AluOperation operation, X86Register destination, X86Register source) {
+    emitRex(true, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(destination), false);
+    emitByte(static_cast<std::uint8_t>(operation));
+    emitRegisterOperand(static_cast<std::uint8_t>(source), static_cast<std::uint8_t>(destination));
+}
+
+void X86Assembler::aluImmediate(X86AluOperation operation, X86Register destination, std::int32_t value) {
+    // “r/m64 op= r64”形式的操作码右移3位恰好是0x81/0x83指令组中对应运算的编号
+    auto extension = static_cast<std::uint8_t>(static_cast<std::uint8_t>(operation) >> 3);
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(destination), false);
+    if (value >= -128 && value <= 127) {
+        emitByte(0x83);
+        emitRegisterOperand(extension, static_cast<std::uint8_t>(destination));
+        emitByte(static_cast<std::uint8_t>(value));
+    } else {
+        emitByte(0x81);
+        emitRegisterOperand(extension, static_cast<std::uint8_t>(destination));
+        emitInt32(value);
+    }
+}
+
+void X86Assembler::addImmediate(X86Register destination, std::int32_t value) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(destination), false);
+    if (value >= -128 && value <= 127) {
+        emitByte(0x83);
+        emitRegisterOperand(0, static_cast<std::uint8_t>(destination));
+        emitByte(static_cast<std::uint8_t>(value));
+    } else {
+        emitByte(0x81);
+        emitRegisterOperand(0, static_cast<std::uint8_t>(destination));
+        emitInt32(value);
+    }
+}
+
+void X86Assembler::subImmediate(X86Register destination, std::int32_t value) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(destination), false);
+    if (value >= -128 && value <= 127) {
+        emitByte(0x83);
+        emitRegisterOperand(5, static_cast<std::uint8_t>(destination));
+        emitByte(static_cast<std::uint8_t>(value));
+    } else {
+        emitByte(0x81);
+        emitRegisterOperand(5, static_cast<std::uint8_t>(destination));
+        emitInt32(value);
+    }
+}
+
+void X86Assembler::multiply(X86Register destination, X86Register source) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(source), false);
+    emitByte(0x0F);
+    emitByte(0xAF);
+    emitRegisterOperand(static_cast<std::uint8_t>(destination), static_cast<std::uint8_t>(source));
+}
+
+void X86Assembler::multiplyImmediate(X86Register destination, std::int32_t value) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(destination), false);
+    emitByte(0x69);
+    emitRegisterOperand(static_cast<std::uint8_t>(destination), static_cast<std::uint8_t>(destination));
+    emitInt32(value);
+}
+
+void X86Assembler::negate(X86Register reg) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xF7);
+    emitRegisterOperand(3, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::bitwiseNot(X86Register reg) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xF7);
+    emitRegisterOperand(2, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::signExtendRaxToRdx() {
+    emitByte(0x48);
+    emitByte(0x99);
+}
+
+void X86Assembler::signedDivide(X86Register divisor) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(divisor), false);
+    emitByte(0xF7);
+    emitRegisterOperand(7, static_cast<std::uint8_t>(divisor));
+}
+
+void X86Assembler::unsignedDivide(X86Register divisor) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(divisor), false);
+    emitByte(0xF7);
+    emitRegisterOperand(6, static_cast<std::uint8_t>(divisor));
+}
+
+void X86Assembler::shiftLeft(X86Register reg) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xD3);
+    emitRegisterOperand(4, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::shiftRightLogical(X86Register reg) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xD3);
+    emitRegisterOperand(5, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::shiftLeftImmediate(X86Register reg, std::uint8_t count) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xC1);
+    emitRegisterOperand(4, static_cast<std::uint8_t>(reg));
+    emitByte(count);
+}
+
+void X86Assembler::shiftRightLogicalImmediate(X86Register reg, std::uint8_t count) {
+    emitRex(true, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xC1);
+    emitRegisterOperand(5, static_cast<std::uint8_t>(reg));
+    emitByte(count);
+}
+
+void X86Assembler::unsignedDivide32(X86Register divisor) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(divisor), false);
+    emitByte(0xF7);
+    emitRegisterOperand(6, static_cast<std::uint8_t>(divisor));
+}
+
+void X86Assembler::shiftLeft32(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xD3);
+    emitRegisterOperand(4, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::shiftRightArithmetic32(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xD3);
+    emitRegisterOperand(7, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::shiftRightLogical32(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xD3);
+    emitRegisterOperand(5, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::signExtendEaxToRax() {
+    emitByte(0x48);
+    emitByte(0x63);
+    emitByte(0xC0);
+}
+
+void X86Assembler::signExtendEcxToRcx() {
+    emitByte(0x48);
+    emitByte(0x63);
+    emitByte(0xC9);
+}
+
+void X86Assembler::zeroExtendEax() {
+    emitByte(0x89);
+    emitByte(0xC0);
+}
+
+void X86Assembler::setCondition(X86Condition condition, X86Register reg) {
+    emitByte(0x0F);
+    emitByte(0x90 | static_cast<std::uint8_t>(condition));
+    emitRegisterOperand(0, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::andAlCl() {
+    emitByte(0x20);
+    emitByte(0xC8);
+}
+
+void X86Assembler::zeroExtendAl() {
+    emitByte(0x0F);
+    emitByte(0xB6);
+    emitByte(0xC0);
+}
+
+void X86Assembler::callRegister(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xFF);
+    emitRegisterOperand(2, static_cast<std::uint8_t>(reg));
+}
+
+std::uint64_t X86Assembler::jump() {
+    emitByte(0xE9);
+    std::uint64_t position = size();
+    emitInt32(0);
+    return position;
+}
+
+std::uint64_t X86Assembler::jumpIf(X86Condition condition) {
+    emitByte(0x0F);
+    emitByte(0x80 | static_cast<std::uint8_t>(condition));
+    std::uint64_t position = size();
+    emitInt32(0);
+    return position;
+}
+
+void X86Assembler::jumpRegister(X86Register reg) {
+    emitRex(false, 0, 0, static_cast<std::uint8_t>(reg), false);
+    emitByte(0xFF);
+    emitRegisterOperand(4, static_cast<std::uint8_t>(reg));
+}
+
+void X86Assembler::loadSignedByte(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x0F);
+    emitByte(0xBE);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::loadSignedWord(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x0F);
+    emitByte(0xBF);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::loadSignedDword(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(true, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x63);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::loadUnsignedByte(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(false, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x0F);
+    emitByte(0xB6);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::loadUnsignedWord(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(false, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x0F);
+    emitByte(0xB7);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::loadUnsignedDword(X86Register destination, X86Register base, std::int32_t displacement) {
+    emitRex(false, static_cast<std::uint8_t>(destination), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x8B);
+    emitMemoryOperand(static_cast<std::uint8_t>(destination), base, displacement);
+}
+
+void X86Assembler::storeByte(X86Register base, std::int32_t displacement, X86Register source) {
+    // 没有REX前缀时寄存器编号4到7表示ah、ch、dh、bh，访问sil、dil时必须加上REX前缀
+    emitRex(false, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(base), static_cast<std::uint8_t>(source) >= 4);
+    emitByte(0x88);
+    emitMemoryOperand(static_cast<std::uint8_t>(source), base, displacement);
+}
+
+void X86Assembler::storeWord(X86Register base, std::int32_t displacement, X86Register source) {
+    emitByte(0x66);
+    emitRex(false, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x89);
+    emitMemoryOperand(static_cast<std::uint8_t>(source), base, displacement);
+}
+
+void X86Assembler::storeDword(X86Register base, std::int32_t displacement, X86Register source) {
+    emitRex(false, static_cast<std::uint8_t>(source), 0, static_cast<std::uint8_t>(base), false);
+    emitByte(0x89);
+    emitMemoryOperand(static_cast<std::uint8_t>(source), base, displacement);
+}
+
+void X86Assembler::loadFloatAsDoubleFromRax() {
+    // cvtss2sd xmm0, dword [rax]
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x5A);
+    emitByte(0x00);
+}
+
+void X86Assembler::storeDoubleAsFloatToRax() {
+    // cvtsd2ss xmm0, xmm0
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x5A);
+    emitByte(0xC0);
+    // movss dword [rax], xmm0
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x11);
+    emitByte(0x00);
+}
+
+void X86Assembler::moveToXmm(std::uint8_t xmm, X86Register source) {
+    emitByte(0x66);
+    emitRex(true, xmm, 0, static_cast<std::uint8_t>(source), false);
+    emitByte(0x0F);
+    emitByte(0x6E);
+    emitRegisterOperand(xmm, static_cast<std::uint8_t>(source));
+}
+
+void X86Assembler::moveFromXmm(X86Register destination, std::uint8_t xmm) {
+    emitByte(0x66);
+    emitRex(true, xmm, 0, static_cast<std::uint8_t>(destination), false);
+    emitByte(0x0F);
+    emitByte(0x7E);
+    emitRegisterOperand(xmm, static_cast<std::uint8_t>(destination));
+}
+
+void X86Assembler::addDouble() {
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x58);
+    emitByte(0xC1);
+}
+
+void X86Assembler::subDouble() {
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x5C);
+    emitByte(0xC1);
+}
+
+void X86Assembler::multiplyDouble() {
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x59);
+    emitByte(0xC1);
+}
+
+void X86Assembler::divideDouble() {
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x5E);
+    emitByte(0xC1);
+}
+
+void X86Assembler::addFloat() {
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x58);
+    emitByte(0xC1);
+}
+
+void X86Assembler::subFloat() {
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x5C);
+    emitByte(0xC1);
+}
+
+void X86Assembler::multiplyFloat() {
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x59);
+    emitByte(0xC1);
+}
+
+void X86Assembler::divideFloat() {
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x5E);
+    emitByte(0xC1);
+}
+
+void X86Assembler::convertDoubleToFloat(std::uint8_t xmm) {
+    emitByte(0xF2);
+    emitByte(0x0F);
+    emitByte(0x5A);
+    emitRegisterOperand(xmm, xmm);
+}
+
+void X86Assembler::convertFloatToDouble(std::uint8_t xmm) {
+    emitByte(0xF3);
+    emitByte(0x0F);
+    emitByte(0x5A);
+    emitRegisterOperand(xmm, xmm);
+}
+
+void X86Assembler::compareDouble(std::uint8_t left, std::uint8_t right) {
+    emitByte(0x66);
+    emitByte(0x0F);
+    emitByte(0x2E);
+    emitRegisterOperand(left, right);
+}
+
+void X86Assembler::convertInt64ToDouble() {
+    emitByte(0xF2);
+    emitByte(0x48);
+    emitByte(0x0F);
+    emitByte(0x2A);
+    emitByte(0xC0);
+}
+
+void X86Assembler::convertDoubleToInt64() {
+    emitByte(0xF2);
+    emitByte(0x48);
+    emitByte(0x0F);
+    emitByte(0x2C);
+    emitByte(0xC0);
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * x86-64的通用寄存器编号。
+ */
+enum class X86Register : std::uint8_t {
+    RAX = 0,
+    RCX,
+    RDX,
+    RBX,
+    RSP,
+    RBP,
+    RSI,
+    RDI,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+};
+
+/**
+ * x86-64的条件码，用于jcc和setcc指令。
+ */
+enum class X86Condition : std::uint8_t {
+    B = 0x2, // 无符号小于
+    AE = 0x3, // 无符号大于等于
+    E = 0x4, // 等于
+    NE = 0x5, // 不等于
+    BE = 0x6, // 无符号小于等于
+    A = 0x7, // 无符号大于
+    P = 0xA, // 有奇偶标志，浮点比较时表示无序
+    NP = 0xB, // 无奇偶标志，浮点比较时表示有序
+    L = 0xC, // 有符号小于
+    GE = 0xD, // 有符号大于等于
+    LE = 0xE, // 有符号小于等于
+    G = 0xF, // 有符号大于
+};
+
+/**
+ * 64位算术逻辑运算指令的操作码，均为“r/m64 op= r64”的形式。
+ */
+enum class X86AluOperation : std::uint8_t {
+    ADD = 0x01,
+    OR = 0x09,
+    AND = 0x21,
+    SUB = 0x29,
+    XOR = 0x31,
+    CMP = 0x39,
+    TEST = 0x85,
+};
+
+/**
+ * 用于JIT编译的x86-64机器码生成器。
+ * 只实现了JIT需要用到的少量指令形式，浮点运算只使用xmm0和xmm1两个寄存器。
+ */
+class X86Assembler {
+private:
+    std::vector<std::uint8_t> code;
+
+    void emitRex(bool w, std::uint8_t reg, std::uint8_t index, std::uint8_t base, bool force);
+    void emitRegisterOperand(std::uint8_t reg, std::uint8_t rm);
+    void emitMemoryOperand(std::uint8_t reg, X86Register base, std::int32_t displacement);
+
+public:
+    void emitByte(std::uint8_t byte);
+    void emitInt32(std::int32_t value);
+    void emitInt64(std::int64_t value);
+    [[nodiscard]] std::uint64_t size() const;
+    [[nodiscard]] const std::vector<std::uint8_t> &getCode() const;
+    void patchInt32(std::uint64_t position, std::int32_t value);
+
+    void push(X86Register reg);
+    void pop(X86Register reg);
+    void ret();
+    void load(X86Register destination, X86Register base, std::int32_t displacement); // mov r64, [base + disp]
+    void store(X86Register base, std::int32_t displacement, X86Register source); // mov [base + disp], r64
+    void storeImmediate(X86Register base, std::int32_t displacement, std::int32_t value); // mov qword [base + disp], imm32
+    void loadAddress(X86Register destination, X86Register base, std::int32_t displacement); // lea r64, [base + disp]
+    void compareMemory(X86Register reg, X86Register base, std::int32_t displacement); // cmp r64, [base + disp]
+    void move(X86Register destination, X86Register source); // mov r64, r64
+    void moveImmediate(X86Register destination, std::uint64_t value); // mov r64, imm64
+    void alu(X86AluOperation operation, X86Register destination, X86Register source);
+    void aluImmediate(X86AluOperation operation, X86Register destination, std::int32_t value); // op r64, imm32，不支持TEST
+    void addImmediate(X86Register destination, std::int32_t value);
+    void subImmediate(X86Register destination, std::int32_t value);
+    void multiply(X86Register destination, X86Register source); // imul r64, r64
+    void multiplyImmediate(X86Register destination, std::int32_t value); // imul r64, r64, imm32
+    void negate(X86Register reg);
+    void bitwiseNot(X86Register reg);
+    void signExtendRaxToRdx(); // cqo
+    void signedDivide(X86Register divisor); // idiv r64
+    void unsignedDivide(X86Register divisor); // div r64
+    void shiftLeft(X86Register reg); // shl r64, cl
+    void shiftRightLogical(X86Register reg); // shr r64, cl
+    void shiftLeftImmediate(X86Register reg, std::uint8_t count); // shl r64, imm8
+    void shiftRightLogicalImmediate(X86Register reg, std::uint8_t count); // shr r64, imm8
+    void unsignedDivide32(X86Register divisor); // div r32
+    void shiftLeft32(X86Register reg); // shl r32, cl
+    void shiftRightArithmetic32(X86Register reg); // sar r32, cl
+    void shiftRightLogical32(X86Register reg); // shr r32, cl
+    void signExtendEaxToRax(); // movsxd rax, eax
+    void signExtendEcxToRcx(); // movsxd rcx, ecx
+    void zeroExtendEax(); // mov eax, eax
+    void setCondition(X86Condition condition, X86Register reg); // setcc r8，只支持al、cl、dl、bl
+    void andAlCl(); // and al, cl
+    void zeroExtendAl(); // movzx eax, al
+    void callRegister(X86Register reg);
+    std::uint64_t jump(); // jmp rel32，返回rel32在代码中的位置用于回填
+    std::uint64_t jumpIf(X86Condition condition); // jcc rel32，返回rel32在代码中的位置用于回填
+    void jumpRegister(X86Register reg);
+
+    // 按宽度加载并扩展到64位，以及按宽度存储寄存器的低位
+    void loadSignedByte(X86Register destination, X86Register base, std::int32_t displacement); // movsx r64, byte [base + disp]
+    void loadSignedWord(X86Register destination, X86Register base, std::int32_t displacement); // movsx r64, word [base + disp]
+    void loadSignedDword(X86Register destination, X86Register base, std::int32_t displacement); // movsxd r64, dword [base + disp]
+    void loadUnsignedByte(X86Register destination, X86Register base, std::int32_t displacement); // movzx r32, byte [base + disp]
+    void loadUnsignedWord(X86Register destination, X86Register base, std::int32_t displacement); // movzx r32, word [base + disp]
+    void loadUnsignedDword(X86Register destination, X86Register base, std::int32_t displacement); // mov r32, dword [base + disp]
+    void storeByte(X86Register base, std::int32_t displacement, X86Register source); // mov byte [base + disp], r8
+    void storeWord(X86Register base, std::int32_t displacement, X86Register source); // mov word [base + disp], r16
+    void storeDword(X86Register base, std::int32_t displacement, X86Register source); // mov dword [base + disp], r32
+    void loadFloatAsDoubleFromRax(); // 从[rax]加载float并扩展为double，结果放在xmm0中
+    void storeDoubleAsFloatToRax(); // 将xmm0中的double压缩为float后存储到[rax]
+
+    // 浮点运算，左操作数和结果在xmm0中，右操作数在xmm1中
+    void moveToXmm(std::uint8_t xmm, X86Register source); // movq xmm, r64
+    void moveFromXmm(X86Register destination, std::uint8_t xmm); // movq r64, xmm
+    void addDouble();
+    void subDouble();
+    void multiplyDouble();
+    void divideDouble();
+    void addFloat();
+    void subFloat();
+    void multiplyFloat();
+    void divideFloat();
+    void convertDoubleToFloat(std::uint8_t xmm); // cvtsd2ss xmm, xmm
+    void convertFloatToDouble(std::uint8_t xmm); // cvtss2sd xmm, xmm
+    void compareDouble(std::uint8_t left, std::uint8_t right); // ucomisd
+    void convertInt64ToDouble(); // cvtsi2sd xmm0, rax
+    void convertDoubleToInt64(); // cvttsd2si rax, xmm0
+};
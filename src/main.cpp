@@ -1,6 +1,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <filesystem>
 #include "preprocessor/Preprocessor.h"
 #include "lexer/Lexer.h"
 #include "parser/Parser.h"
@@ -8,18 +9,266 @@
 #include "ast/visitor/ErrorCheckVisitor.h"
 #include "ast/visitor/CodeGenerateVisitor.h"
 #include "vm/VirtualMachine.h"
+#include "vm/SuperinstructionFuser.h"
+#include "vm/BatchRunner.h"
 #include "error/ErrorHandler.h"
 #include "address/AddressCalculator.h"
 
 enum class Mode {
     COMPILE,
-    VIRTUAL_MACHINE
+    VIRTUAL_MACHINE,
+    SUPERINSTRUCTION_STATISTICS,
+    CONVERT
 };
 
-void parseCommandLineArguments(int argc, char *argv[], Mode &mode, bool &needRun, bool &needOutputBinaryBytecodeFile, bool &needOutputHumanReadableBytecodeFile, bool &needPrintAst, std::string &inputFilePath, std::string &binaryBytecodeOutputFilePath, std::string &humanReadableBytecodeOutputFilePath) {
+/**
+ * 解析虚拟机相关的选项，编译模式和虚拟机模式共用。
+ * 成功识别选项时返回true并将argIndex移动到下一个选项。
+ */
+bool parseVirtualMachineOption(int argc, char *argv[], int &argIndex, VirtualMachineConfig &virtualMachineConfig, const std::string &usage) {
+    if (std::string(argv[argIndex]) == "-operand-stack-size") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-operand-stack-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        try {
+            virtualMachineConfig.operandStackCapacity = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            virtualMachineConfig.operandStackCapacity = 0;
+        }
+        if (virtualMachineConfig.operandStackCapacity == 0) {
+            std::cout << "Invalid argument for '-operand-stack-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-max-call-depth") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-max-call-depth' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        try {
+            virtualMachineConfig.maxCallDepth = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            virtualMachineConfig.maxCallDepth = 0;
+        }
+        if (virtualMachineConfig.maxCallDepth == 0) {
+            std::cout << "Invalid argument for '-max-call-depth' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-memory-size") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-memory-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        std::uint64_t memorySizeMiB;
+        try {
+            memorySizeMiB = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            memorySizeMiB = 0;
+        }
+        if (memorySizeMiB == 0 || memorySizeMiB > 1024 * 1024) {
+            std::cout << "Invalid argument for '-memory-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        virtualMachineConfig.memorySize = memorySizeMiB * 1024 * 1024;
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-heap-size") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-heap-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        std::uint64_t heapSizeMiB;
+        try {
+            heapSizeMiB = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            heapSizeMiB = 0;
+        }
+        if (heapSizeMiB == 0 || heapSizeMiB > 1024 * 1024) {
+            std::cout << "Invalid argument for '-heap-size' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        virtualMachineConfig.heapSize = heapSizeMiB * 1024 * 1024;
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-heap-stats") {
+        virtualMachineConfig.heapStatistics = true;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-prof-ops") {
+        virtualMachineConfig.opcodeProfile = true;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-engine") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-engine' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        if (std::string(argv[argIndex + 1]) == "stack") {
+            virtualMachineConfig.engine = ExecutionEngine::STACK;
+        } else if (std::string(argv[argIndex + 1]) == "register") {
+            virtualMachineConfig.engine = ExecutionEngine::REGISTER;
+        } else {
+            std::cout << "Invalid argument for '-engine' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-vm-safe") {
+        virtualMachineConfig.variant = InterpreterVariant::SAFE;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-vm-fast") {
+        virtualMachineConfig.variant = InterpreterVariant::FAST;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-no-superinstr") {
+        virtualMachineConfig.superinstructions = false;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-line-buffered") {
+        virtualMachineConfig.lineBufferedOutput = true;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-jit") {
+        virtualMachineConfig.jit = true;
+        argIndex += 1;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-jit-threshold") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-jit-threshold' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        try {
+            virtualMachineConfig.jitThreshold = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            virtualMachineConfig.jitThreshold = 0;
+        }
+        if (virtualMachineConfig.jitThreshold == 0) {
+            std::cout << "Invalid argument for '-jit-threshold' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-fuel") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-fuel' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        try {
+            virtualMachineConfig.fuel = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            virtualMachineConfig.fuel = 0;
+        }
+        if (virtualMachineConfig.fuel == 0) {
+            std::cout << "Invalid argument for '-fuel' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    if (std::string(argv[argIndex]) == "-time-limit") {
+        if (argc == argIndex + 1) {
+            std::cout << "Missing argument for '-time-limit' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        try {
+            virtualMachineConfig.timeLimit = std::stoull(argv[argIndex + 1]);
+        } catch (const std::exception &) {
+            virtualMachineConfig.timeLimit = 0;
+        }
+        if (virtualMachineConfig.timeLimit == 0) {
+            std::cout << "Invalid argument for '-time-limit' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        argIndex += 2;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * 出错时输出错误信息，设置了燃料或执行时间的上限时，在标准错误输出虚拟机停止的原因和消耗的燃料，
+ * 因上限而停止时以2（燃料）或3（执行时间）作为退出码，出错时以1作为退出码。
+ */
+void reportExitStatus(const ExitStatus &exitStatus, const VirtualMachineConfig &virtualMachineConfig) {
+    if (virtualMachineConfig.fuel == 0 && virtualMachineConfig.timeLimit == 0) {
+        if (exitStatus.reason == ExitReason::ERROR) {
+            ErrorHandler::error(exitStatus.errorMessage);
+        }
+        return;
+    }
+    std::string reason;
+    switch (exitStatus.reason) {
+        case ExitReason::HALTED:
+            reason = "halted";
+            break;
+        case ExitReason::FUEL_EXHAUSTED:
+            reason = "fuel exhausted";
+            break;
+        case ExitReason::DEADLINE_EXCEEDED:
+            reason = "deadline exceeded";
+            break;
+        case ExitReason::ERROR:
+            reason = "error";
+            break;
+    }
+    std::cout << std::flush;
+    std::cerr << "[EXIT] reason: " << reason << ", fuel used: " << exitStatus.fuelUsed << std::endl;
+    if (exitStatus.reason == ExitReason::FUEL_EXHAUSTED) {
+        exit(2);
+    }
+    if (exitStatus.reason == ExitReason::DEADLINE_EXCEEDED) {
+        exit(3);
+    }
+    if (exitStatus.reason == ExitReason::ERROR) {
+        ErrorHandler::error(exitStatus.errorMessage);
+    }
+}
+
+void parseCommandLineArguments(int argc, char *argv[], Mode &mode, bool &needRun, bool &needOutputBinaryBytecodeFile, bool &needOutputHumanReadableBytecodeFile, bool &needPrintAst, std::string &inputFilePath, std::string &binaryBytecodeOutputFilePath, std::string &humanReadableBytecodeOutputFilePath, VirtualMachineConfig &virtualMachineConfig, BatchConfig &batchConfig, std::vector<std::string> &statisticsFilePathList, std::uint64_t &statisticsTopCount) {
     std::string usage = "Usage:\n"
                         "   cc -cl <input_file> [options]                        Compile mode, compile source file and performing other operations depending on the options\n"
-                        "   cc -vm <input_file>                                  Virtual machine mode, run binary bytecode file\n"
+                        "   cc -vm <input_file> [vm_options]                     Virtual machine mode, run binary bytecode file\n"
+                        "   cc -vm <input_file> -batch <dir> [-j <n>] [-batch-output <dir>] [vm_options]\n"
+                        "                                                        Batch mode, run binary bytecode file once per file in <dir> on n threads,\n"
+                        "                                                        reading stdin from the file and writing stdout to <file>.out in the output directory,\n"
+                        "                                                        which defaults to <dir>.out, then print a timing summary to stderr, n defaults to the number of hardware threads\n"
+                        "   cc -superinstr-stats <input_file>... [-top <n>]      Report the most frequent opcode sequences over binary bytecode files, defaults to top 20\n"
+                        "   cc -convert <input_file> <output_file>               Convert a binary bytecode file of any older version to the current compact format,\n"
+                        "                                                        repairing the leaking postfix ++/-- sequences of the old compiler\n"
                         "   cc -h                                                Get help, display this information\n"
                         "Options:\n"
                         "                                                        Defaults to run when no option is selected\n"
@@ -27,11 +276,31 @@ void parseCommandLineArguments(int argc, char *argv[], Mode &mode, bool &needRun
                         "   -o <output_file>                                     Output binary bytecode file\n"
                         "   -oh <output_file>                                    Output human-readable bytecode file\n"
                         "   -ast                                                 Print abstract syntax tree\n"
+                        "   [vm_options]                                         Any of the virtual machine options below\n"
+                        "Virtual machine options:\n"
+                        "   -operand-stack-size <n>                              Capacity of the operand stack in 64-bit slots, defaults to 1048576\n"
+                        "   -max-call-depth <n>                                  Maximum depth of the call stack, defaults to 1048576\n"
+                        "   -memory-size <n>                                     Size of guest memory in MiB, reserved up front and committed on first touch, defaults to 64\n"
+                        "   -heap-size <n>                                       Size of the heap used by malloc, free and realloc in MiB, placed after guest memory, defaults to 64\n"
+                        "   -heap-stats                                          Print heap allocation statistics to stderr at exit\n"
+                        "   -prof-ops                                            Count executions and sample the time of each opcode, print a histogram to stderr at exit, implies the stack engine without JIT\n"
+                        "   -engine <stack|register>                             Execution engine, the register engine translates stack bytecode to register code before running, defaults to stack\n"
+                        "   -vm-safe                                             Check operand stack underflow, memory bounds, division by zero and jump targets, implies the stack engine without JIT\n"
+                        "   -vm-fast                                             Run without runtime checks, the default\n"
+                        "   -no-superinstr                                       Do not fuse common instruction sequences into superinstructions when loading\n"
+                        "   -jit                                                 Compile hot functions to native code, Linux x86-64 only, implies the stack engine\n"
+                        "   -jit-threshold <n>                                   Executions of a function entry or loop head before its function is compiled, defaults to 100\n"
+                        "   -fuel <n>                                            Stop after n fuel units, exits with 2, implies the stack engine without JIT; a backward jump costs the instructions it spans and a call the callee's static instruction count\n"
+                        "   -time-limit <ms>                                     Stop after ms milliseconds of execution, exits with 3, implies the stack engine without JIT\n"
+                        "   -line-buffered                                       Flush output at every newline for interactive use, by default output is flushed when the buffer fills, before input and at exit\n"
                         "Examples:\n"
                         "   cc -c main.c                                         Compile source file and run\n"
                         "   cc -c main.c -r                                      Compile source file and run\n"
                         "   cc -c main.c -ast -o main.bin -oh main.txt -r        Compile source file, print abstract syntax tree, output binary bytecode file, output human-readable bytecode file and run\n"
-                        "   cc -vm main.bin                                      Run binary bytecode file\n";
+                        "   cc -vm main.bin                                      Run binary bytecode file\n"
+                        "   cc -vm main.bin -batch tests -j 8                    Run binary bytecode file on every file in tests with 8 threads, writing outputs to tests.out\n"
+                        "   cc -superinstr-stats a.bin b.bin -top 30             Report the 30 most frequent opcode sequences of each length in a.bin and b.bin\n"
+                        "   cc -convert old.bin new.bin                          Rewrite old.bin with fixed-length instructions as new.bin in the compact format\n";
     if (argc < 2) {
         std::cout << "Missing command-line option and argument" << std::endl;
         std::cout << usage << std::endl;
@@ -75,12 +344,17 @@ void parseCommandLineArguments(int argc, char *argv[], Mode &mode, bool &needRun
             } else if (std::string(argv[argIndex]) == "-ast") {
                 needPrintAst = true;
                 argIndex += 1;
+            } else if (parseVirtualMachineOption(argc, argv, argIndex, virtualMachineConfig, usage)) {
+                // 虚拟机选项已在parseVirtualMachineOption中处理
             } else {
                 std::cout << "Unknown command-line option '" + std::string(argv[argIndex]) + "'" << std::endl;
                 std::cout << usage << std::endl;
                 exit(1);
             }
         }
+        if (!needRun && !needOutputBinaryBytecodeFile && !needOutputHumanReadableBytecodeFile && !needPrintAst) {
+            needRun = true;
+        }
     } else if (std::string(argv[1]) == "-vm") {
         mode = Mode::VIRTUAL_MACHINE;
         if (argc < 3) {
@@ -90,6 +364,92 @@ void parseCommandLineArguments(int argc, char *argv[], Mode &mode, bool &needRun
         }
         needRun = true;
         inputFilePath = argv[2];
+        int argIndex = 3;
+        while (argIndex < argc) {
+            if (std::string(argv[argIndex]) == "-batch") {
+                if (argc == argIndex + 1) {
+                    std::cout << "Missing argument for '-batch' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                batchConfig.inputDirectoryPath = argv[argIndex + 1];
+                argIndex += 2;
+            } else if (std::string(argv[argIndex]) == "-batch-output") {
+                if (argc == argIndex + 1) {
+                    std::cout << "Missing argument for '-batch-output' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                batchConfig.outputDirectoryPath = argv[argIndex + 1];
+                argIndex += 2;
+            } else if (std::string(argv[argIndex]) == "-j") {
+                if (argc == argIndex + 1) {
+                    std::cout << "Missing argument for '-j' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                try {
+                    batchConfig.threadCount = std::stoull(argv[argIndex + 1]);
+                } catch (const std::exception &) {
+                    batchConfig.threadCount = 0;
+                }
+                if (batchConfig.threadCount == 0) {
+                    std::cout << "Invalid argument for '-j' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                argIndex += 2;
+            } else if (!parseVirtualMachineOption(argc, argv, argIndex, virtualMachineConfig, usage)) {
+                std::cout << "Unknown command-line option '" + std::string(argv[argIndex]) + "'" << std::endl;
+                std::cout << usage << std::endl;
+                exit(1);
+            }
+        }
+        if (batchConfig.inputDirectoryPath.empty() && (batchConfig.threadCount != 0 || !batchConfig.outputDirectoryPath.empty())) {
+            std::cout << "Options '-j' and '-batch-output' require the '-batch' option" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+    } else if (std::string(argv[1]) == "-superinstr-stats") {
+        mode = Mode::SUPERINSTRUCTION_STATISTICS;
+        int argIndex = 2;
+        while (argIndex < argc) {
+            if (std::string(argv[argIndex]) == "-top") {
+                if (argc == argIndex + 1) {
+                    std::cout << "Missing argument for '-top' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                try {
+                    statisticsTopCount = std::stoull(argv[argIndex + 1]);
+                } catch (const std::exception &) {
+                    statisticsTopCount = 0;
+                }
+                if (statisticsTopCount == 0) {
+                    std::cout << "Invalid argument for '-top' option" << std::endl;
+                    std::cout << usage << std::endl;
+                    exit(1);
+                }
+                argIndex += 2;
+            } else {
+                statisticsFilePathList.emplace_back(argv[argIndex]);
+                argIndex += 1;
+            }
+        }
+        if (statisticsFilePathList.empty()) {
+            std::cout << "Missing command-line option and argument" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+    } else if (std::string(argv[1]) == "-convert") {
+        mode = Mode::CONVERT;
+        if (argc != 4) {
+            std::cout << "Missing command-line option and argument" << std::endl;
+            std::cout << usage << std::endl;
+            exit(1);
+        }
+        inputFilePath = argv[2];
+        binaryBytecodeOutputFilePath = argv[3];
     } else if (std::string(argv[1]) == "-h") {
         std::cout << usage << std::endl;
         exit(0);
@@ -108,7 +468,11 @@ int main(int argc, char *argv[]) {
     std::string inputFilePath;
     std::string binaryBytecodeOutputFilePath;
     std::string humanReadableBytecodeOutputFilePath;
-    parseCommandLineArguments(argc, argv, mode, needRun, needOutputBinaryBytecodeFile, needOutputHumanReadableBytecodeFile, needPrintAst, inputFilePath, binaryBytecodeOutputFilePath, humanReadableBytecodeOutputFilePath);
+    VirtualMachineConfig virtualMachineConfig;
+    BatchConfig batchConfig;
+    std::vector<std::string> statisticsFilePathList;
+    std::uint64_t statisticsTopCount = 20;
+    parseCommandLineArguments(argc, argv, mode, needRun, needOutputBinaryBytecodeFile, needOutputHumanReadableBytecodeFile, needPrintAst, inputFilePath, binaryBytecodeOutputFilePath, humanReadableBytecodeOutputFilePath, virtualMachineConfig, batchConfig, statisticsFilePathList, statisticsTopCount);
     switch (mode) {
         case Mode::COMPILE: {
             std::unique_ptr<std::ifstream> sourceFile = nullptr;
@@ -151,7 +515,7 @@ int main(int argc, char *argv[]) {
                 bytecode->outputToHumanReadableFile(std::move(humanReadableBytecodeFile));
             }
             if (needRun) {
-                VirtualMachine::run(bytecode);
+                reportExitStatus(VirtualMachine::run(bytecode, virtualMachineConfig), virtualMachineConfig);
             }
             delete charLineList;
             delete tokenList;
@@ -163,17 +527,60 @@ int main(int argc, char *argv[]) {
             break;
         }
         case Mode::VIRTUAL_MACHINE: {
+            if (!batchConfig.inputDirectoryPath.empty()) {
+                std::string errorMessage;
+                if (!BatchRunner::run(inputFilePath, batchConfig, virtualMachineConfig, errorMessage)) {
+                    ErrorHandler::error(errorMessage);
+                }
+                break;
+            }
             Bytecode *bytecode = nullptr;
             std::unique_ptr<std::ifstream> bytecodeFile = std::make_unique<std::ifstream>(inputFilePath, std::ios::binary);
             if (bytecodeFile->fail()) {
                 std::cout << "Bytecode file open failure" << std::endl;
                 exit(1);
             }
-            bytecode = Bytecode::build(std::move(bytecodeFile));
-            VirtualMachine::run(bytecode);
+            std::string errorMessage;
+            bytecode = Bytecode::build(std::move(bytecodeFile), errorMessage);
+            if (bytecode == nullptr) {
+                ErrorHandler::error(errorMessage);
+            }
+            reportExitStatus(VirtualMachine::run(bytecode, virtualMachineConfig), virtualMachineConfig);
             delete bytecode;
             break;
         }
+        case Mode::SUPERINSTRUCTION_STATISTICS: {
+            std::string errorMessage;
+            if (!SuperinstructionFuser::printStatistics(statisticsFilePathList, statisticsTopCount, errorMessage)) {
+                ErrorHandler::error(errorMessage);
+            }
+            break;
+        }
+        case Mode::CONVERT: {
+            std::unique_ptr<std::ifstream> bytecodeFile = std::make_unique<std::ifstream>(inputFilePath, std::ios::binary);
+            if (bytecodeFile->fail()) {
+                std::cout << "Bytecode file open failure" << std::endl;
+                exit(1);
+            }
+            std::string errorMessage;
+            std::unique_ptr<Bytecode> bytecode(Bytecode::build(std::move(bytecodeFile), errorMessage));
+            if (bytecode == nullptr) {
+                ErrorHandler::error(errorMessage);
+            }
+            std::unique_ptr<std::ofstream> binaryBytecodeFile = std::make_unique<std::ofstream>(binaryBytecodeOutputFilePath, std::ios::binary);
+            if (binaryBytecodeFile->fail()) {
+                std::cout << "Bytecode file open failure" << std::endl;
+                exit(1);
+            }
+            bytecode->outputToBinaryFile(std::move(binaryBytecodeFile));
+            std::cout << inputFilePath << " (version " << bytecode->getFileVersion() << ", " << std::filesystem::file_size(inputFilePath) << " bytes) -> "
+                      << binaryBytecodeOutputFilePath << " (version " << BYTECODE_FILE_VERSION << ", " << std::filesystem::file_size(binaryBytecodeOutputFilePath) << " bytes)";
+            if (bytecode->getRepairedSequenceCount() != 0) {
+                std::cout << ", " << bytecode->getRepairedSequenceCount() << " leaking postfix sequences repaired";
+            }
+            std::cout << std::endl;
+            break;
+        }
     }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "BatchRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+BatchRunner::BatchRunner(std::shared_ptr<const ProgramImage> image, std::vector<std::string> inputFilePathList, std::string outputDirectoryPath, std::uint64_t threadCount)
+        : image(std::move(image)), inputFilePathList(std::move(inputFilePathList)), outputDirectoryPath(std::move(outputDirectoryPath)) {
+    resultList.resize(this->inputFilePathList.size());
+    for (std::uint64_t i = 0; i < threadCount; i++) {
+        workQueueList.push_back(std::make_unique<WorkQueue>());
+    }
+    // 按顺序轮流分配给各个线程，耗时接近的相邻输入分散到不同的线程
+    for (std::uint64_t i = 0; i < this->inputFilePathList.size(); i++) {
+        workQueueList[i % threadCount]->taskList.push_back(i);
+    }
+}
+
+bool BatchRunner::takeTask(std::uint64_t workerIndex, std::uint64_t &task) {
+    {
+        auto &workQueue = *workQueueList[workerIndex];
+        std::lock_guard<std::mutex> lock(workQueue.mutex);
+        if (!workQueue.taskList.empty()) {
+            task = workQueue.taskList.back();
+            workQueue.taskList.pop_back();
+            return true;
+        }
+    }
+    // 自己的队列为空时从其他线程的队首窃取，任务在开始前已经全部分配，所有队列都为空时即可结束
+    for (std::uint64_t i = 1; i < workQueueList.size(); i++) {
+        auto &workQueue = *workQueueList[(workerIndex + i) % workQueueList.size()];
+        std::lock_guard<std::mutex> lock(workQueue.mutex);
+        if (!workQueue.taskList.empty()) {
+            task = workQueue.taskList.front();
+            workQueue.taskList.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void BatchRunner::work(std::uint64_t workerIndex) {
+    std::uint64_t task;
+    while (takeTask(workerIndex, task)) {
+        execute(task);
+    }
+}
+
+void BatchRunner::execute(std::uint64_t task) {
+    auto &result = resultList[task];
+    std::filesystem::path inputFilePath(inputFilePathList[task]);
+    result.inputFileName = inputFilePath.filename().string();
+    // 保留原来的扩展名，a.txt和a.in分别写入a.txt.out和a.in.out
+    auto outputFilePath = std::filesystem::path(outputDirectoryPath) / (result.inputFileName + ".out");
+    auto begin = std::chrono::steady_clock::now();
+    std::ifstream input(inputFilePath, std::ios::binary);
+    std::ofstream output(outputFilePath, std::ios::binary);
+    if (input.fail() || output.fail()) {
+        result.exitStatus.reason = ExitReason::ERROR;
+        result.exitStatus.errorMessage = input.fail() ? "input file open failure" : "output file open failure: " + outputFilePath.string();
+    } else {
+        VirtualMachine virtualMachine(image, input, output);
+        result.exitStatus = virtualMachine.run();
+        // 与虚拟机模式一样，错误信息写在程序的输出之后
+        if (result.exitStatus.reason == ExitReason::ERROR) {
+            output << "[ERROR] " << result.exitStatus.errorMessage << std::endl;
+        }
+    }
+    result.elapsedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void BatchRunner::printSummary(double loadMilliseconds, double wallMilliseconds) const {
+    std::uint64_t haltedCount = 0;
+    std::uint64_t fuelExhaustedCount = 0;
+    std::uint64_t deadlineExceededCount = 0;
+    std::uint64_t errorCount = 0;
+    double totalMilliseconds = 0;
+    double minMilliseconds = resultList.empty() ? 0 : resultList.front().elapsedMilliseconds;
+    double maxMilliseconds = 0;
+    for (const auto &result : resultList) {
+        switch (result.exitStatus.reason) {
+            case ExitReason::HALTED:
+                haltedCount++;
+                break;
+            case ExitReason::FUEL_EXHAUSTED:
+                fuelExhaustedCount++;
+                std::cerr << "[EXIT] " << result.inputFileName << ": fuel exhausted, fuel used: " << result.exitStatus.fuelUsed << std::endl;
+                break;
+            case ExitReason::DEADLINE_EXCEEDED:
+                deadlineExceededCount++;
+                std::cerr << "[EXIT] " << result.inputFileName << ": deadline exceeded, fuel used: " << result.exitStatus.fuelUsed << std::endl;
+                break;
+            case ExitReason::ERROR:
+                errorCount++;
+                std::cerr << "[ERROR] " << result.inputFileName << ": " << result.exitStatus.errorMessage << std::endl;
+                break;
+        }
+        totalMilliseconds += result.elapsedMilliseconds;
+        minMilliseconds = std::min(minMilliseconds, result.elapsedMilliseconds);
+        maxMilliseconds = std::max(maxMilliseconds, result.elapsedMilliseconds);
+    }
+    double averageMilliseconds = resultList.empty() ? 0 : totalMilliseconds / static_cast<double>(resultList.size());
+    double throughput = wallMilliseconds == 0 ? 0 : static_cast<double>(resultList.size()) * 1000 / wallMilliseconds;
+    std::cerr << std::fixed << std::setprecision(3);
+    std::cerr << "inputs: " << resultList.size() << ", halted: " << haltedCount << ", fuel exhausted: " << fuelExhaustedCount << ", deadline exceeded: " << deadlineExceededCount << ", errors: " << errorCount << std::endl;
+    std::cerr << "threads: " << workQueueList.size() << ", load: " << loadMilliseconds << " ms, wall: " << wallMilliseconds << " ms, throughput: " << throughput << " runs/s" << std::endl;
+    std::cerr << "run time: total " << totalMilliseconds << " ms, min " << minMilliseconds << " ms, average " << averageMilliseconds << " ms, max " << maxMilliseconds << " ms" << std::endl;
+}
+
+bool BatchRunner::run(const std::string &bytecodeFilePath, const BatchConfig &batchConfig, const VirtualMachineConfig &virtualMachineConfig, std::string &errorMessage) {
+    std::error_code errorCode;
+    if (!std::filesystem::is_directory(batchConfig.inputDirectoryPath, errorCode)) {
+        errorMessage = "batch input directory not found: " + batchConfig.inputDirectoryPath;
+        return false;
+    }
+    std::vector<std::string> inputFilePathList;
+    for (const auto &entry : std::filesystem::directory_iterator(batchConfig.inputDirectoryPath, errorCode)) {
+        if (entry.is_regular_file()) {
+            inputFilePathList.push_back(entry.path().string());
+        }
+    }
+    std::sort(inputFilePathList.begin(), inputFilePathList.end());
+    auto outputDirectoryPath = batchConfig.outputDirectoryPath;
+    if (outputDirectoryPath.empty()) {
+        outputDirectoryPath = std::filesystem::path(batchConfig.inputDirectoryPath).lexically_normal().string();
+        if (!outputDirectoryPath.empty() && outputDirectoryPath.back() == '/') {
+            outputDirectoryPath.pop_back();
+        }
+        outputDirectoryPath += ".out";
+    }
+    std::filesystem::create_directories(outputDirectoryPath, errorCode);
+    if (!std::filesystem::is_directory(outputDirectoryPath, errorCode)) {
+        errorMessage = "batch output directory creation failure: " + outputDirectoryPath;
+        return false;
+    }
+    auto threadCount = batchConfig.threadCount != 0 ? batchConfig.threadCount : std::max<std::uint64_t>(std::thread::hardware_concurrency(), 1);
+    threadCount = std::max<std::uint64_t>(std::min<std::uint64_t>(threadCount, inputFilePathList.size()), 1);
+
+    auto loadBegin = std::chrono::steady_clock::now();
+    std::unique_ptr<std::ifstream> bytecodeFile = std::make_unique<std::ifstream>(bytecodeFilePath, std::ios::binary);
+    if (bytecodeFile->fail()) {
+        errorMessage = "bytecode file open failure: " + bytecodeFilePath;
+        return false;
+    }
+    std::shared_ptr<const Bytecode> bytecode(Bytecode::build(std::move(bytecodeFile), errorMessage));
+    if (bytecode == nullptr) {
+        return false;
+    }
+    auto image = ProgramImage::load(bytecode, virtualMachineConfig);
+    if (!image->getErrorMessage().empty()) {
+        errorMessage = image->getErrorMessage();
+        return false;
+    }
+    auto loadMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadBegin).count();
+
+    BatchRunner batchRunner(image, std::move(inputFilePathList), outputDirectoryPath, threadCount);
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threadList;
+    for (std::uint64_t i = 0; i < threadCount; i++) {
+        threadList.emplace_back(&BatchRunner::work, &batchRunner, i);
+    }
+    for (auto &thread : threadList) {
+        thread.join();
+    }
+    auto wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    batchRunner.printSummary(loadMilliseconds, wallMilliseconds);
+    return true;
+}
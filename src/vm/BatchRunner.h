@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "VirtualMachine.h"
+
+/**
+ * 批量执行的参数。
+ */
+struct BatchConfig {
+    std::string inputDirectoryPath; // 输入文件所在的目录，目录中的每个普通文件对应一次执行
+    std::string outputDirectoryPath; // 输出文件所在的目录，为空时使用输入目录的路径加上.out
+    std::uint64_t threadCount = 0; // 工作线程数，为0时使用硬件线程数
+};
+
+/**
+ * 批量执行器。
+ * 只加载一次字节码，对输入目录中的每个文件执行一次程序，标准输入从该文件读取，标准输出写入输出目录中在原文件名后加上.out的文件。
+ * 执行由固定数量的工作线程完成，每个线程有自己的任务队列，从队尾取任务，自己的队列为空时从其他线程的队首窃取任务，
+ * 因此少数耗时很长的输入不会让其他线程空闲。所有执行结束后向标准错误输出汇总的耗时统计。
+ */
+class BatchRunner {
+private:
+    /**
+     * 一次执行的结果。
+     */
+    struct BatchResult {
+        std::string inputFileName;
+        ExitStatus exitStatus;
+        double elapsedMilliseconds = 0;
+    };
+
+    /**
+     * 工作线程的任务队列，任务为输入文件的编号。
+     */
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::uint64_t> taskList;
+    };
+
+    std::shared_ptr<const ProgramImage> image;
+    std::vector<std::string> inputFilePathList;
+    std::string outputDirectoryPath;
+    std::vector<std::unique_ptr<WorkQueue>> workQueueList;
+    std::vector<BatchResult> resultList;
+
+private:
+    BatchRunner(std::shared_ptr<const ProgramImage> image, std::vector<std::string> inputFilePathList, std::string outputDirectoryPath, std::uint64_t threadCount);
+    bool takeTask(std::uint64_t workerIndex, std::uint64_t &task);
+    void work(std::uint64_t workerIndex);
+    void execute(std::uint64_t task);
+    void printSummary(double loadMilliseconds, double wallMilliseconds) const;
+
+public:
+    /**
+     * 加载bytecodeFilePath中的字节码，按照batchConfig对输入目录中的每个文件执行一次并输出汇总统计。
+     * 目录或字节码文件无法使用、加载失败时不执行任何输入，返回false并将错误信息写入errorMessage。
+     */
+    static bool run(const std::string &bytecodeFilePath, const BatchConfig &batchConfig, const VirtualMachineConfig &virtualMachineConfig, std::string &errorMessage);
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include "../instruction/Instruction.h"
+
+/*
+ * 指令分派方式。
+ * GCC和Clang支持标签地址（labels as values）扩展，使用计算跳转（computed goto）进行分派：
+ * 每条指令处理完毕后直接跳转到下一条指令的处理代码，省去了switch的范围检查和跳转表查找，
+ * 同时每个处理代码都有独立的间接跳转指令，分支预测更准确。
+ * 其他编译器退化为普通的switch分派，也可以通过预先定义VM_COMPUTED_GOTO为0来强制使用switch分派。
+ */
+#ifndef VM_COMPUTED_GOTO
+#if defined(__GNUC__) || defined(__clang__)
+#define VM_COMPUTED_GOTO 1
+#else
+#define VM_COMPUTED_GOTO 0
+#endif
+#endif
+
+inline constexpr std::uint32_t INVALID_FUNCTION_INDEX = UINT32_MAX; // 不是函数入口的指令对应的函数编号
+
+/**
+ * 预解码后的指令。
+ * 加载程序映像时将代码区中的每条10字节指令解码为该结构，运行时不再需要从字节数组中拷贝操作码和操作数。
+ * 预解码后的指令与代码区中的指令一一对应，因此指令地址除以10即为指令在预解码数组中的索引。
+ */
+struct DecodedInstruction {
+    const void *handler = nullptr; // 指令处理代码的地址，仅在使用计算跳转（computed goto）分派时有效
+    std::uint64_t operand = 0;
+    union {
+        std::uint32_t functionIndex = 0; // call_imm指令的目标函数的编号
+        std::uint32_t fuelCost; // 跳转指令往后跳转时消耗的燃料，往前跳转时为0
+    };
+    Opcode opcode = Opcode::HLT;
+};
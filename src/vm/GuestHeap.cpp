@@ -0,0 +1,309 @@
+#include "GuestHeap.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+std::uint32_t GuestHeap::sizeClassOf(std::uint64_t size) {
+    if (size <= 128) {
+        return size == 0 ? 0 : static_cast<std::uint32_t>((size + 15) / 16 - 1);
+    }
+    // 129到SMALL_SIZE_LIMIT之间，每翻一倍的范围等分为4级
+    std::uint64_t value = size - 1;
+    auto width = static_cast<std::uint64_t>(std::bit_width(value));
+    std::uint64_t base = std::uint64_t(1) << (width - 1);
+    return static_cast<std::uint32_t>(8 + (width - 8) * 4 + (value - base) / (base / 4));
+}
+
+std::uint64_t GuestHeap::sizeOfClass(std::uint32_t sizeClass) {
+    if (sizeClass < 8) {
+        return 16 * (sizeClass + 1);
+    }
+    std::uint64_t base = std::uint64_t(128) << ((sizeClass - 8) / 4);
+    return base + base / 4 * ((sizeClass - 8) % 4 + 1);
+}
+
+void GuestHeap::initialize(std::uint64_t begin, std::uint64_t size) {
+    heapBegin = begin;
+    heapPageCount = size / PAGE_SIZE;
+}
+
+void GuestHeap::markSpan(std::uint64_t begin, std::uint64_t pageCount, PageState state, std::uint32_t run) {
+    for (std::uint64_t i = begin; i < begin + pageCount; i++) {
+        pageList[i] = {static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(pageCount), run, state};
+    }
+}
+
+bool GuestHeap::allocatePages(std::uint64_t pageCount, std::uint64_t &begin) {
+    // 最佳适配：页数不少于pageCount的最小的空闲span，多余的页仍然空闲
+    auto iterator = freeSpanSet.lower_bound({pageCount, 0});
+    if (iterator != freeSpanSet.end()) {
+        auto [spanPageCount, spanBegin] = *iterator;
+        freeSpanSet.erase(iterator);
+        if (spanPageCount > pageCount) {
+            markSpan(spanBegin + pageCount, spanPageCount - pageCount, PageState::FREE, NO_RUN);
+            freeSpanSet.insert({spanPageCount - pageCount, spanBegin + pageCount});
+        }
+        begin = spanBegin;
+        return true;
+    }
+    if (pageCount > heapPageCount - pageList.size()) {
+        return false;
+    }
+    begin = pageList.size();
+    pageList.resize(begin + pageCount);
+    statistics.peakHeapBytes = std::max(statistics.peakHeapBytes, pageList.size() * PAGE_SIZE);
+    return true;
+}
+
+void GuestHeap::freePages(std::uint64_t begin, std::uint64_t pageCount) {
+    // 与前后相邻的空闲span合并，合并后位于堆顶时直接降低堆顶
+    if (begin > 0 && pageList[begin - 1].state == PageState::FREE) {
+        std::uint64_t previousBegin = pageList[begin - 1].spanBegin;
+        std::uint64_t previousPageCount = pageList[begin - 1].spanPageCount;
+        freeSpanSet.erase({previousPageCount, previousBegin});
+        begin = previousBegin;
+        pageCount += previousPageCount;
+    }
+    std::uint64_t end = begin + pageCount;
+    if (end < pageList.size() && pageList[end].state == PageState::FREE) {
+        std::uint64_t nextPageCount = pageList[end].spanPageCount;
+        freeSpanSet.erase({nextPageCount, end});
+        pageCount += nextPageCount;
+    }
+    if (begin + pageCount == pageList.size()) {
+        pageList.resize(begin);
+        return;
+    }
+    markSpan(begin, pageCount, PageState::FREE, NO_RUN);
+    freeSpanSet.insert({pageCount, begin});
+}
+
+bool GuestHeap::growInPlace(std::uint64_t begin, std::uint64_t pageCount, std::uint64_t newPageCount) {
+    std::uint64_t end = begin + pageCount;
+    std::uint64_t extraPageCount = newPageCount - pageCount;
+    if (end == pageList.size()) {
+        if (extraPageCount > heapPageCount - pageList.size()) {
+            return false;
+        }
+        pageList.resize(begin + newPageCount);
+        statistics.peakHeapBytes = std::max(statistics.peakHeapBytes, pageList.size() * PAGE_SIZE);
+        return true;
+    }
+    if (pageList[end].state != PageState::FREE || pageList[end].spanPageCount < extraPageCount) {
+        return false;
+    }
+    std::uint64_t nextPageCount = pageList[end].spanPageCount;
+    freeSpanSet.erase({nextPageCount, end});
+    if (nextPageCount > extraPageCount) {
+        markSpan(end + extraPageCount, nextPageCount - extraPageCount, PageState::FREE, NO_RUN);
+        freeSpanSet.insert({nextPageCount - extraPageCount, end + extraPageCount});
+    }
+    return true;
+}
+
+std::uint64_t GuestHeap::allocateSmall(std::uint32_t sizeClass) {
+    if (sizeClassList == nullptr) {
+        sizeClassList = std::make_unique<SizeClass[]>(SIZE_CLASS_COUNT);
+    }
+    auto &state = sizeClassList[sizeClass];
+    auto &classStatistics = statistics.sizeClassList[sizeClass];
+    std::uint64_t size = sizeOfClass(sizeClass);
+    std::uint32_t runIndex;
+    std::uint64_t address;
+    if (!state.partialRunList.empty()) {
+        // 优先重用已有run中释放的块，空闲链表取空后run离开partialRunList
+        runIndex = state.partialRunList.back();
+        auto &run = runList[runIndex];
+        address = run.freeList.back();
+        run.freeList.pop_back();
+        if (run.freeList.empty()) {
+            state.partialRunList.pop_back();
+            run.partialIndex = NO_RUN;
+        }
+    } else {
+        if (state.next + size > state.end) {
+            std::uint64_t begin;
+            if (!allocatePages(RUN_SIZE / PAGE_SIZE, begin)) {
+                return 0;
+            }
+            Run run{heapBegin + begin * PAGE_SIZE, sizeClass, 0, NO_RUN, std::vector<std::uint64_t>((RUN_SIZE / size + 63) / 64, 0), {}};
+            if (freeRunList.empty()) {
+                state.run = static_cast<std::uint32_t>(runList.size());
+                runList.push_back(std::move(run));
+            } else {
+                state.run = freeRunList.back();
+                freeRunList.pop_back();
+                runList[state.run] = std::move(run);
+            }
+            markSpan(begin, RUN_SIZE / PAGE_SIZE, PageState::SMALL, state.run);
+            state.next = runList[state.run].address;
+            state.end = state.next + RUN_SIZE / size * size;
+            classStatistics.reservedBytes += RUN_SIZE;
+            classStatistics.peakReservedBytes = std::max(classStatistics.peakReservedBytes, classStatistics.reservedBytes);
+        }
+        runIndex = state.run;
+        address = state.next;
+        state.next += size;
+    }
+    auto &run = runList[runIndex];
+    std::uint64_t index = (address - run.address) / size;
+    run.allocatedBitList[index / 64] |= std::uint64_t(1) << (index % 64);
+    run.liveCount++;
+    classStatistics.liveBytes += size;
+    classStatistics.peakLiveBytes = std::max(classStatistics.peakLiveBytes, classStatistics.liveBytes);
+    return address;
+}
+
+void GuestHeap::releaseSmall(std::uint32_t runIndex, std::uint64_t address) {
+    auto &run = runList[runIndex];
+    auto &state = sizeClassList[run.sizeClass];
+    auto &classStatistics = statistics.sizeClassList[run.sizeClass];
+    std::uint64_t size = sizeOfClass(run.sizeClass);
+    std::uint64_t index = (address - run.address) / size;
+    run.allocatedBitList[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    run.liveCount--;
+    classStatistics.liveBytes -= size;
+    if (run.liveCount == 0 && runIndex != state.run) {
+        // 块全部释放后归还run的页，先将run从partialRunList中交换删除
+        if (run.partialIndex != NO_RUN) {
+            std::uint32_t last = state.partialRunList.back();
+            state.partialRunList[run.partialIndex] = last;
+            runList[last].partialIndex = run.partialIndex;
+            state.partialRunList.pop_back();
+        }
+        freePages((run.address - heapBegin) / PAGE_SIZE, RUN_SIZE / PAGE_SIZE);
+        run.allocatedBitList = {};
+        run.freeList = {};
+        freeRunList.push_back(runIndex);
+        classStatistics.reservedBytes -= RUN_SIZE;
+        return;
+    }
+    if (run.partialIndex == NO_RUN) {
+        run.partialIndex = static_cast<std::uint32_t>(state.partialRunList.size());
+        state.partialRunList.push_back(runIndex);
+    }
+    run.freeList.push_back(address);
+}
+
+std::uint64_t GuestHeap::blockSize(std::uint64_t address) const {
+    if (address < heapBegin || (address - heapBegin) / PAGE_SIZE >= pageList.size()) {
+        return 0;
+    }
+    std::uint64_t offset = address - heapBegin;
+    const auto &page = pageList[offset / PAGE_SIZE];
+    switch (page.state) {
+        case PageState::FREE:
+            return 0;
+        case PageState::SMALL: {
+            const auto &run = runList[page.run];
+            std::uint64_t size = sizeOfClass(run.sizeClass);
+            std::uint64_t index = (address - run.address) / size;
+            if ((address - run.address) % size != 0 || index >= RUN_SIZE / size) {
+                return 0;
+            }
+            return (run.allocatedBitList[index / 64] >> (index % 64) & 1) != 0 ? size : 0;
+        }
+        case PageState::LARGE:
+            if (offset % PAGE_SIZE != 0 || offset / PAGE_SIZE != page.spanBegin) {
+                return 0;
+            }
+            return page.spanPageCount * PAGE_SIZE;
+    }
+    return 0;
+}
+
+void GuestHeap::recordAllocation(std::uint64_t size) {
+    statistics.allocationCount++;
+    statistics.liveBytes += size;
+    statistics.peakLiveBytes = std::max(statistics.peakLiveBytes, statistics.liveBytes);
+}
+
+void GuestHeap::recordFree(std::uint64_t size) {
+    statistics.freeCount++;
+    statistics.liveBytes -= size;
+}
+
+std::uint64_t GuestHeap::allocate(std::uint64_t size) {
+    std::uint64_t address = 0;
+    if (size <= SMALL_SIZE_LIMIT) {
+        address = allocateSmall(sizeClassOf(size));
+        if (address != 0) {
+            recordAllocation(sizeOfClass(sizeClassOf(size)));
+        }
+    } else if (size <= heapPageCount * PAGE_SIZE) {
+        std::uint64_t pageCount = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+        std::uint64_t begin;
+        if (allocatePages(pageCount, begin)) {
+            markSpan(begin, pageCount, PageState::LARGE, NO_RUN);
+            recordAllocation(pageCount * PAGE_SIZE);
+            address = heapBegin + begin * PAGE_SIZE;
+        }
+    }
+    if (address == 0) {
+        statistics.failedCount++;
+    }
+    return address;
+}
+
+bool GuestHeap::release(std::uint64_t address) {
+    if (address == 0) {
+        return true;
+    }
+    std::uint64_t size = blockSize(address);
+    if (size == 0) {
+        return false;
+    }
+    Page page = pageList[(address - heapBegin) / PAGE_SIZE];
+    if (page.state == PageState::SMALL) {
+        releaseSmall(page.run, address);
+    } else {
+        freePages(page.spanBegin, page.spanPageCount);
+    }
+    recordFree(size);
+    return true;
+}
+
+bool GuestHeap::reallocate(std::uint64_t address, std::uint64_t size, std::uint8_t *memory, std::uint64_t &result) {
+    if (address == 0) {
+        result = allocate(size);
+        return true;
+    }
+    std::uint64_t oldSize = blockSize(address);
+    if (oldSize == 0) {
+        return false;
+    }
+    if (size == 0) {
+        release(address);
+        result = 0;
+        return true;
+    }
+    // 小块放得下时留在原地，大块在原地缩小或者向后面的空闲页扩展，都不需要移动内容
+    Page page = pageList[(address - heapBegin) / PAGE_SIZE];
+    if (page.state == PageState::SMALL && size <= oldSize) {
+        result = address;
+        return true;
+    }
+    if (page.state == PageState::LARGE && size > SMALL_SIZE_LIMIT && size <= heapPageCount * PAGE_SIZE) {
+        std::uint64_t pageCount = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+        if (pageCount <= page.spanPageCount || growInPlace(page.spanBegin, page.spanPageCount, pageCount)) {
+            markSpan(page.spanBegin, pageCount, PageState::LARGE, NO_RUN);
+            if (pageCount < page.spanPageCount) {
+                freePages(page.spanBegin + pageCount, page.spanPageCount - pageCount);
+            }
+            statistics.liveBytes = statistics.liveBytes - oldSize + pageCount * PAGE_SIZE;
+            statistics.peakLiveBytes = std::max(statistics.peakLiveBytes, statistics.liveBytes);
+            result = address;
+            return true;
+        }
+    }
+    std::uint64_t newAddress = allocate(size);
+    if (newAddress == 0) {
+        result = 0;
+        return true;
+    }
+    std::memcpy(memory + newAddress, memory + address, std::min(oldSize, size));
+    release(address);
+    result = newAddress;
+    return true;
+}
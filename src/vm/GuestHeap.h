@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * 一个size class的分配统计，run的字节数与其中存活的块的字节数之差即为这个size class占用但没有使用的空间。
+ */
+struct SizeClassStatistics {
+    std::uint64_t liveBytes = 0; // 当前尚未释放的块的总大小
+    std::uint64_t reservedBytes = 0; // 当前持有的run的总大小
+    std::uint64_t peakLiveBytes = 0; // 尚未释放的块的总大小的最大值
+    std::uint64_t peakReservedBytes = 0; // 持有的run的总大小的最大值
+};
+
+/**
+ * 堆的分配统计。
+ * 块的大小均为分配器实际划分出的可用大小，而不是程序请求的大小。
+ */
+struct HeapStatistics {
+    static constexpr std::uint32_t SIZE_CLASS_COUNT = 32; // 16到128每16字节一级，此后每翻一倍分为4级，直到8192字节
+
+
+    std::uint64_t allocationCount = 0; // 分配的块数，包括realloc中重新分配的块
+    std::uint64_t freeCount = 0; // 释放的块数，包括realloc中释放的旧块
+    std::uint64_t failedCount = 0; // 因为堆区空间不足而失败的分配次数
+    std::uint64_t liveBytes = 0; // 当前尚未释放的块的总大小
+    std::uint64_t peakLiveBytes = 0; // 尚未释放的块的总大小的最大值
+    std::uint64_t peakHeapBytes = 0; // 从堆区划分出去的页的总大小的最大值，包括run中空闲的块和尚未合并回堆顶的空闲页
+    std::array<SizeClassStatistics, SIZE_CLASS_COUNT> sizeClassList{}; // 每个size class的统计，下标为size class
+};
+
+/**
+ * 客户程序的堆分配器，管理数据区中的堆区，实现malloc、free和realloc。
+ * 分配器的元数据都保存在宿主内存中，客户程序越界写入堆区不会破坏分配器，释放非法地址或者重复释放都能被发现。
+ * 堆区按页划分为连续的span：
+ * 不超过SMALL_SIZE_LIMIT字节的请求向上取整到size class，每个size class从RUN_SIZE字节的run中切分出等大的块，释放的块进入所属run的空闲链表，
+ * run中的块全部释放后将run的页归还给页分配器，只有size class当前正在切分的run即使为空也保留，避免反复分配和释放同一个块时每次都申请新的run；
+ * 更大的请求直接分配整数个页，释放时与相邻的空闲span合并，合并到堆顶时降低堆顶，空闲span按大小最佳适配。
+ * 所有的块都按16字节对齐，malloc(0)也返回一个可以释放的最小块。
+ */
+class GuestHeap {
+private:
+    static constexpr std::uint64_t PAGE_SIZE = 4096;
+    static constexpr std::uint64_t RUN_SIZE = 64 * 1024; // 小块所在的run的大小
+    static constexpr std::uint64_t SMALL_SIZE_LIMIT = 8192; // 使用size class分配的最大请求
+    static constexpr std::uint32_t SIZE_CLASS_COUNT = HeapStatistics::SIZE_CLASS_COUNT;
+    static constexpr std::uint32_t NO_RUN = UINT32_MAX;
+
+    enum class PageState : std::uint8_t {
+        FREE, // 空闲span中的页
+        SMALL, // run中的页
+        LARGE, // 直接分配的大块中的页
+    };
+
+    /**
+     * 已经划分出去的页的信息，span中的每一页都保存所在span的完整信息，任何地址都可以直接找到所在的span。
+     */
+    struct Page {
+        std::uint32_t spanBegin; // 所在span的第一页
+        std::uint32_t spanPageCount; // 所在span的页数
+        std::uint32_t run; // 所在run在runList中的下标，不在run中时为NO_RUN
+        PageState state;
+    };
+
+    /**
+     * 切分为等大小块的run。
+     */
+    struct Run {
+        std::uint64_t address; // 第一个块的地址
+        std::uint32_t sizeClass;
+        std::uint32_t liveCount; // 尚未释放的块数
+        std::uint32_t partialIndex; // 在所属size class的partialRunList中的下标，空闲链表为空时为NO_RUN
+        std::vector<std::uint64_t> allocatedBitList; // 每个块是否已经分配
+        std::vector<std::uint64_t> freeList; // 释放后可以重用的块
+    };
+
+    /**
+     * 一个size class的分配状态。
+     */
+    struct SizeClass {
+        std::vector<std::uint32_t> partialRunList; // 空闲链表不为空的run
+        std::uint64_t next = 0; // 当前run中下一个从未分配过的块
+        std::uint64_t end = 0; // 当前run的末尾
+        std::uint32_t run = NO_RUN; // 当前run在runList中的下标
+    };
+
+    std::uint64_t heapBegin = 0;
+    std::uint64_t heapPageCount = 0; // 堆区的总页数
+    std::vector<Page> pageList; // 已经划分出去的页，长度即堆顶的页号
+    std::set<std::pair<std::uint64_t, std::uint64_t>> freeSpanSet; // 堆顶以下的空闲span，元素为页数和第一页，按页数最佳适配
+    std::vector<Run> runList;
+    std::vector<std::uint32_t> freeRunList; // runList中已经归还的run的下标，新的run优先重用
+    std::unique_ptr<SizeClass[]> sizeClassList; // 第一次分配小块时才创建，没有使用堆的实例不占用内存
+    HeapStatistics statistics;
+
+    static std::uint32_t sizeClassOf(std::uint64_t size);
+    void markSpan(std::uint64_t begin, std::uint64_t pageCount, PageState state, std::uint32_t run);
+    bool allocatePages(std::uint64_t pageCount, std::uint64_t &begin);
+    void freePages(std::uint64_t begin, std::uint64_t pageCount);
+    bool growInPlace(std::uint64_t begin, std::uint64_t pageCount, std::uint64_t newPageCount);
+    std::uint64_t allocateSmall(std::uint32_t sizeClass);
+    void releaseSmall(std::uint32_t runIndex, std::uint64_t address);
+    std::uint64_t blockSize(std::uint64_t address) const;
+    void recordAllocation(std::uint64_t size);
+    void recordFree(std::uint64_t size);
+
+public:
+    /**
+     * 下标为sizeClass的size class中块的大小。
+     */
+    static std::uint64_t sizeOfClass(std::uint32_t sizeClass);
+
+    /**
+     * 设置堆区的位置和大小，begin必须按页对齐。
+     */
+    void initialize(std::uint64_t begin, std::uint64_t size);
+
+    /**
+     * 分配至少size字节的块，返回块的地址，堆区空间不足时返回0。
+     */
+    std::uint64_t allocate(std::uint64_t size);
+
+    /**
+     * 释放address处的块，address为0时什么也不做。address不是尚未释放的块的地址时返回false。
+     */
+    bool release(std::uint64_t address);
+
+    /**
+     * 将address处的块的大小调整为size字节，内容保持不变，新块的地址写入result，memory为数据区的起始地址，用于移动块的内容。
+     * address为0时等同于allocate，size为0时等同于release并得到0；空间不足时得到0，原来的块保持不变。
+     * address不是尚未释放的块的地址时返回false。
+     */
+    bool reallocate(std::uint64_t address, std::uint64_t size, std::uint8_t *memory, std::uint64_t &result);
+
+    [[nodiscard]] const HeapStatistics &getStatistics() const {
+        return statistics;
+    }
+};
@@ -0,0 +1,173 @@
+#include "GuestMemory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VM_GUARD_PAGE 1
+#include <csetjmp>
+#include <csignal>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define VM_GUARD_PAGE 0
+#endif
+
+#if defined(__linux__)
+#define VM_COPY_ON_WRITE 1
+#else
+#define VM_COPY_ON_WRITE 0
+#endif
+
+#if VM_GUARD_PAGE
+static thread_local std::uintptr_t memoryBegin = 0; // 当前线程正在执行的虚拟机的数据区
+static thread_local std::uintptr_t guardBegin = 0; // 当前线程正在执行的虚拟机的保护区
+static thread_local std::uintptr_t guardEnd = 0;
+static thread_local sigjmp_buf *faultJumpBuffer = nullptr; // 访问保护区时跳回的位置
+static thread_local std::uintptr_t faultingAddress = 0; // 访问保护区的地址
+static struct sigaction previousAction;
+
+static void handleFault(int, siginfo_t *info, void *) {
+    auto address = reinterpret_cast<std::uintptr_t>(info->si_addr);
+    if (faultJumpBuffer != nullptr && address >= guardBegin && address < guardEnd) {
+        // 段错误由虚拟机执行指令时同步触发，直接跳回guard，放弃执行到一半的指令
+        faultingAddress = address;
+        siglongjmp(*faultJumpBuffer, 1);
+    }
+    // 不是保护区引起的段错误，恢复原来的处理方式后重新触发
+    sigaction(SIGSEGV, &previousAction, nullptr);
+}
+#endif
+
+GuestMemoryImage::GuestMemoryImage(const std::vector<std::uint8_t> &content) : content(content) {
+#if VM_COPY_ON_WRITE
+    if (content.empty()) {
+        return;
+    }
+    auto pageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    fileSize = (content.size() + pageSize - 1) / pageSize * pageSize;
+    file = memfd_create("guest-memory-image", MFD_CLOEXEC);
+    if (file < 0) {
+        return;
+    }
+    bool written = ftruncate(file, static_cast<off_t>(fileSize)) == 0;
+    std::uint64_t offset = 0;
+    while (written && offset < content.size()) {
+        auto count = pwrite(file, content.data() + offset, content.size() - offset, static_cast<off_t>(offset));
+        written = count > 0;
+        offset += written ? static_cast<std::uint64_t>(count) : 0;
+    }
+    // 写入失败时退回到创建数据区时复制初始内容
+    if (!written) {
+        close(file);
+        file = -1;
+    }
+#endif
+}
+
+GuestMemoryImage::~GuestMemoryImage() {
+#if VM_COPY_ON_WRITE
+    if (file >= 0) {
+        close(file);
+    }
+#endif
+}
+
+GuestMemory::~GuestMemory() {
+#if VM_GUARD_PAGE
+    if (memory != nullptr) {
+        munmap(memory, reservedSize);
+    }
+#else
+    std::free(memory);
+#endif
+}
+
+void GuestMemory::installFaultHandler() {
+#if VM_GUARD_PAGE
+    // 局部静态变量的初始化是线程安全的，多个线程同时创建虚拟机时也只安装一次
+    static const bool installed = [] {
+        struct sigaction action{};
+        action.sa_sigaction = handleFault;
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGSEGV, &action, &previousAction);
+        return true;
+    }();
+    (void) installed;
+#endif
+}
+
+bool GuestMemory::allocate(const GuestMemoryImage &initialData, std::uint64_t size, std::uint64_t guardSize, std::uint64_t heapSize, std::string &errorMessage) {
+    const auto &content = initialData.getContent();
+    if (content.size() > size) {
+        errorMessage = "guest memory size " + std::to_string(size) + " is smaller than the initial data size " + std::to_string(content.size());
+        return false;
+    }
+#if VM_GUARD_PAGE
+    auto pageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    // 数据区的大小向上取整到页大小，保证越过末尾的第一个字节就落在保护区中
+    memorySize = (size + pageSize - 1) / pageSize * pageSize;
+    heapBegin = memorySize + (guardSize + pageSize - 1) / pageSize * pageSize + pageSize;
+    this->heapSize = (heapSize + pageSize - 1) / pageSize * pageSize;
+    reservedSize = heapBegin + this->heapSize + pageSize;
+    // 匿名映射的页在第一次访问时才分配，内容为0
+    void *address = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED) {
+        errorMessage = "failed to reserve " + std::to_string(size) + " bytes of guest memory";
+        return false;
+    }
+    memory = static_cast<std::uint8_t *>(address);
+    if (mprotect(memory + memorySize, heapBegin - memorySize, PROT_NONE) != 0 || mprotect(memory + heapBegin + this->heapSize, pageSize, PROT_NONE) != 0) {
+        errorMessage = "failed to protect the guard area of guest memory";
+        return false;
+    }
+    installFaultHandler();
+#if VM_COPY_ON_WRITE
+    // 以私有方式映射初始内容，第一次写某一页时才复制该页
+    if (initialData.getFile() >= 0) {
+        if (mmap(memory, initialData.getFileSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, initialData.getFile(), 0) == MAP_FAILED) {
+            errorMessage = "failed to map the initial data of guest memory";
+            return false;
+        }
+        return true;
+    }
+#endif
+#else
+    memorySize = size;
+    heapBegin = size;
+    this->heapSize = heapSize;
+    reservedSize = size + heapSize;
+    memory = static_cast<std::uint8_t *>(std::calloc(reservedSize, 1));
+    if (memory == nullptr) {
+        errorMessage = "failed to reserve " + std::to_string(size) + " bytes of guest memory";
+        return false;
+    }
+#endif
+    std::memcpy(memory, content.data(), content.size());
+    return true;
+}
+
+bool GuestMemory::guard(const std::function<void()> &function, std::uint64_t &faultAddress) const {
+#if VM_GUARD_PAGE
+    // 堆区可以访问，不会触发段错误，因此数据区之后的整段地址都可以当作保护区
+    memoryBegin = reinterpret_cast<std::uintptr_t>(memory);
+    guardBegin = reinterpret_cast<std::uintptr_t>(memory) + memorySize;
+    guardEnd = reinterpret_cast<std::uintptr_t>(memory) + reservedSize;
+    sigjmp_buf jumpBuffer;
+    // sigsetjmp保存信号屏蔽字，从信号处理函数跳回后SIGSEGV不会一直处于屏蔽状态
+    if (sigsetjmp(jumpBuffer, 1) != 0) {
+        faultJumpBuffer = nullptr;
+        faultAddress = faultingAddress - memoryBegin;
+        return false;
+    }
+    faultJumpBuffer = &jumpBuffer;
+    function();
+    faultJumpBuffer = nullptr;
+    return true;
+#else
+    function();
+    return true;
+#endif
+}
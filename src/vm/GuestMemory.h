@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * 数据区的初始内容。
+ * 在Linux上初始内容还会写入一个匿名的内存文件，数据区以写时复制的方式映射该文件，
+ * 由同一份初始内容创建的多个数据区共享没有被写过的页，创建数据区时也不需要复制初始内容。
+ * 初始内容必须在该对象的生命周期内保持有效。
+ */
+class GuestMemoryImage {
+private:
+    const std::vector<std::uint8_t> &content;
+    int file = -1; // 保存初始内容的内存文件，创建失败或者平台不支持时为-1
+    std::uint64_t fileSize = 0; // 内存文件的大小，向上取整到页大小
+
+public:
+    explicit GuestMemoryImage(const std::vector<std::uint8_t> &content);
+    GuestMemoryImage(const GuestMemoryImage &) = delete;
+    GuestMemoryImage &operator=(const GuestMemoryImage &) = delete;
+    ~GuestMemoryImage();
+
+    [[nodiscard]] const std::vector<std::uint8_t> &getContent() const {
+        return content;
+    }
+
+    [[nodiscard]] int getFile() const {
+        return file;
+    }
+
+    [[nodiscard]] std::uint64_t getFileSize() const {
+        return fileSize;
+    }
+};
+
+/**
+ * 虚拟机的数据区。
+ * 在支持mmap的平台上一次性保留整块地址空间，由操作系统在第一次访问时才真正分配并清零物理页，
+ * 因此数据区可以设置得很大而不会增加启动时间和实际内存占用。
+ * 数据区之后紧跟一段不可访问的保护区，栈区（函数的局部变量）向高地址增长，越过数据区末尾时会访问保护区而触发段错误，
+ * 段错误处理函数识别出保护区后跳回guard的调用处，由调用者报告错误，而不是静默地破坏其他内存。
+ * 保护区之后是堆区，由堆分配器管理，堆区之后同样有一页保护区。堆区的地址也是相对于数据区开头的偏移，
+ * 因此数据区和堆区之间的保护区会被当作一段不可访问的地址，而不会把栈区的溢出当作对堆区的访问。
+ */
+class GuestMemory {
+private:
+    std::uint8_t *memory = nullptr;
+    std::uint64_t memorySize = 0; // 数据区可以访问的大小
+    std::uint64_t heapBegin = 0; // 堆区的起始地址
+    std::uint64_t heapSize = 0; // 堆区的大小
+    std::uint64_t reservedSize = 0; // 包括保护区在内保留的地址空间大小
+
+    static void installFaultHandler();
+
+public:
+    GuestMemory() = default;
+    GuestMemory(const GuestMemory &) = delete;
+    GuestMemory &operator=(const GuestMemory &) = delete;
+    ~GuestMemory();
+
+    /**
+     * 分配size字节的数据区、至少guardSize字节的保护区和heapSize字节的堆区，数据区开头的内容为initialData。
+     * 失败时返回false并将原因写入errorMessage。
+     */
+    bool allocate(const GuestMemoryImage &initialData, std::uint64_t size, std::uint64_t guardSize, std::uint64_t heapSize, std::string &errorMessage);
+
+    /**
+     * 在当前线程执行function，执行过程中访问保护区时立即放弃执行并返回false，同时将越界的地址写入faultAddress。
+     * 每个线程同时只能有一个数据区处于保护中，不同线程可以同时执行各自的数据区。
+     */
+    bool guard(const std::function<void()> &function, std::uint64_t &faultAddress) const;
+
+    std::uint8_t *data() {
+        return memory;
+    }
+
+    [[nodiscard]] std::uint64_t size() const {
+        return memorySize;
+    }
+
+    [[nodiscard]] std::uint64_t getHeapBegin() const {
+        return heapBegin;
+    }
+
+    [[nodiscard]] std::uint64_t getHeapSize() const {
+        return heapSize;
+    }
+
+    /**
+     * 返回从address开始到所在区域（数据区或堆区）末尾的字节数，address不在任何区域中时返回0。
+     */
+    [[nodiscard]] std::uint64_t available(std::uint64_t address) const {
+        if (address < memorySize) {
+            return memorySize - address;
+        }
+        if (address - heapBegin < heapSize) {
+            return heapBegin + heapSize - address;
+        }
+        return 0;
+    }
+
+    std::uint8_t &operator[](std::uint64_t address) {
+        return memory[address];
+    }
+};
@@ -0,0 +1,248 @@
+#include "InputReader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#if VM_INPUT_READER_POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+InputReader::InputReader(std::istream &stream) : stream(&stream) {
+#if VM_INPUT_READER_POSIX
+    if (&stream != &std::cin) {
+        return;
+    }
+    file = STDIN_FILENO;
+    // 标准输入是普通文件时从当前位置开始直接使用映射的内容，不需要读取和复制
+    struct stat status{};
+    auto offset = lseek(file, 0, SEEK_CUR);
+    if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode) || offset < 0 || status.st_size <= offset) {
+        return;
+    }
+    void *address = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (address == MAP_FAILED) {
+        return;
+    }
+    madvise(address, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+    mappedContent = address;
+    mappedSize = static_cast<std::uint64_t>(status.st_size);
+    data = static_cast<const char *>(address);
+    position = static_cast<std::uint64_t>(offset);
+    size = mappedSize;
+    exhausted = true;
+#endif
+}
+
+InputReader::~InputReader() {
+#if VM_INPUT_READER_POSIX
+    if (mappedContent != nullptr) {
+        munmap(mappedContent, mappedSize);
+    }
+#endif
+}
+
+bool InputReader::fill() {
+    if (exhausted) {
+        return false;
+    }
+    // 未读取的内容移到开头，一个词比整个缓冲区还长时扩大缓冲区
+    std::uint64_t remaining = size - position;
+    if (remaining > 0 && position > 0) {
+        std::memmove(buffer.data(), buffer.data() + position, remaining);
+    }
+    position = 0;
+    size = remaining;
+    if (buffer.size() - size < BLOCK_SIZE) {
+        buffer.resize(std::max<std::uint64_t>(buffer.size() * 2, size + BLOCK_SIZE));
+    }
+    std::int64_t count = 0;
+#if VM_INPUT_READER_POSIX
+    if (file >= 0) {
+        // 管道和终端上只返回已经到达的内容，交互式输入不会被阻塞到读满一块
+        do {
+            count = read(file, buffer.data() + size, buffer.size() - size);
+        } while (count < 0 && errno == EINTR);
+    } else
+#endif
+    if (stream->rdbuf() != nullptr) {
+        count = stream->rdbuf()->sgetn(buffer.data() + size, static_cast<std::streamsize>(buffer.size() - size));
+    }
+    data = buffer.data();
+    if (count <= 0) {
+        exhausted = true;
+        return false;
+    }
+    size += static_cast<std::uint64_t>(count);
+    return true;
+}
+
+bool InputReader::nextToken(const char *&first, const char *&last) {
+    if (failed) {
+        return false;
+    }
+    while (true) {
+        while (position < size && isSpace(data[position])) {
+            position++;
+        }
+        if (position < size) {
+            break;
+        }
+        if (!fill()) {
+            failed = true;
+            return false;
+        }
+    }
+    // 数值总是以空白或者输入末尾结束，保证整个词都已经读入后再解析
+    std::uint64_t end = position;
+    while (true) {
+        while (end < size && !isSpace(data[end])) {
+            end++;
+        }
+        if (end < size) {
+            break;
+        }
+        std::uint64_t length = end - position;
+        if (!fill()) {
+            break;
+        }
+        end = position + length;
+    }
+    first = data + position;
+    last = data + end;
+    return true;
+}
+
+std::int64_t InputReader::readI64() {
+    const char *first;
+    const char *last;
+    if (!nextToken(first, last)) {
+        return 0;
+    }
+    bool negative = *first == '-';
+    auto digits = *first == '+' || *first == '-' ? first + 1 : first;
+    std::uint64_t magnitude = 0;
+    auto [end, error] = std::from_chars(digits, last, magnitude);
+    if (end == digits) {
+        failed = true;
+        return 0;
+    }
+    position = end - data;
+    // 溢出时与输入流一样取最大值或最小值并失败
+    auto limit = negative ? static_cast<std::uint64_t>(INT64_MAX) + 1 : static_cast<std::uint64_t>(INT64_MAX);
+    if (error == std::errc::result_out_of_range || magnitude > limit) {
+        failed = true;
+        return negative ? INT64_MIN : INT64_MAX;
+    }
+    return static_cast<std::int64_t>(negative ? 0 - magnitude : magnitude);
+}
+
+std::uint64_t InputReader::readU64() {
+    const char *first;
+    const char *last;
+    if (!nextToken(first, last)) {
+        return 0;
+    }
+    bool negative = *first == '-';
+    auto digits = *first == '+' || *first == '-' ? first + 1 : first;
+    std::uint64_t magnitude = 0;
+    auto [end, error] = std::from_chars(digits, last, magnitude);
+    if (end == digits) {
+        failed = true;
+        return 0;
+    }
+    position = end - data;
+    if (error == std::errc::result_out_of_range) {
+        failed = true;
+        return UINT64_MAX;
+    }
+    // 与输入流一样，负数按无符号数取反
+    return negative ? 0 - magnitude : magnitude;
+}
+
+double InputReader::readF64() {
+    const char *first;
+    const char *last;
+    if (!nextToken(first, last)) {
+        return 0;
+    }
+    // from_chars不接受正号，但会接受inf和nan，输入流则相反
+    auto number = *first == '+' ? first + 1 : first;
+    auto digits = number == first && *number == '-' ? number + 1 : number;
+    if (digits == last || (!isDigit(*digits) && *digits != '.')) {
+        failed = true;
+        return 0;
+    }
+    double value = 0;
+    auto [end, error] = std::from_chars(number, last, value);
+    if (end == number) {
+        failed = true;
+        return 0;
+    }
+    position = end - data;
+    // 输入流会连同不完整的指数部分一起读入，然后因为无法转换而失败
+    if (end != last && (*end == 'e' || *end == 'E')) {
+        failed = true;
+        return 0;
+    }
+    if (error == std::errc::result_out_of_range) {
+        // 上溢时与输入流一样取最大的有限值并失败，下溢时取strtod的结果
+        value = std::strtod(std::string(number, end).c_str(), nullptr);
+        if (value == std::numeric_limits<double>::infinity() || value == -std::numeric_limits<double>::infinity()) {
+            failed = true;
+            return value > 0 ? std::numeric_limits<double>::max() : -std::numeric_limits<double>::max();
+        }
+    }
+    return value;
+}
+
+void InputReader::readLine(char *destination, std::uint64_t capacity) {
+    if (capacity == 0) {
+        return;
+    }
+    std::uint64_t count = 0; // 保存的字符数
+    bool extracted = false; // 是否读取了任何字符，包括换行
+    while (!failed) {
+        if (position == size && !fill()) {
+            break;
+        }
+        if (data[position] == '\n') {
+            position++;
+            extracted = true;
+            break;
+        }
+        // 保存了capacity - 1个字符后下一个字符不是换行时失败
+        if (count + 1 >= capacity) {
+            failed = true;
+            break;
+        }
+        auto length = std::min(size - position, capacity - 1 - count);
+        auto newline = static_cast<const char *>(std::memchr(data + position, '\n', length));
+        if (newline != nullptr) {
+            length = newline - (data + position);
+        }
+        std::memcpy(destination + count, data + position, length);
+        count += length;
+        position += length;
+        extracted = extracted || length > 0;
+    }
+    destination[count] = '\0';
+    if (!extracted) {
+        failed = true;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define VM_INPUT_READER_POSIX 1
+#else
+#define VM_INPUT_READER_POSIX 0
+#endif
+
+/**
+ * 虚拟机的输入读取器。
+ * IN_*指令不再逐个值经过输入流的operator>>和getline，而是由读取器成块地读入输入，再用std::from_chars解析。
+ * 输入为标准输入时直接读取文件描述符，标准输入是普通文件时将整个文件映射到内存；其他输入流每次从其streambuf读取一块。
+ * 读取器接管了整个输入流，读入的内容只能由读取器使用。
+ * 空白字符、符号、溢出和换行的处理都与默认格式的输入流相同：读取数值时跳过前导空白，
+ * 读取一行时不跳过空白，读到换行为止，换行被丢弃而不保存。一旦读取失败，此后的读取都失败，数值为0，字符串为空。
+ */
+class InputReader {
+private:
+    static constexpr std::uint64_t BLOCK_SIZE = 64 * 1024; // 每次读取的字节数
+
+    std::istream *stream;
+    int file = -1; // 直接读取的文件描述符，不是标准输入或者平台不支持时为-1
+    void *mappedContent = nullptr; // 映射到内存的输入文件，没有映射时为空
+    std::uint64_t mappedSize = 0;
+    std::vector<char> buffer; // 没有映射时读入的内容
+    const char *data = nullptr; // 当前可用的输入，指向映射的文件或者buffer
+    std::uint64_t position = 0; // 下一个未读取的字符在data中的位置
+    std::uint64_t size = 0; // data中可用的字节数
+    bool exhausted = false; // 是否已经读到输入的末尾
+    bool failed = false; // 是否有读取失败
+
+    bool fill();
+    bool nextToken(const char *&first, const char *&last);
+
+public:
+    explicit InputReader(std::istream &stream);
+    InputReader(const InputReader &) = delete;
+    InputReader &operator=(const InputReader &) = delete;
+    ~InputReader();
+
+    std::int64_t readI64();
+    std::uint64_t readU64();
+    double readF64();
+
+    /**
+     * 读取一行，最多保存capacity - 1个字符，并在末尾加上0。
+     */
+    void readLine(char *destination, std::uint64_t capacity);
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define VM_LAZY_ARRAY_MMAP 1
+#else
+#define VM_LAZY_ARRAY_MMAP 0
+#endif
+
+/**
+ * 按需分配物理内存的定长数组。
+ * 在支持mmap的平台上直接使用匿名映射，内容为0，只有访问到的页才会真正分配物理内存，
+ * 适合容量很大但通常只用到开头一小部分的操作数栈和调用栈。其他平台上退化为calloc。
+ * 元素类型必须可以通过全0的字节表示初始化。
+ */
+template<typename T>
+class LazyArray {
+private:
+    T *elements = nullptr;
+    std::uint64_t count = 0;
+
+    void release() {
+        if (elements == nullptr) {
+            return;
+        }
+#if VM_LAZY_ARRAY_MMAP
+        munmap(elements, count * sizeof(T));
+#else
+        std::free(elements);
+#endif
+        elements = nullptr;
+        count = 0;
+    }
+
+public:
+    LazyArray() = default;
+    LazyArray(const LazyArray &) = delete;
+    LazyArray &operator=(const LazyArray &) = delete;
+
+    ~LazyArray() {
+        release();
+    }
+
+    /**
+     * 分配count个元素，失败时返回false。
+     */
+    bool allocate(std::uint64_t count) {
+        release();
+        if (count == 0) {
+            return true;
+        }
+#if VM_LAZY_ARRAY_MMAP
+        void *address = mmap(nullptr, count * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        elements = static_cast<T *>(address);
+#else
+        elements = static_cast<T *>(std::calloc(count, sizeof(T)));
+        if (elements == nullptr) {
+            return false;
+        }
+#endif
+        this->count = count;
+        return true;
+    }
+
+    T *data() {
+        return elements;
+    }
+
+    [[nodiscard]] std::uint64_t size() const {
+        return count;
+    }
+
+    T &operator[](std::uint64_t index) {
+        return elements[index];
+    }
+};
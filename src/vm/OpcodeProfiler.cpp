@@ -0,0 +1,55 @@
+#include "OpcodeProfiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include "../bytecode/Bytecode.h"
+
+OpcodeProfiler::OpcodeProfiler()
+        : countList(OPCODE_COUNT, 0), sampleCountList(OPCODE_COUNT, 0), sampledTickList(OPCODE_COUNT, 0) {
+    countdown = nextSampleInterval();
+    timestampOverhead = UINT64_MAX;
+    for (int i = 0; i < 16; i++) {
+        auto start = readTimestamp();
+        timestampOverhead = std::min(timestampOverhead, readTimestamp() - start);
+    }
+}
+
+void OpcodeProfiler::print(std::ostream &output) const {
+    std::uint64_t instructionCount = 0;
+    std::uint64_t sampleCount = 0;
+    std::vector<double> averageTickList(OPCODE_COUNT, 0);
+    double totalTicks = 0;
+    std::vector<std::size_t> opcodeList;
+    for (std::size_t i = 0; i < OPCODE_COUNT; i++) {
+        instructionCount += countList[i];
+        sampleCount += sampleCountList[i];
+        if (sampleCountList[i] != 0) {
+            auto averageTicks = static_cast<double>(sampledTickList[i]) / static_cast<double>(sampleCountList[i]) - static_cast<double>(timestampOverhead);
+            averageTickList[i] = std::max(averageTicks, 0.0);
+            totalTicks += averageTickList[i] * static_cast<double>(countList[i]);
+        }
+        if (countList[i] != 0) {
+            opcodeList.push_back(i);
+        }
+    }
+    std::stable_sort(opcodeList.begin(), opcodeList.end(), [this](std::size_t left, std::size_t right) {
+        return countList[left] > countList[right];
+    });
+    std::string unit = VM_PROFILE_RDTSC ? "cycles" : "ns";
+    output << "[PROF] instructions: " << instructionCount << ", samples: " << sampleCount << ", time unit: " << unit << std::endl;
+    output << "[PROF] " << std::setw(24) << std::left << "opcode" << std::setw(16) << std::right << "count" << std::setw(10) << "count%"
+           << std::setw(14) << ("avg " + unit) << std::setw(10) << "time%" << std::endl;
+    for (auto i : opcodeList) {
+        auto name = i == 0 ? std::string("invalid") : opcode2String(static_cast<Opcode>(i));
+        double countPercentage = 100.0 * static_cast<double>(countList[i]) / static_cast<double>(instructionCount);
+        output << "[PROF] " << std::setw(24) << std::left << name << std::setw(16) << std::right << countList[i]
+               << std::setw(10) << std::fixed << std::setprecision(2) << countPercentage;
+        // 执行次数很少的指令可能一次也没有被抽到，此时耗时未知
+        if (sampleCountList[i] == 0) {
+            output << std::setw(14) << "-" << std::setw(10) << "-" << std::endl;
+        } else {
+            double timePercentage = totalTicks == 0 ? 0 : 100.0 * averageTickList[i] * static_cast<double>(countList[i]) / totalTicks;
+            output << std::setw(14) << std::setprecision(1) << averageTickList[i] << std::setw(10) << std::setprecision(2) << timePercentage << std::endl;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "../instruction/Instruction.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define VM_PROFILE_RDTSC 1
+#else
+#define VM_PROFILE_RDTSC 0
+#endif
+
+/**
+ * 按操作码统计解释器执行的指令，由-prof-ops选项开启。
+ * 每条指令都计数，耗时则每隔若干条指令抽样一次：在分派到被抽样的指令时读取时间戳，分派到下一条指令时再读取一次，
+ * 两者之差即为该指令的处理代码加上一次分派的耗时。抽样间隔在一个范围内伪随机地变化，避免与循环体的长度同步而总是抽到同一条指令。
+ * x86-64下使用rdtsc以时钟周期为单位计时，其他平台使用steady_clock以纳秒为单位计时。
+ * 只有以统计策略实例化的解释循环才会调用record，关闭时的解释循环中没有任何统计代码。
+ */
+class OpcodeProfiler {
+private:
+    static constexpr std::size_t OPCODE_COUNT = static_cast<std::size_t>(Opcode::PUSH_BNE_I64) + 1; // 非法的操作码都计入下标0
+    static constexpr std::uint64_t MIN_SAMPLE_INTERVAL = 32; // 两次抽样之间最少间隔的指令数
+    static constexpr std::uint64_t SAMPLE_INTERVAL_MASK = 63; // 在最小间隔上随机增加的指令数的掩码，平均间隔约为64条指令
+
+    std::vector<std::uint64_t> countList; // 每种操作码的执行次数
+    std::vector<std::uint64_t> sampleCountList; // 每种操作码被抽样的次数
+    std::vector<std::uint64_t> sampledTickList; // 每种操作码被抽样时的耗时之和
+    std::uint64_t countdown; // 距离下一次抽样还有多少条指令
+    std::uint64_t randomState = 0x9E3779B97F4A7C15; // xorshift的状态，用于生成抽样间隔
+    std::size_t sampledOpcode = 0; // 正在抽样的指令的操作码
+    bool sampling = false; // 是否有正在抽样的指令
+    std::uint64_t sampleStart = 0; // 正在抽样的指令开始执行时的时间戳
+    std::uint64_t timestampOverhead; // 连续读取两次时间戳的最小间隔，从每次抽样的耗时中扣除
+
+    static std::uint64_t readTimestamp() {
+#if VM_PROFILE_RDTSC
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    std::uint64_t nextSampleInterval() {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 7;
+        randomState ^= randomState << 17;
+        return MIN_SAMPLE_INTERVAL + (randomState & SAMPLE_INTERVAL_MASK);
+    }
+
+public:
+    OpcodeProfiler();
+
+    /**
+     * 在分派到每条指令时调用，结束上一次抽样并按间隔开始新的抽样。
+     */
+    void record(Opcode opcode) {
+        if (sampling) {
+            sampledTickList[sampledOpcode] += readTimestamp() - sampleStart;
+            sampleCountList[sampledOpcode]++;
+            sampling = false;
+        }
+        auto opcodeValue = static_cast<std::size_t>(opcode);
+        if (opcodeValue >= OPCODE_COUNT) {
+            opcodeValue = 0;
+        }
+        countList[opcodeValue]++;
+        if (--countdown == 0) {
+            countdown = nextSampleInterval();
+            sampledOpcode = opcodeValue;
+            sampling = true;
+            sampleStart = readTimestamp();
+        }
+    }
+
+    /**
+     * 按执行次数从多到少输出每种操作码的执行次数、所占比例、抽样得到的平均耗时和估计的耗时比例。
+     */
+    void print(std::ostream &output) const;
+};
@@ -0,0 +1,43 @@
+#include "OutputBuffer.h"
+
+OutputBuffer::OutputBuffer(std::ostream &stream, bool lineBuffered)
+        : stream(&stream), lineBuffered(lineBuffered) {}
+
+void OutputBuffer::makeRoom() {
+    if (buffer == nullptr) {
+        buffer = std::make_unique_for_overwrite<char[]>(CAPACITY);
+        limit = CAPACITY;
+        return;
+    }
+    flush();
+}
+
+void OutputBuffer::writeLongString(const char *string, std::uint64_t length) {
+    // 放不进缓冲区的字符串先写出缓冲区中已有的内容，再直接写入输出流
+    if (buffer == nullptr) {
+        makeRoom();
+    }
+    stream->write(buffer.get(), static_cast<std::streamsize>(size));
+    size = 0;
+    if (length < CAPACITY) {
+        std::memcpy(buffer.get(), string, length);
+        size = length;
+        if (lineBuffered && std::memchr(string, '\n', length) != nullptr) {
+            flush();
+        }
+        return;
+    }
+    stream->write(string, static_cast<std::streamsize>(length));
+    if (lineBuffered) {
+        stream->flush();
+    }
+}
+
+void OutputBuffer::flush() {
+    if (size == 0) {
+        return;
+    }
+    stream->write(buffer.get(), static_cast<std::streamsize>(size));
+    stream->flush();
+    size = 0;
+}
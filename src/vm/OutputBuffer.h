@@ -0,0 +1,76 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+
+/**
+ * 虚拟机的输出缓冲区。
+ * OUT_*指令的输出先用std::to_chars格式化到虚拟机自己的缓冲区中，写满、执行停止或者读取输入之前才一次性写入输出流，
+ * 避免每个值都经过输出流的格式化和同步，输出的内容与直接使用默认格式的输出流完全相同。
+ * 行缓冲模式下输出换行后立即写入并刷新输出流，用于交互式执行。
+ */
+class OutputBuffer {
+private:
+    static constexpr std::uint64_t CAPACITY = 64 * 1024; // 缓冲区大小，单位为字节
+    static constexpr std::uint64_t MAX_NUMBER_LENGTH = 32; // 一个数格式化后的最大长度
+    static constexpr int FLOAT_PRECISION = 6; // 与输出流的默认精度相同
+
+    std::ostream *stream;
+    std::unique_ptr<char[]> buffer; // 第一次输出时才分配，不输出的实例不占用内存
+    std::uint64_t size = 0; // 缓冲区中尚未写入输出流的字节数
+    std::uint64_t limit = 0; // 可以使用的缓冲区大小，分配缓冲区之前为0
+    bool lineBuffered;
+
+    void makeRoom();
+    void writeLongString(const char *string, std::uint64_t length);
+
+public:
+    OutputBuffer(std::ostream &stream, bool lineBuffered);
+    OutputBuffer(const OutputBuffer &) = delete;
+    OutputBuffer &operator=(const OutputBuffer &) = delete;
+
+    void writeI64(std::int64_t value) {
+        if (size + MAX_NUMBER_LENGTH > limit) {
+            makeRoom();
+        }
+        size = std::to_chars(&buffer[size], &buffer[CAPACITY], value).ptr - buffer.get();
+    }
+
+    void writeU64(std::uint64_t value) {
+        if (size + MAX_NUMBER_LENGTH > limit) {
+            makeRoom();
+        }
+        size = std::to_chars(&buffer[size], &buffer[CAPACITY], value).ptr - buffer.get();
+    }
+
+    void writeF64(double value) {
+        if (size + MAX_NUMBER_LENGTH > limit) {
+            makeRoom();
+        }
+        size = std::to_chars(&buffer[size], &buffer[CAPACITY], value, std::chars_format::general, FLOAT_PRECISION).ptr - buffer.get();
+    }
+
+    /**
+     * 写入以0结尾的字符串。
+     */
+    void writeString(const char *string) {
+        auto length = std::strlen(string);
+        if (size + length >= limit) {
+            writeLongString(string, length);
+            return;
+        }
+        std::memcpy(&buffer[size], string, length);
+        size += length;
+        if (lineBuffered && std::memchr(string, '\n', length) != nullptr) {
+            flush();
+        }
+    }
+
+    /**
+     * 将缓冲区中的内容写入输出流并刷新输出流，缓冲区为空时什么也不做。
+     */
+    void flush();
+};
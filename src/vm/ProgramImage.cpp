@@ -0,0 +1,169 @@
+#include "ProgramImage.h"
+
+#include <algorithm>
+#include <cstring>
+#include "SuperinstructionFuser.h"
+#include "../jit/JitCompiler.h"
+
+ProgramImage::ProgramImage(std::shared_ptr<const Bytecode> bytecode, const VirtualMachineConfig &config)
+        : bytecode(std::move(bytecode)), config(config), initialData(this->bytecode->getDataArea()) {}
+
+std::shared_ptr<const ProgramImage> ProgramImage::load(std::shared_ptr<const Bytecode> bytecode, const VirtualMachineConfig &config) {
+    std::shared_ptr<ProgramImage> image(new ProgramImage(std::move(bytecode), config));
+    const auto &functionTable = image->getFunctionTable();
+    image->decode();
+    if (!image->errorMessage.empty()) {
+        return image;
+    }
+    for (const auto &function : functionTable) {
+        image->maxFrameSize = std::max(image->maxFrameSize, function.frameSize);
+    }
+    // 寄存器式代码和本地代码都不计量燃料也不统计操作码，限制执行的指令数或时间以及统计操作码时只能解释执行栈式指令
+    bool metered = config.fuel != 0 || config.timeLimit != 0 || config.opcodeProfile;
+#if VM_COMPUTED_GOTO && VM_JIT_SUPPORTED
+    image->jit = config.jit && config.variant == InterpreterVariant::FAST && !metered;
+#endif
+    if (config.engine == ExecutionEngine::REGISTER && config.variant == InterpreterVariant::FAST && !metered && !image->jit) {
+        image->registerCode.reset(RegisterTranslator::translate(image->instructionList, functionTable, image->functionIndexList));
+    }
+    // 寄存器式代码和本地代码都直接由原始指令翻译得到，只有解释执行栈式指令时才融合超级指令
+    if (config.superinstructions && image->registerCode == nullptr && !image->jit) {
+        SuperinstructionFuser::fuse(image->instructionList, functionTable);
+    }
+    image->calculateFuelCost();
+    return image;
+}
+
+void ProgramImage::decode() {
+    const auto &codeArea = bytecode->getCodeArea();
+    const auto &functionTable = bytecode->getFunctionTable();
+    instructionList.resize(codeArea.size() / 10);
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        std::memcpy(&(instructionList[i].opcode), &codeArea[i * 10], sizeof(instructionList[i].opcode));
+        std::memcpy(&(instructionList[i].operand), &codeArea[i * 10 + 2], sizeof(instructionList[i].operand));
+    }
+    functionIndexList.resize(instructionList.size(), INVALID_FUNCTION_INDEX);
+    for (std::uint64_t i = 0; i < functionTable.size(); i++) {
+        if (functionTable[i].address / 10 < functionIndexList.size()) {
+            functionIndexList[functionTable[i].address / 10] = static_cast<std::uint32_t>(i);
+        }
+    }
+    for (auto &decodedInstruction : instructionList) {
+        if (decodedInstruction.opcode == Opcode::CALL_IMM) {
+            decodedInstruction.functionIndex = functionIndex(decodedInstruction.operand);
+            if (decodedInstruction.functionIndex == INVALID_FUNCTION_INDEX) {
+                errorMessage = "invalid function address: " + std::to_string(decodedInstruction.operand);
+                return;
+            }
+        }
+    }
+}
+
+void ProgramImage::calculateFuelCost() {
+    const auto &functionTable = bytecode->getFunctionTable();
+    std::vector<std::uint64_t> entryIndexList;
+    for (const auto &function : functionTable) {
+        entryIndexList.push_back(function.address / 10);
+    }
+    std::sort(entryIndexList.begin(), entryIndexList.end());
+    // 函数的指令数为从入口到下一个函数入口之间的指令数
+    functionFuelCostList.resize(functionTable.size());
+    for (std::uint64_t i = 0; i < functionTable.size(); i++) {
+        auto begin = functionTable[i].address / 10;
+        auto endIterator = std::upper_bound(entryIndexList.begin(), entryIndexList.end(), begin);
+        auto end = endIterator == entryIndexList.end() ? instructionList.size() : std::max<std::uint64_t>(*endIterator, begin + 1);
+        functionFuelCostList[i] = static_cast<std::uint32_t>(std::min<std::uint64_t>(end - begin, UINT32_MAX));
+    }
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        auto &instruction = instructionList[i];
+        switch (instruction.opcode) {
+            case Opcode::JMP_IMM:
+            case Opcode::JZ_64_IMM:
+            case Opcode::JNZ_64_IMM:
+            case Opcode::CMP_BRANCH_GT_I64:
+            case Opcode::CMP_BRANCH_LT_I64:
+            case Opcode::CMP_BRANCH_EQ_I64:
+            case Opcode::BLT_I64:
+            case Opcode::BLT_U64:
+            case Opcode::BLT_F64:
+            case Opcode::BGT_I64:
+            case Opcode::BGT_U64:
+            case Opcode::BGT_F64:
+            case Opcode::BEQ_I64:
+            case Opcode::BEQ_U64:
+            case Opcode::BEQ_F64:
+            case Opcode::BGE_I64:
+            case Opcode::BGE_U64:
+            case Opcode::BGE_F64:
+            case Opcode::BLE_I64:
+            case Opcode::BLE_U64:
+            case Opcode::BLE_F64:
+            case Opcode::BNE_I64:
+            case Opcode::BNE_U64:
+            case Opcode::BNE_F64: {
+                auto target = instruction.operand / 10;
+                instruction.fuelCost = target <= i ? static_cast<std::uint32_t>(std::min<std::uint64_t>(i - target + 1, UINT32_MAX)) : 0;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+std::uint32_t ProgramImage::functionIndex(std::uint64_t address) const {
+    if (address % 10 != 0 || address / 10 >= functionIndexList.size()) {
+        return INVALID_FUNCTION_INDEX;
+    }
+    return functionIndexList[address / 10];
+}
+
+const std::vector<DecodedInstruction> &ProgramImage::bindHandlers(const void *handlerTable, const std::function<void(std::vector<DecodedInstruction> &)> &binder) const {
+    std::lock_guard<std::mutex> lock(handlerBindingMutex);
+    auto &boundInstructionList = boundInstructionListMap[handlerTable];
+    if (boundInstructionList == nullptr) {
+        boundInstructionList = std::make_unique<std::vector<DecodedInstruction>>(instructionList);
+        binder(*boundInstructionList);
+    }
+    return *boundInstructionList;
+}
+
+void ProgramImage::bindRegisterHandlers(const std::function<void(RegisterCode &)> &binder) const {
+    std::call_once(registerHandlerBindingFlag, binder, *registerCode);
+}
+
+const VirtualMachineConfig &ProgramImage::getConfig() const {
+    return config;
+}
+
+const GuestMemoryImage &ProgramImage::getInitialData() const {
+    return initialData;
+}
+
+const std::vector<FunctionTableEntry> &ProgramImage::getFunctionTable() const {
+    return bytecode->getFunctionTable();
+}
+
+const std::vector<DecodedInstruction> &ProgramImage::getInstructionList() const {
+    return instructionList;
+}
+
+const std::vector<std::uint32_t> &ProgramImage::getFunctionFuelCostList() const {
+    return functionFuelCostList;
+}
+
+const RegisterCode *ProgramImage::getRegisterCode() const {
+    return registerCode.get();
+}
+
+std::uint64_t ProgramImage::getMaxFrameSize() const {
+    return maxFrameSize;
+}
+
+bool ProgramImage::isJitEnabled() const {
+    return jit;
+}
+
+const std::string &ProgramImage::getErrorMessage() const {
+    return errorMessage;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../bytecode/Bytecode.h"
+#include "DecodedInstruction.h"
+#include "RegisterTranslator.h"
+#include "GuestMemory.h"
+#include "VirtualMachineConfig.h"
+
+/**
+ * 程序映像。
+ * 加载字节码得到的只读数据，包括预解码并融合了超级指令的代码、寄存器式代码、函数表、调用每个函数消耗的燃料以及数据区的初始内容。
+ * 由同一个映像创建的虚拟机实例共享这些数据，每个实例只拥有自己可写的数据区、操作数栈和调用栈。
+ * 指令的处理代码地址只能在解释器内部获取，每个解释循环的实例化第一次开始执行时通过bindHandlers得到一份填写了自己的处理代码地址的指令副本，
+ * 不同策略的实例化以及栈式和寄存器式执行引擎各自绑定，互不影响。
+ */
+class ProgramImage {
+private:
+    std::shared_ptr<const Bytecode> bytecode;
+    VirtualMachineConfig config;
+    GuestMemoryImage initialData;
+    std::vector<DecodedInstruction> instructionList; // 预解码后的代码区，处理代码地址为空
+    std::vector<std::uint32_t> functionIndexList; // 指令索引到以该指令为入口的函数的编号的映射，用于通过函数指针的间接调用
+    std::vector<std::uint32_t> functionFuelCostList; // 调用每个函数时消耗的燃料
+    std::unique_ptr<RegisterCode> registerCode; // 寄存器式代码，仅在使用寄存器式执行引擎且翻译成功时非空
+    std::uint64_t maxFrameSize = 0; // 最大的函数栈帧，决定数据区之后的保护区大小
+    bool jit = false; // 是否启用JIT，启用时每个实例在自己的指令副本上计数和替换处理代码
+    std::string errorMessage; // 加载时的错误信息，没有出错时为空
+    mutable std::mutex handlerBindingMutex; // 保护boundInstructionListMap
+    mutable std::map<const void *, std::unique_ptr<std::vector<DecodedInstruction>>> boundInstructionListMap; // 以解释循环的处理代码表为键的已绑定指令副本
+    mutable std::once_flag registerHandlerBindingFlag; // 寄存器式执行引擎只有一个解释循环，只绑定一次
+
+private:
+    ProgramImage(std::shared_ptr<const Bytecode> bytecode, const VirtualMachineConfig &config);
+    void decode();
+    void calculateFuelCost();
+
+public:
+    /**
+     * 按照config加载字节码，加载时的错误记录在映像中，由虚拟机实例在执行时返回。
+     */
+    static std::shared_ptr<const ProgramImage> load(std::shared_ptr<const Bytecode> bytecode, const VirtualMachineConfig &config);
+
+    /**
+     * 返回以address为入口的函数的编号，address不是函数入口时返回INVALID_FUNCTION_INDEX。
+     */
+    [[nodiscard]] std::uint32_t functionIndex(std::uint64_t address) const;
+
+    /**
+     * 返回以handlerTable绑定的指令副本，handlerTable标识解释循环的一个实例化。
+     * 同一个handlerTable在所有实例中只调用binder一次，由binder在预解码的指令的副本中填写处理代码地址。
+     */
+    const std::vector<DecodedInstruction> &bindHandlers(const void *handlerTable, const std::function<void(std::vector<DecodedInstruction> &)> &binder) const;
+
+    /**
+     * 在所有实例中只调用binder一次，由binder填写寄存器式指令的处理代码地址。
+     */
+    void bindRegisterHandlers(const std::function<void(RegisterCode &)> &binder) const;
+
+    [[nodiscard]] const VirtualMachineConfig &getConfig() const;
+    [[nodiscard]] const GuestMemoryImage &getInitialData() const;
+    [[nodiscard]] const std::vector<FunctionTableEntry> &getFunctionTable() const;
+    [[nodiscard]] const std::vector<DecodedInstruction> &getInstructionList() const;
+    [[nodiscard]] const std::vector<std::uint32_t> &getFunctionFuelCostList() const;
+    [[nodiscard]] const RegisterCode *getRegisterCode() const;
+    [[nodiscard]] std::uint64_t getMaxFrameSize() const;
+    [[nodiscard]] bool isJitEnabled() const;
+    [[nodiscard]] const std::string &getErrorMessage() const;
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * 寄存器式指令的操作码。
+ * 寄存器式指令由栈式指令翻译而来，操作数由目的寄存器d、源寄存器s1、源寄存器s2和立即数imm组成。
+ */
+enum class RegisterOpcode : std::uint16_t {
+    ADD_I64, // d = s1 + s2，以下运算指令的语义均与同名的栈式指令相同，左值为s1，右值为s2
+    ADD_U64,
+    ADD_F64,
+    SUB_I64,
+    SUB_U64,
+    SUB_F64,
+    MUL_I64,
+    MUL_U64,
+    MUL_F64,
+    DIV_I64,
+    DIV_U64,
+    DIV_F64,
+    MOD_I64,
+    MOD_U64,
+    NEG_I64, // d = -s1，以下单操作数的运算指令只使用s1
+    NEG_F64,
+    SL_I64,
+    SL_U64,
+    SR_I64,
+    SR_U64,
+    ADD_I32,
+    ADD_U32,
+    ADD_F32,
+    SUB_I32,
+    SUB_U32,
+    SUB_F32,
+    MUL_I32,
+    MUL_U32,
+    MUL_F32,
+    DIV_I32,
+    DIV_U32,
+    DIV_F32,
+    MOD_I32,
+    MOD_U32,
+    NEG_I32,
+    NEG_F32,
+    SL_I32,
+    SL_U32,
+    SR_I32,
+    SR_U32,
+    AND_64,
+    OR_64,
+    NOT_64,
+    XOR_64,
+    TB_64,
+    GT_I64,
+    GT_U64,
+    GT_F64,
+    LT_I64,
+    LT_U64,
+    LT_F64,
+    EQ_I64,
+    EQ_U64,
+    EQ_F64,
+    CAST_I64_U64,
+    CAST_I64_F64,
+    CAST_U64_I64,
+    CAST_U64_F64,
+    CAST_F64_I64,
+    CAST_F64_U64,
+    LEA_BP, // d = bp + imm
+    LOAD_I8, // 从地址s1加载到d
+    LOAD_I16,
+    LOAD_I32,
+    LOAD_I64,
+    LOAD_U8,
+    LOAD_U16,
+    LOAD_U32,
+    LOAD_U64,
+    LOAD_F32,
+    LOAD_F64,
+    LOAD_BP_I8, // 从地址bp + imm加载到d
+    LOAD_BP_I16,
+    LOAD_BP_I32,
+    LOAD_BP_I64,
+    LOAD_BP_U8,
+    LOAD_BP_U16,
+    LOAD_BP_U32,
+    LOAD_BP_U64,
+    LOAD_BP_F32,
+    LOAD_BP_F64,
+    STORE_I8, // 将s2存储到地址s1
+    STORE_I16,
+    STORE_I32,
+    STORE_I64,
+    STORE_U8,
+    STORE_U16,
+    STORE_U32,
+    STORE_U64,
+    STORE_F32,
+    STORE_F64,
+    STORE_BP_I8, // 将s2存储到地址bp + imm
+    STORE_BP_I16,
+    STORE_BP_I32,
+    STORE_BP_I64,
+    STORE_BP_U8,
+    STORE_BP_U16,
+    STORE_BP_U32,
+    STORE_BP_U64,
+    STORE_BP_F32,
+    STORE_BP_F64,
+    IN_I64, // 输入到地址s1
+    IN_U64,
+    IN_F64,
+    IN_S,
+    OUT_I64, // 输出s1
+    OUT_U64,
+    OUT_F64,
+    OUT_S,
+    MEMCPY, // 将地址s2开始的r[imm]个字节复制到地址s1，imm为保存字节数的寄存器
+    MEMSET, // 将地址s1开始的r[imm]个字节设置为s2的低8位
+    MEMCMP, // d = 比较地址s1和地址s2开始的r[imm]个字节的结果
+    SQRT_F64, // d = sqrt(s1)，以下数学函数指令的语义均与同名的栈式指令相同
+    FABS_F64,
+    FLOOR_F64,
+    CEIL_F64,
+    POW_F64, // d = pow(s1, s2)
+    EXP_F64,
+    LOG_F64,
+    SIN_F64,
+    COS_F64,
+    MALLOC, // d = malloc(s1)
+    FREE, // free(s1)
+    REALLOC, // d = realloc(s1, s2)
+    POP, // 操作数栈栈顶值出栈到d
+    DROP, // 弹出操作数栈栈顶值
+    PUSH, // s1入操作数栈
+    PUSH_IMM, // imm入操作数栈
+    PUSH_BP, // bp + imm入操作数栈
+    JMP, // 跳转到寄存器指令索引imm
+    JMP_INDIRECT, // 跳转到栈式指令地址s1对应的寄存器指令
+    JZ, // 若s1全0则跳转到寄存器指令索引imm
+    JZ_INDIRECT, // 若s1全0则跳转到栈式指令地址s2对应的寄存器指令
+    JNZ, // 若s1非全0则跳转到寄存器指令索引imm
+    JNZ_INDIRECT, // 若s1非全0则跳转到栈式指令地址s2对应的寄存器指令
+    CALL, // 调用编号为imm的函数
+    CALL_INDIRECT, // 调用栈式指令地址为s1的函数
+    RET, // 函数返回
+    HLT, // 停机
+};
+
+/**
+ * 寄存器式指令。
+ * 不需要的操作数字段保持为0。
+ */
+struct RegisterInstruction {
+    const void *handler = nullptr; // 指令处理代码的地址，仅在使用计算跳转（computed goto）分派时有效
+    std::uint64_t immediate = 0;
+    std::uint32_t destination = 0;
+    std::uint32_t source1 = 0;
+    std::uint32_t source2 = 0;
+    RegisterOpcode opcode = RegisterOpcode::HLT;
+};
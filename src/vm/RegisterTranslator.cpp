@@ -0,0 +1,1023 @@
+#include "RegisterTranslator.h"
+
+RegisterTranslator::RegisterTranslator(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, const std::vector<std::uint32_t> &functionIndexList)
+        : instructionList(instructionList), functionTable(functionTable), functionIndexList(functionIndexList) {
+    registerCode = new RegisterCode();
+    registerCode->entryIndexList.resize(instructionList.size(), RegisterCode::INVALID_ENTRY);
+}
+
+/**
+ * 找出所有基本块的入口。
+ * 入口包括第一条指令、所有函数的入口、跳转和调用指令之后的指令、带立即数的跳转和调用指令的目标，以及由紧邻的PUSH指令给出的跳转目标。
+ * 间接跳转和间接调用只能以这些入口作为目标，函数指针的目标总是函数的入口。
+ */
+void RegisterTranslator::findBlockEntries() {
+    blockEntryList.resize(instructionList.size(), false);
+    auto markEntry = [this](std::uint64_t address) {
+        if (address % 10 == 0 && address / 10 < instructionList.size()) {
+            blockEntryList[address / 10] = true;
+        }
+    };
+    markEntry(0);
+    for (const auto &function : functionTable) {
+        markEntry(function.address);
+    }
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        switch (instructionList[i].opcode) {
+            case Opcode::JMP:
+            case Opcode::JZ_64:
+            case Opcode::JNZ_64:
+            case Opcode::CALL:
+                if (i > 0 && instructionList[i - 1].opcode == Opcode::PUSH_64) {
+                    markEntry(instructionList[i - 1].operand);
+                }
+                markEntry((i + 1) * 10);
+                break;
+            case Opcode::JMP_IMM:
+            case Opcode::JZ_64_IMM:
+            case Opcode::JNZ_64_IMM:
+            case Opcode::BLT_I64:
+            case Opcode::BLT_U64:
+            case Opcode::BLT_F64:
+            case Opcode::BGT_I64:
+            case Opcode::BGT_U64:
+            case Opcode::BGT_F64:
+            case Opcode::BEQ_I64:
+            case Opcode::BEQ_U64:
+            case Opcode::BEQ_F64:
+            case Opcode::BGE_I64:
+            case Opcode::BGE_U64:
+            case Opcode::BGE_F64:
+            case Opcode::BLE_I64:
+            case Opcode::BLE_U64:
+            case Opcode::BLE_F64:
+            case Opcode::BNE_I64:
+            case Opcode::BNE_U64:
+            case Opcode::BNE_F64:
+            case Opcode::CALL_IMM:
+                markEntry(instructionList[i].operand);
+                markEntry((i + 1) * 10);
+                break;
+            case Opcode::RET:
+            case Opcode::HLT:
+                markEntry((i + 1) * 10);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool RegisterTranslator::translate() {
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        if (blockEntryList[i]) {
+            flush();
+            temporaryCount = 0;
+            registerCode->entryIndexList[i] = registerCode->instructionList.size();
+        }
+        const DecodedInstruction &instruction = instructionList[i];
+        switch (instruction.opcode) {
+            case Opcode::ADD_I64:
+                translateBinary(RegisterOpcode::ADD_I64);
+                break;
+            case Opcode::ADD_U64:
+                translateBinary(RegisterOpcode::ADD_U64);
+                break;
+            case Opcode::ADD_F64:
+                translateBinary(RegisterOpcode::ADD_F64);
+                break;
+            case Opcode::SUB_I64:
+                translateBinary(RegisterOpcode::SUB_I64);
+                break;
+            case Opcode::SUB_U64:
+                translateBinary(RegisterOpcode::SUB_U64);
+                break;
+            case Opcode::SUB_F64:
+                translateBinary(RegisterOpcode::SUB_F64);
+                break;
+            case Opcode::MUL_I64:
+                translateBinary(RegisterOpcode::MUL_I64);
+                break;
+            case Opcode::MUL_U64:
+                translateBinary(RegisterOpcode::MUL_U64);
+                break;
+            case Opcode::MUL_F64:
+                translateBinary(RegisterOpcode::MUL_F64);
+                break;
+            case Opcode::DIV_I64:
+                translateBinary(RegisterOpcode::DIV_I64);
+                break;
+            case Opcode::DIV_U64:
+                translateBinary(RegisterOpcode::DIV_U64);
+                break;
+            case Opcode::DIV_F64:
+                translateBinary(RegisterOpcode::DIV_F64);
+                break;
+            case Opcode::MOD_I64:
+                translateBinary(RegisterOpcode::MOD_I64);
+                break;
+            case Opcode::MOD_U64:
+                translateBinary(RegisterOpcode::MOD_U64);
+                break;
+            case Opcode::NEG_I64:
+                translateUnary(RegisterOpcode::NEG_I64);
+                break;
+            case Opcode::NEG_F64:
+                translateUnary(RegisterOpcode::NEG_F64);
+                break;
+            case Opcode::SL_I64:
+                translateBinary(RegisterOpcode::SL_I64);
+                break;
+            case Opcode::SL_U64:
+                translateBinary(RegisterOpcode::SL_U64);
+                break;
+            case Opcode::SR_I64:
+                translateBinary(RegisterOpcode::SR_I64);
+                break;
+            case Opcode::SR_U64:
+                translateBinary(RegisterOpcode::SR_U64);
+                break;
+            case Opcode::ADD_I32:
+                translateBinary(RegisterOpcode::ADD_I32);
+                break;
+            case Opcode::ADD_U32:
+                translateBinary(RegisterOpcode::ADD_U32);
+                break;
+            case Opcode::ADD_F32:
+                translateBinary(RegisterOpcode::ADD_F32);
+                break;
+            case Opcode::SUB_I32:
+                translateBinary(RegisterOpcode::SUB_I32);
+                break;
+            case Opcode::SUB_U32:
+                translateBinary(RegisterOpcode::SUB_U32);
+                break;
+            case Opcode::SUB_F32:
+                translateBinary(RegisterOpcode::SUB_F32);
+                break;
+            case Opcode::MUL_I32:
+                translateBinary(RegisterOpcode::MUL_I32);
+                break;
+            case Opcode::MUL_U32:
+                translateBinary(RegisterOpcode::MUL_U32);
+                break;
+            case Opcode::MUL_F32:
+                translateBinary(RegisterOpcode::MUL_F32);
+                break;
+            case Opcode::DIV_I32:
+                translateBinary(RegisterOpcode::DIV_I32);
+                break;
+            case Opcode::DIV_U32:
+                translateBinary(RegisterOpcode::DIV_U32);
+                break;
+            case Opcode::DIV_F32:
+                translateBinary(RegisterOpcode::DIV_F32);
+                break;
+            case Opcode::MOD_I32:
+                translateBinary(RegisterOpcode::MOD_I32);
+                break;
+            case Opcode::MOD_U32:
+                translateBinary(RegisterOpcode::MOD_U32);
+                break;
+            case Opcode::NEG_I32:
+                translateUnary(RegisterOpcode::NEG_I32);
+                break;
+            case Opcode::NEG_F32:
+                translateUnary(RegisterOpcode::NEG_F32);
+                break;
+            case Opcode::SL_I32:
+                translateBinary(RegisterOpcode::SL_I32);
+                break;
+            case Opcode::SL_U32:
+                translateBinary(RegisterOpcode::SL_U32);
+                break;
+            case Opcode::SR_I32:
+                translateBinary(RegisterOpcode::SR_I32);
+                break;
+            case Opcode::SR_U32:
+                translateBinary(RegisterOpcode::SR_U32);
+                break;
+            case Opcode::AND_64:
+                translateBinary(RegisterOpcode::AND_64);
+                break;
+            case Opcode::OR_64:
+                translateBinary(RegisterOpcode::OR_64);
+                break;
+            case Opcode::NOT_64:
+                translateUnary(RegisterOpcode::NOT_64);
+                break;
+            case Opcode::XOR_64:
+                translateBinary(RegisterOpcode::XOR_64);
+                break;
+            case Opcode::TB_64:
+                translateUnary(RegisterOpcode::TB_64);
+                break;
+            case Opcode::GT_I64:
+                translateBinary(RegisterOpcode::GT_I64);
+                break;
+            case Opcode::GT_U64:
+                translateBinary(RegisterOpcode::GT_U64);
+                break;
+            case Opcode::GT_F64:
+                translateBinary(RegisterOpcode::GT_F64);
+                break;
+            case Opcode::LT_I64:
+                translateBinary(RegisterOpcode::LT_I64);
+                break;
+            case Opcode::LT_U64:
+                translateBinary(RegisterOpcode::LT_U64);
+                break;
+            case Opcode::LT_F64:
+                translateBinary(RegisterOpcode::LT_F64);
+                break;
+            case Opcode::EQ_I64:
+                translateBinary(RegisterOpcode::EQ_I64);
+                break;
+            case Opcode::EQ_U64:
+                translateBinary(RegisterOpcode::EQ_U64);
+                break;
+            case Opcode::EQ_F64:
+                translateBinary(RegisterOpcode::EQ_F64);
+                break;
+            case Opcode::CAST_I64_U64:
+                translateUnary(RegisterOpcode::CAST_I64_U64);
+                break;
+            case Opcode::CAST_I64_F64:
+                translateUnary(RegisterOpcode::CAST_I64_F64);
+                break;
+            case Opcode::CAST_U64_I64:
+                translateUnary(RegisterOpcode::CAST_U64_I64);
+                break;
+            case Opcode::CAST_U64_F64:
+                translateUnary(RegisterOpcode::CAST_U64_F64);
+                break;
+            case Opcode::CAST_F64_I64:
+                translateUnary(RegisterOpcode::CAST_F64_I64);
+                break;
+            case Opcode::CAST_F64_U64:
+                translateUnary(RegisterOpcode::CAST_F64_U64);
+                break;
+            case Opcode::JMP:
+                if (!translateJump(RegisterOpcode::JMP, RegisterOpcode::JMP_INDIRECT, false)) {
+                    return false;
+                }
+                break;
+            case Opcode::JZ_64:
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::JNZ_64:
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::LOAD_I8:
+                translateLoad(RegisterOpcode::LOAD_I8, RegisterOpcode::LOAD_BP_I8);
+                break;
+            case Opcode::LOAD_I16:
+                translateLoad(RegisterOpcode::LOAD_I16, RegisterOpcode::LOAD_BP_I16);
+                break;
+            case Opcode::LOAD_I32:
+                translateLoad(RegisterOpcode::LOAD_I32, RegisterOpcode::LOAD_BP_I32);
+                break;
+            case Opcode::LOAD_I64:
+                translateLoad(RegisterOpcode::LOAD_I64, RegisterOpcode::LOAD_BP_I64);
+                break;
+            case Opcode::LOAD_U8:
+                translateLoad(RegisterOpcode::LOAD_U8, RegisterOpcode::LOAD_BP_U8);
+                break;
+            case Opcode::LOAD_U16:
+                translateLoad(RegisterOpcode::LOAD_U16, RegisterOpcode::LOAD_BP_U16);
+                break;
+            case Opcode::LOAD_U32:
+                translateLoad(RegisterOpcode::LOAD_U32, RegisterOpcode::LOAD_BP_U32);
+                break;
+            case Opcode::LOAD_U64:
+                translateLoad(RegisterOpcode::LOAD_U64, RegisterOpcode::LOAD_BP_U64);
+                break;
+            case Opcode::LOAD_F32:
+                translateLoad(RegisterOpcode::LOAD_F32, RegisterOpcode::LOAD_BP_F32);
+                break;
+            case Opcode::LOAD_F64:
+                translateLoad(RegisterOpcode::LOAD_F64, RegisterOpcode::LOAD_BP_F64);
+                break;
+            case Opcode::STORE_I8:
+                translateStore(RegisterOpcode::STORE_I8, RegisterOpcode::STORE_BP_I8);
+                break;
+            case Opcode::STORE_I16:
+                translateStore(RegisterOpcode::STORE_I16, RegisterOpcode::STORE_BP_I16);
+                break;
+            case Opcode::STORE_I32:
+                translateStore(RegisterOpcode::STORE_I32, RegisterOpcode::STORE_BP_I32);
+                break;
+            case Opcode::STORE_I64:
+                translateStore(RegisterOpcode::STORE_I64, RegisterOpcode::STORE_BP_I64);
+                break;
+            case Opcode::STORE_U8:
+                translateStore(RegisterOpcode::STORE_U8, RegisterOpcode::STORE_BP_U8);
+                break;
+            case Opcode::STORE_U16:
+                translateStore(RegisterOpcode::STORE_U16, RegisterOpcode::STORE_BP_U16);
+                break;
+            case Opcode::STORE_U32:
+                translateStore(RegisterOpcode::STORE_U32, RegisterOpcode::STORE_BP_U32);
+                break;
+            case Opcode::STORE_U64:
+                translateStore(RegisterOpcode::STORE_U64, RegisterOpcode::STORE_BP_U64);
+                break;
+            case Opcode::STORE_F32:
+                translateStore(RegisterOpcode::STORE_F32, RegisterOpcode::STORE_BP_F32);
+                break;
+            case Opcode::STORE_F64:
+                translateStore(RegisterOpcode::STORE_F64, RegisterOpcode::STORE_BP_F64);
+                break;
+            case Opcode::IN_I64:
+                emit(RegisterOpcode::IN_I64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::IN_U64:
+                emit(RegisterOpcode::IN_U64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::IN_F64:
+                emit(RegisterOpcode::IN_F64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::IN_S:
+                emit(RegisterOpcode::IN_S, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::OUT_I64:
+                emit(RegisterOpcode::OUT_I64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::OUT_U64:
+                emit(RegisterOpcode::OUT_U64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::OUT_F64:
+                emit(RegisterOpcode::OUT_F64, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::OUT_S:
+                emit(RegisterOpcode::OUT_S, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::MEMCPY:
+                translateMemory(RegisterOpcode::MEMCPY);
+                break;
+            case Opcode::MEMSET:
+                translateMemory(RegisterOpcode::MEMSET);
+                break;
+            case Opcode::MEMCMP:
+                translateMemory(RegisterOpcode::MEMCMP);
+                break;
+            case Opcode::SQRT_F64:
+                translateUnary(RegisterOpcode::SQRT_F64);
+                break;
+            case Opcode::FABS_F64:
+                translateUnary(RegisterOpcode::FABS_F64);
+                break;
+            case Opcode::FLOOR_F64:
+                translateUnary(RegisterOpcode::FLOOR_F64);
+                break;
+            case Opcode::CEIL_F64:
+                translateUnary(RegisterOpcode::CEIL_F64);
+                break;
+            case Opcode::POW_F64:
+                translateBinary(RegisterOpcode::POW_F64);
+                break;
+            case Opcode::EXP_F64:
+                translateUnary(RegisterOpcode::EXP_F64);
+                break;
+            case Opcode::LOG_F64:
+                translateUnary(RegisterOpcode::LOG_F64);
+                break;
+            case Opcode::SIN_F64:
+                translateUnary(RegisterOpcode::SIN_F64);
+                break;
+            case Opcode::COS_F64:
+                translateUnary(RegisterOpcode::COS_F64);
+                break;
+            case Opcode::MALLOC:
+                translateUnary(RegisterOpcode::MALLOC);
+                break;
+            case Opcode::FREE:
+                emit(RegisterOpcode::FREE, 0, toRegister(pop()), 0, 0);
+                break;
+            case Opcode::REALLOC:
+                translateBinary(RegisterOpcode::REALLOC);
+                break;
+            case Opcode::ADD_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_I64);
+                break;
+            case Opcode::ADD_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_U64);
+                break;
+            case Opcode::ADD_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_F64);
+                break;
+            case Opcode::SUB_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_I64);
+                break;
+            case Opcode::SUB_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_U64);
+                break;
+            case Opcode::SUB_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_F64);
+                break;
+            case Opcode::MUL_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_I64);
+                break;
+            case Opcode::MUL_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_U64);
+                break;
+            case Opcode::MUL_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_F64);
+                break;
+            case Opcode::DIV_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_I64);
+                break;
+            case Opcode::DIV_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_U64);
+                break;
+            case Opcode::DIV_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_F64);
+                break;
+            case Opcode::MOD_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MOD_I64);
+                break;
+            case Opcode::MOD_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MOD_U64);
+                break;
+            case Opcode::SL_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SL_I64);
+                break;
+            case Opcode::SL_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SL_U64);
+                break;
+            case Opcode::SR_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SR_I64);
+                break;
+            case Opcode::SR_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SR_U64);
+                break;
+            case Opcode::ADD_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_I32);
+                break;
+            case Opcode::ADD_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_U32);
+                break;
+            case Opcode::ADD_F32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::ADD_F32);
+                break;
+            case Opcode::SUB_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_I32);
+                break;
+            case Opcode::SUB_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_U32);
+                break;
+            case Opcode::SUB_F32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SUB_F32);
+                break;
+            case Opcode::MUL_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_I32);
+                break;
+            case Opcode::MUL_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_U32);
+                break;
+            case Opcode::MUL_F32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MUL_F32);
+                break;
+            case Opcode::DIV_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_I32);
+                break;
+            case Opcode::DIV_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_U32);
+                break;
+            case Opcode::DIV_F32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::DIV_F32);
+                break;
+            case Opcode::MOD_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MOD_I32);
+                break;
+            case Opcode::MOD_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::MOD_U32);
+                break;
+            case Opcode::SL_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SL_I32);
+                break;
+            case Opcode::SL_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SL_U32);
+                break;
+            case Opcode::SR_I32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SR_I32);
+                break;
+            case Opcode::SR_U32_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::SR_U32);
+                break;
+            case Opcode::AND_64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::AND_64);
+                break;
+            case Opcode::OR_64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::OR_64);
+                break;
+            case Opcode::XOR_64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::XOR_64);
+                break;
+            case Opcode::GT_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::GT_I64);
+                break;
+            case Opcode::GT_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::GT_U64);
+                break;
+            case Opcode::GT_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::GT_F64);
+                break;
+            case Opcode::LT_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::LT_I64);
+                break;
+            case Opcode::LT_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::LT_U64);
+                break;
+            case Opcode::LT_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::LT_F64);
+                break;
+            case Opcode::EQ_I64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::EQ_I64);
+                break;
+            case Opcode::EQ_U64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::EQ_U64);
+                break;
+            case Opcode::EQ_F64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                translateBinary(RegisterOpcode::EQ_F64);
+                break;
+            case Opcode::CALL:
+                if (!translateJump(RegisterOpcode::CALL, RegisterOpcode::CALL_INDIRECT, false)) {
+                    return false;
+                }
+                break;
+            case Opcode::RET:
+                flush();
+                emit(RegisterOpcode::RET, 0, 0, 0, 0);
+                break;
+            case Opcode::PUSH_64:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                break;
+            case Opcode::POP_64:
+                if (symbolicStack.empty()) {
+                    emit(RegisterOpcode::DROP, 0, 0, 0, 0);
+                } else {
+                    symbolicStack.pop_back();
+                }
+                break;
+            case Opcode::COPY_64: {
+                SymbolicOperand operand = pop();
+                symbolicStack.push_back(operand);
+                symbolicStack.push_back(operand);
+                break;
+            }
+            case Opcode::SWAP_64: {
+                SymbolicOperand operand1 = pop();
+                SymbolicOperand operand2 = pop();
+                symbolicStack.push_back(operand1);
+                symbolicStack.push_back(operand2);
+                break;
+            }
+            case Opcode::FBP:
+                symbolicStack.push_back({OperandKind::BASE_OFFSET, 0});
+                break;
+            case Opcode::HLT:
+                flush();
+                emit(RegisterOpcode::HLT, 0, 0, 0, 0);
+                break;
+            case Opcode::JMP_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JMP, RegisterOpcode::JMP_INDIRECT, false)) {
+                    return false;
+                }
+                break;
+            case Opcode::JZ_64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::JNZ_64_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLT_I64:
+                // 先比较再根据比较的结果跳转，bge、ble、bne在相反的比较结果为0时跳转
+                translateBinary(RegisterOpcode::LT_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLT_U64:
+                translateBinary(RegisterOpcode::LT_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLT_F64:
+                translateBinary(RegisterOpcode::LT_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGT_I64:
+                translateBinary(RegisterOpcode::GT_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGT_U64:
+                translateBinary(RegisterOpcode::GT_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGT_F64:
+                translateBinary(RegisterOpcode::GT_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BEQ_I64:
+                translateBinary(RegisterOpcode::EQ_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BEQ_U64:
+                translateBinary(RegisterOpcode::EQ_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BEQ_F64:
+                translateBinary(RegisterOpcode::EQ_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JNZ, RegisterOpcode::JNZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGE_I64:
+                translateBinary(RegisterOpcode::LT_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGE_U64:
+                translateBinary(RegisterOpcode::LT_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BGE_F64:
+                translateBinary(RegisterOpcode::LT_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLE_I64:
+                translateBinary(RegisterOpcode::GT_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLE_U64:
+                translateBinary(RegisterOpcode::GT_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BLE_F64:
+                translateBinary(RegisterOpcode::GT_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BNE_I64:
+                translateBinary(RegisterOpcode::EQ_I64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BNE_U64:
+                translateBinary(RegisterOpcode::EQ_U64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::BNE_F64:
+                translateBinary(RegisterOpcode::EQ_F64);
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::JZ, RegisterOpcode::JZ_INDIRECT, true)) {
+                    return false;
+                }
+                break;
+            case Opcode::CALL_IMM:
+                symbolicStack.push_back({OperandKind::CONSTANT, instruction.operand});
+                if (!translateJump(RegisterOpcode::CALL, RegisterOpcode::CALL_INDIRECT, false)) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    flush();
+    emit(RegisterOpcode::HLT, 0, 0, 0, 0);
+    return true;
+}
+
+/**
+ * 将临时寄存器重定位到常量寄存器之后，将直接跳转的目标由栈式指令地址替换为寄存器指令索引，并生成函数入口表。
+ */
+void RegisterTranslator::relocate() {
+    auto constantCount = static_cast<std::uint32_t>(registerCode->constantList.size());
+    registerCode->registerCount = constantCount + maxTemporaryCount;
+    auto relocateRegister = [constantCount](std::uint32_t &registerIndex) {
+        if (registerIndex & TEMPORARY_FLAG) {
+            registerIndex = constantCount + (registerIndex & ~TEMPORARY_FLAG);
+        }
+    };
+    for (const auto &function : functionTable) {
+        registerCode->functionEntryIndexList.push_back(function.address / 10 < registerCode->entryIndexList.size() ? registerCode->entryIndexList[function.address / 10] : RegisterCode::INVALID_ENTRY);
+    }
+    for (auto &instruction : registerCode->instructionList) {
+        relocateRegister(instruction.destination);
+        relocateRegister(instruction.source1);
+        relocateRegister(instruction.source2);
+        switch (instruction.opcode) {
+            case RegisterOpcode::JMP:
+            case RegisterOpcode::JZ:
+            case RegisterOpcode::JNZ:
+                instruction.immediate = registerCode->entryIndexList[instruction.immediate / 10];
+                break;
+            case RegisterOpcode::MEMCPY:
+            case RegisterOpcode::MEMSET:
+            case RegisterOpcode::MEMCMP: {
+                auto sizeRegister = static_cast<std::uint32_t>(instruction.immediate);
+                relocateRegister(sizeRegister);
+                instruction.immediate = sizeRegister;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void RegisterTranslator::emit(RegisterOpcode opcode, std::uint32_t destination, std::uint32_t source1, std::uint32_t source2, std::uint64_t immediate) {
+    RegisterInstruction instruction;
+    instruction.opcode = opcode;
+    instruction.destination = destination;
+    instruction.source1 = source1;
+    instruction.source2 = source2;
+    instruction.immediate = immediate;
+    registerCode->instructionList.push_back(instruction);
+}
+
+std::uint32_t RegisterTranslator::allocateTemporary() {
+    std::uint32_t registerIndex = TEMPORARY_FLAG | temporaryCount;
+    temporaryCount++;
+    if (temporaryCount > maxTemporaryCount) {
+        maxTemporaryCount = temporaryCount;
+    }
+    return registerIndex;
+}
+
+std::uint32_t RegisterTranslator::constantRegister(std::uint64_t value) {
+    auto iterator = constantIndexMap.find(value);
+    if (iterator != constantIndexMap.end()) {
+        return iterator->second;
+    }
+    auto registerIndex = static_cast<std::uint32_t>(registerCode->constantList.size());
+    registerCode->constantList.push_back(value);
+    constantIndexMap[value] = registerIndex;
+    return registerIndex;
+}
+
+std::uint32_t RegisterTranslator::toRegister(const SymbolicOperand &operand) {
+    switch (operand.kind) {
+        case OperandKind::REGISTER:
+            return static_cast<std::uint32_t>(operand.value);
+        case OperandKind::CONSTANT:
+            return constantRegister(operand.value);
+        case OperandKind::BASE_OFFSET: {
+            std::uint32_t registerIndex = allocateTemporary();
+            emit(RegisterOpcode::LEA_BP, registerIndex, 0, 0, operand.value);
+            return registerIndex;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 从符号栈中取出一项，符号栈为空时从真实的操作数栈中弹出到新的临时寄存器。
+ */
+RegisterTranslator::SymbolicOperand RegisterTranslator::pop() {
+    if (symbolicStack.empty()) {
+        std::uint32_t registerIndex = allocateTemporary();
+        emit(RegisterOpcode::POP, registerIndex, 0, 0, 0);
+        return {OperandKind::REGISTER, registerIndex};
+    }
+    SymbolicOperand operand = symbolicStack.back();
+    symbolicStack.pop_back();
+    return operand;
+}
+
+/**
+ * 将符号栈中剩余的项从栈底到栈顶依次压入真实的操作数栈。
+ */
+void RegisterTranslator::flush() {
+    for (const auto &operand : symbolicStack) {
+        switch (operand.kind) {
+            case OperandKind::REGISTER:
+                emit(RegisterOpcode::PUSH, 0, static_cast<std::uint32_t>(operand.value), 0, 0);
+                break;
+            case OperandKind::CONSTANT:
+                emit(RegisterOpcode::PUSH_IMM, 0, 0, 0, operand.value);
+                break;
+            case OperandKind::BASE_OFFSET:
+                emit(RegisterOpcode::PUSH_BP, 0, 0, 0, operand.value);
+                break;
+        }
+    }
+    symbolicStack.clear();
+}
+
+void RegisterTranslator::translateBinary(RegisterOpcode opcode) {
+    SymbolicOperand rightOperand = pop();
+    SymbolicOperand leftOperand = pop();
+    // 局部变量的地址计算（bp加上常量偏移）保留为符号，后续的加载和存储可以直接使用基地址偏移寻址
+    if (opcode == RegisterOpcode::ADD_U64) {
+        if (leftOperand.kind == OperandKind::BASE_OFFSET && rightOperand.kind == OperandKind::CONSTANT) {
+            symbolicStack.push_back({OperandKind::BASE_OFFSET, leftOperand.value + rightOperand.value});
+            return;
+        }
+        if (leftOperand.kind == OperandKind::CONSTANT && rightOperand.kind == OperandKind::BASE_OFFSET) {
+            symbolicStack.push_back({OperandKind::BASE_OFFSET, leftOperand.value + rightOperand.value});
+            return;
+        }
+    }
+    std::uint32_t leftRegister = toRegister(leftOperand);
+    std::uint32_t rightRegister = toRegister(rightOperand);
+    std::uint32_t destination = allocateTemporary();
+    emit(opcode, destination, leftRegister, rightRegister, 0);
+    symbolicStack.push_back({OperandKind::REGISTER, destination});
+}
+
+void RegisterTranslator::translateUnary(RegisterOpcode opcode) {
+    std::uint32_t sourceRegister = toRegister(pop());
+    std::uint32_t destination = allocateTemporary();
+    emit(opcode, destination, sourceRegister, 0, 0);
+    symbolicStack.push_back({OperandKind::REGISTER, destination});
+}
+
+void RegisterTranslator::translateLoad(RegisterOpcode opcode, RegisterOpcode baseOffsetOpcode) {
+    SymbolicOperand address = pop();
+    if (address.kind == OperandKind::BASE_OFFSET) {
+        std::uint32_t destination = allocateTemporary();
+        emit(baseOffsetOpcode, destination, 0, 0, address.value);
+        symbolicStack.push_back({OperandKind::REGISTER, destination});
+    } else {
+        std::uint32_t addressRegister = toRegister(address);
+        std::uint32_t destination = allocateTemporary();
+        emit(opcode, destination, addressRegister, 0, 0);
+        symbolicStack.push_back({OperandKind::REGISTER, destination});
+    }
+}
+
+void RegisterTranslator::translateStore(RegisterOpcode opcode, RegisterOpcode baseOffsetOpcode) {
+    SymbolicOperand value = pop();
+    SymbolicOperand address = pop();
+    std::uint32_t valueRegister = toRegister(value);
+    if (address.kind == OperandKind::BASE_OFFSET) {
+        emit(baseOffsetOpcode, 0, 0, valueRegister, address.value);
+    } else {
+        emit(opcode, 0, toRegister(address), valueRegister, 0);
+    }
+}
+
+/**
+ * 翻译内存块操作，三个操作数都放入寄存器，保存字节数的寄存器编号放在立即数中。
+ */
+void RegisterTranslator::translateMemory(RegisterOpcode opcode) {
+    std::uint32_t sizeRegister = toRegister(pop());
+    std::uint32_t rightRegister = toRegister(pop());
+    std::uint32_t leftRegister = toRegister(pop());
+    if (opcode == RegisterOpcode::MEMCMP) {
+        std::uint32_t destination = allocateTemporary();
+        emit(opcode, destination, leftRegister, rightRegister, sizeRegister);
+        symbolicStack.push_back({OperandKind::REGISTER, destination});
+    } else {
+        emit(opcode, 0, leftRegister, rightRegister, sizeRegister);
+    }
+}
+
+/**
+ * 翻译跳转和调用指令，目标为常量时翻译为直接跳转，否则翻译为间接跳转。
+ * 直接跳转的目标不是基本块入口时翻译失败。
+ */
+bool RegisterTranslator::translateJump(RegisterOpcode opcode, RegisterOpcode indirectOpcode, bool hasCondition) {
+    SymbolicOperand target = pop();
+    std::uint32_t conditionRegister = hasCondition ? toRegister(pop()) : 0;
+    if (target.kind == OperandKind::CONSTANT) {
+        if (target.value % 10 != 0 || target.value / 10 >= instructionList.size() || !blockEntryList[target.value / 10]) {
+            return false;
+        }
+        flush();
+        if (opcode == RegisterOpcode::CALL) {
+            // 直接调用的操作数为函数编号
+            if (functionIndexList[target.value / 10] == INVALID_FUNCTION_INDEX) {
+                return false;
+            }
+            emit(opcode, 0, 0, 0, functionIndexList[target.value / 10]);
+        } else {
+            emit(opcode, 0, conditionRegister, 0, target.value);
+        }
+    } else {
+        std::uint32_t targetRegister = toRegister(target);
+        flush();
+        if (hasCondition) {
+            emit(indirectOpcode, 0, conditionRegister, targetRegister, 0);
+        } else {
+            emit(indirectOpcode, 0, targetRegister, 0, 0);
+        }
+    }
+    return true;
+}
+
+RegisterCode *RegisterTranslator::translate(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, const std::vector<std::uint32_t> &functionIndexList) {
+    RegisterTranslator registerTranslator(instructionList, functionTable, functionIndexList);
+    registerTranslator.findBlockEntries();
+    if (!registerTranslator.translate()) {
+        delete registerTranslator.registerCode;
+        return nullptr;
+    }
+    registerTranslator.relocate();
+    return registerTranslator.registerCode;
+}
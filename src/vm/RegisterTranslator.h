@@ -0,0 +1,78 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include "DecodedInstruction.h"
+#include "../bytecode/Bytecode.h"
+#include "RegisterInstruction.h"
+
+/**
+ * 翻译得到的寄存器式代码。
+ * 寄存器文件的前constantList.size()个寄存器存放常量，其余为临时寄存器。
+ */
+struct RegisterCode {
+    static constexpr std::uint32_t INVALID_ENTRY = UINT32_MAX;
+    std::vector<RegisterInstruction> instructionList;
+    std::vector<std::uint32_t> entryIndexList; // 栈式指令索引到对应基本块入口的寄存器指令索引的映射，不是基本块入口的为INVALID_ENTRY
+    std::vector<std::uint32_t> functionEntryIndexList; // 函数编号到函数入口的寄存器指令索引的映射
+    std::vector<std::uint64_t> constantList; // 常量寄存器的值
+    std::uint32_t registerCount = 0; // 寄存器文件的大小
+};
+
+/**
+ * 将栈式指令翻译为寄存器式指令的翻译器。
+ * 以基本块为单位进行翻译，翻译时维护一个符号化的操作数栈，栈中的每一项是一个寄存器、常量或基地址偏移，
+ * 运算指令从符号栈中取出操作数并将结果分配到新的临时寄存器中，PUSH、FBP、COPY、SWAP、POP等搬运指令只改变符号栈而不产生指令。
+ * 在基本块的末尾（跳转、调用、返回之前，以及下一条指令是跳转目标时）将符号栈中剩余的项按顺序压入真实的操作数栈，
+ * 因此基本块之间、函数之间仍然通过操作数栈传递值，与栈式虚拟机的调用约定保持一致，已有的字节码文件不需要任何修改。
+ */
+class RegisterTranslator {
+private:
+    enum class OperandKind {
+        REGISTER,
+        CONSTANT,
+        BASE_OFFSET,
+    };
+
+    struct SymbolicOperand {
+        OperandKind kind;
+        std::uint64_t value; // 寄存器编号、常量值或相对于bp的偏移
+    };
+
+    static constexpr std::uint32_t TEMPORARY_FLAG = 0x80000000; // 翻译过程中临时寄存器编号的标记，翻译结束后重定位到常量寄存器之后
+
+    const std::vector<DecodedInstruction> &instructionList;
+    const std::vector<FunctionTableEntry> &functionTable;
+    const std::vector<std::uint32_t> &functionIndexList;
+    std::vector<bool> blockEntryList;
+    std::vector<SymbolicOperand> symbolicStack;
+    std::map<std::uint64_t, std::uint32_t> constantIndexMap;
+    std::uint32_t temporaryCount = 0; // 当前基本块已分配的临时寄存器数量
+    std::uint32_t maxTemporaryCount = 0;
+    RegisterCode *registerCode;
+
+private:
+    RegisterTranslator(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, const std::vector<std::uint32_t> &functionIndexList);
+    void findBlockEntries();
+    bool translate();
+    void relocate();
+    void emit(RegisterOpcode opcode, std::uint32_t destination, std::uint32_t source1, std::uint32_t source2, std::uint64_t immediate);
+    std::uint32_t allocateTemporary();
+    std::uint32_t constantRegister(std::uint64_t value);
+    std::uint32_t toRegister(const SymbolicOperand &operand);
+    SymbolicOperand pop();
+    void flush();
+    void translateBinary(RegisterOpcode opcode);
+    void translateUnary(RegisterOpcode opcode);
+    void translateLoad(RegisterOpcode opcode, RegisterOpcode baseOffsetOpcode);
+    void translateStore(RegisterOpcode opcode, RegisterOpcode baseOffsetOpcode);
+    void translateMemory(RegisterOpcode opcode);
+    bool translateJump(RegisterOpcode opcode, RegisterOpcode indirectOpcode, bool hasCondition);
+
+public:
+    /**
+     * 翻译失败（遇到不支持的指令）时返回nullptr，此时应使用栈式虚拟机执行。
+     */
+    static RegisterCode *translate(const std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable, const std::vector<std::uint32_t> &functionIndexList);
+};
@@ -0,0 +1,234 @@
+#include "SuperinstructionFuser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <initializer_list>
+
+SuperinstructionFuser::SuperinstructionFuser(std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable)
+        : instructionList(instructionList), functionTable(functionTable) {}
+
+void SuperinstructionFuser::findBlockEntries() {
+    blockEntryList.assign(instructionList.size(), false);
+    auto markEntry = [this](std::uint64_t address) {
+        if (address % 10 == 0 && address / 10 < instructionList.size()) {
+            blockEntryList[address / 10] = true;
+        }
+    };
+    markEntry(0);
+    for (const auto &function : functionTable) {
+        markEntry(function.address);
+    }
+    for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+        switch (instructionList[i].opcode) {
+            case Opcode::JMP:
+            case Opcode::JZ_64:
+            case Opcode::JNZ_64:
+            case Opcode::CALL:
+                if (i > 0 && instructionList[i - 1].opcode == Opcode::PUSH_64) {
+                    markEntry(instructionList[i - 1].operand);
+                }
+                markEntry((i + 1) * 10);
+                break;
+            case Opcode::JMP_IMM:
+            case Opcode::JZ_64_IMM:
+            case Opcode::JNZ_64_IMM:
+            case Opcode::BLT_I64:
+            case Opcode::BLT_U64:
+            case Opcode::BLT_F64:
+            case Opcode::BGT_I64:
+            case Opcode::BGT_U64:
+            case Opcode::BGT_F64:
+            case Opcode::BEQ_I64:
+            case Opcode::BEQ_U64:
+            case Opcode::BEQ_F64:
+            case Opcode::BGE_I64:
+            case Opcode::BGE_U64:
+            case Opcode::BGE_F64:
+            case Opcode::BLE_I64:
+            case Opcode::BLE_U64:
+            case Opcode::BLE_F64:
+            case Opcode::BNE_I64:
+            case Opcode::BNE_U64:
+            case Opcode::BNE_F64:
+            case Opcode::CALL_IMM:
+                markEntry(instructionList[i].operand);
+                markEntry((i + 1) * 10);
+                break;
+            case Opcode::RET:
+            case Opcode::HLT:
+                markEntry((i + 1) * 10);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool SuperinstructionFuser::isFusable(std::uint64_t index, std::uint64_t length) {
+    if (index + length > instructionList.size()) {
+        return false;
+    }
+    for (std::uint64_t i = index + 1; i < index + length; i++) {
+        if (blockEntryList[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SuperinstructionFuser::match(std::uint64_t index, std::initializer_list<Opcode> sequence) {
+    if (!isFusable(index, sequence.size())) {
+        return false;
+    }
+    for (auto opcode : sequence) {
+        if (instructionList[index++].opcode != opcode) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SuperinstructionFuser::fuse() {
+    std::uint64_t i = 0;
+    while (i < instructionList.size()) {
+        auto &instruction = instructionList[i];
+        std::uint64_t length = 1;
+        if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64})) {
+            // 局部变量的地址计算，操作数为相对于bp的偏移
+            if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::LOAD_I32})) {
+                instruction.opcode = Opcode::LOAD_LOCAL_I32;
+                length = 4;
+            } else if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::LOAD_I64})) {
+                instruction.opcode = Opcode::LOAD_LOCAL_I64;
+                length = 4;
+            } else if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::LOAD_U64})) {
+                instruction.opcode = Opcode::LOAD_LOCAL_U64;
+                length = 4;
+            } else if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::LOAD_F64})) {
+                instruction.opcode = Opcode::LOAD_LOCAL_F64;
+                length = 4;
+            } else if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::PUSH_64, Opcode::STORE_I32})) {
+                // 要存储的常量仍然保存在序列第4条指令的操作数中
+                instruction.opcode = Opcode::STORE_LOCAL_I32;
+                length = 5;
+            } else if (match(i, {Opcode::PUSH_64, Opcode::FBP, Opcode::ADD_U64, Opcode::PUSH_64, Opcode::STORE_I64})) {
+                instruction.opcode = Opcode::STORE_LOCAL_I64;
+                length = 5;
+            } else {
+                instruction.opcode = Opcode::LOCAL_ADDRESS;
+                length = 3;
+            }
+        } else if (match(i, {Opcode::STORE_I32, Opcode::LOAD_I32, Opcode::POP_64})) {
+            instruction.opcode = Opcode::STORE_POP_I32;
+            length = 3;
+        } else if (match(i, {Opcode::STORE_I64, Opcode::LOAD_I64, Opcode::POP_64})) {
+            instruction.opcode = Opcode::STORE_POP_I64;
+            length = 3;
+        } else if (match(i, {Opcode::GT_I64, Opcode::JZ_64_IMM})) {
+            instruction.opcode = Opcode::CMP_BRANCH_GT_I64;
+            instruction.operand = instructionList[i + 1].operand;
+            length = 2;
+        } else if (match(i, {Opcode::LT_I64, Opcode::JZ_64_IMM})) {
+            instruction.opcode = Opcode::CMP_BRANCH_LT_I64;
+            instruction.operand = instructionList[i + 1].operand;
+            length = 2;
+        } else if (match(i, {Opcode::EQ_I64, Opcode::JZ_64_IMM})) {
+            instruction.opcode = Opcode::CMP_BRANCH_EQ_I64;
+            instruction.operand = instructionList[i + 1].operand;
+            length = 2;
+        } else if (match(i, {Opcode::POP_64, Opcode::PUSH_64})) {
+            instruction.opcode = Opcode::POP_PUSH;
+            instruction.operand = instructionList[i + 1].operand;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BLT_I64})) {
+            // 跳转地址仍然保存在序列第2条指令的操作数中
+            instruction.opcode = Opcode::PUSH_BLT_I64;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BGT_I64})) {
+            instruction.opcode = Opcode::PUSH_BGT_I64;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BEQ_I64})) {
+            instruction.opcode = Opcode::PUSH_BEQ_I64;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BGE_I64})) {
+            instruction.opcode = Opcode::PUSH_BGE_I64;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BLE_I64})) {
+            instruction.opcode = Opcode::PUSH_BLE_I64;
+            length = 2;
+        } else if (match(i, {Opcode::PUSH_64, Opcode::BNE_I64})) {
+            instruction.opcode = Opcode::PUSH_BNE_I64;
+            length = 2;
+        }
+        // 被融合的其余指令不是基本块入口，不会被执行到，因此不再参与融合
+        i += length;
+    }
+}
+
+void SuperinstructionFuser::fuse(std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable) {
+    SuperinstructionFuser superinstructionFuser(instructionList, functionTable);
+    superinstructionFuser.findBlockEntries();
+    superinstructionFuser.fuse();
+}
+
+bool SuperinstructionFuser::printStatistics(const std::vector<std::string> &filePathList, std::uint64_t topCount, std::string &errorMessage) {
+    std::map<std::vector<Opcode>, std::uint64_t> countMap;
+    std::uint64_t instructionCount = 0;
+    for (const auto &filePath : filePathList) {
+        std::unique_ptr<std::ifstream> bytecodeFile = std::make_unique<std::ifstream>(filePath, std::ios::binary);
+        if (bytecodeFile->fail()) {
+            errorMessage = "bytecode file open failure: " + filePath;
+            return false;
+        }
+        std::unique_ptr<Bytecode> bytecode(Bytecode::build(std::move(bytecodeFile), errorMessage));
+        if (bytecode == nullptr) {
+            errorMessage = filePath + ": " + errorMessage;
+            return false;
+        }
+        const auto &codeArea = bytecode->getCodeArea();
+        std::vector<DecodedInstruction> instructionList(codeArea.size() / 10);
+        for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+            std::memcpy(&(instructionList[i].opcode), &codeArea[i * 10], sizeof(instructionList[i].opcode));
+            std::memcpy(&(instructionList[i].operand), &codeArea[i * 10 + 2], sizeof(instructionList[i].operand));
+        }
+        SuperinstructionFuser superinstructionFuser(instructionList, bytecode->getFunctionTable());
+        superinstructionFuser.findBlockEntries();
+        instructionCount += instructionList.size();
+        for (std::uint64_t i = 0; i < instructionList.size(); i++) {
+            std::vector<Opcode> sequence{instructionList[i].opcode};
+            for (std::uint64_t length = 2; length <= MAX_STATISTICS_LENGTH && superinstructionFuser.isFusable(i, length); length++) {
+                sequence.push_back(instructionList[i + length - 1].opcode);
+                countMap[sequence]++;
+            }
+        }
+    }
+    std::cout << "files: " << filePathList.size() << ", instructions: " << instructionCount << std::endl;
+    for (std::uint64_t length = 2; length <= MAX_STATISTICS_LENGTH; length++) {
+        std::vector<std::pair<std::uint64_t, std::vector<Opcode>>> sortedList;
+        for (const auto &[sequence, count] : countMap) {
+            if (sequence.size() == length) {
+                sortedList.emplace_back(count, sequence);
+            }
+        }
+        std::stable_sort(sortedList.begin(), sortedList.end(), [](const auto &left, const auto &right) {
+            return left.first > right.first;
+        });
+        std::cout << std::endl << "-----" << length << "-GRAMS-----" << std::endl;
+        for (std::uint64_t i = 0; i < sortedList.size() && i < topCount; i++) {
+            std::string text;
+            for (auto opcode : sortedList[i].second) {
+                if (!text.empty()) {
+                    text += ' ';
+                }
+                text += opcode2String(opcode);
+            }
+            double percentage = instructionCount == 0 ? 0 : 100.0 * static_cast<double>(sortedList[i].first) / static_cast<double>(instructionCount);
+            std::cout << std::setw(10) << std::left << sortedList[i].first << std::setw(10) << std::left << std::fixed << std::setprecision(2) << percentage << text << std::endl;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <initializer_list>
+#include "DecodedInstruction.h"
+#include "../bytecode/Bytecode.h"
+
+/**
+ * 超级指令融合器。
+ * 虚拟机加载字节码后，将代码生成器频繁产生的指令序列改写为一条超级指令，减少分派次数和操作数栈的读写。
+ * 融合只改写序列的第一条指令，超级指令执行完后直接跳过序列中的其余指令，其余指令保持不变，
+ * 因此只有序列中除第一条以外的指令都不是基本块入口时才能融合。
+ */
+class SuperinstructionFuser {
+private:
+    std::vector<DecodedInstruction> &instructionList;
+    const std::vector<FunctionTableEntry> &functionTable;
+    std::vector<bool> blockEntryList;
+
+private:
+    SuperinstructionFuser(std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable);
+    void findBlockEntries();
+    bool isFusable(std::uint64_t index, std::uint64_t length);
+    bool match(std::uint64_t index, std::initializer_list<Opcode> sequence);
+    void fuse();
+
+public:
+    static constexpr std::uint64_t MAX_STATISTICS_LENGTH = 4; // 统计的指令序列的最大长度
+
+    /**
+     * 对预解码的指令进行融合，融合后的指令只能由栈式执行引擎的解释器执行。
+     */
+    static void fuse(std::vector<DecodedInstruction> &instructionList, const std::vector<FunctionTableEntry> &functionTable);
+
+    /**
+     * 统计一组字节码文件中长度为2到MAX_STATISTICS_LENGTH的指令序列的出现次数，按次数从高到低输出前topCount个。
+     * 跨越基本块入口的序列无法融合，不计入统计。文件无法打开或者格式错误时不输出统计，返回false并将错误信息写入errorMessage。
+     */
+    static bool printStatistics(const std::vector<std::string> &filePathList, std::uint64_t topCount, std::string &errorMessage);
+};
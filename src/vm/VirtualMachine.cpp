@@ -2,629 +2,3551 @@
 
 #include <iostream>
 #include <cstring>
-#include "../error/ErrorHandler.h"
+#include <cmath>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
 
-VirtualMachine::VirtualMachine(Bytecode *bytecode) {
-    memoryUseMap = bytecode->getMemoryUseMap();
-    codeArea.insert(codeArea.end(), bytecode->getCodeArea().begin(), bytecode->getCodeArea().end());
-    dataArea.insert(dataArea.end(), bytecode->getDataArea().begin(), bytecode->getDataArea().end());
-    dataArea.insert(dataArea.end(), 1024 * 1024, 0);
-    pc = 0;
-    bp = 0;
-    callAddressStack.push(0);
+/*
+ * 解释器的检查策略。
+ * 安全版本在执行指令时检查操作数栈是否下溢、内存访问是否越界、除数是否为0以及跳转目标是否合法，用于执行不可信的程序；
+ * 快速版本不做这些检查。两个版本由同一个解释循环以不同的策略实例化得到，快速版本中的检查代码在编译时被if constexpr完全消除，
+ * 运行时只在启动时选择一次版本，解释循环中没有与策略相关的分支。
+ */
+struct FastPolicy {
+    static constexpr bool CHECKED = false;
+    static constexpr bool METERED = false;
+    static constexpr bool PROFILED = false;
+};
+
+struct SafePolicy {
+    static constexpr bool CHECKED = true;
+    static constexpr bool METERED = false;
+    static constexpr bool PROFILED = false;
+};
+
+/*
+ * 计量燃料的策略，在检查策略的基础上在往后跳转、函数调用和内存块操作时消耗燃料。
+ * 只有设置了燃料或执行时间的上限时才使用，不限制时的解释循环中没有计量代码。
+ */
+template<typename Policy>
+struct MeteredPolicy : Policy {
+    static constexpr bool METERED = true;
+};
+
+/*
+ * 统计操作码的策略，在计量策略的基础上每次分派指令时都调用OpcodeProfiler::record。
+ * 与检查策略一样以单独的实例化实现，不统计时的解释循环不受影响。
+ */
+template<typename Policy>
+struct ProfilingPolicy : MeteredPolicy<Policy> {
+    static constexpr bool PROFILED = true;
+};
+
+/*
+ * 32位有符号除法和取模。
+ * INT_MIN / -1的商按补码回绕为INT_MIN，INT_MIN % -1的余数为0，与按64位运算后再截断为32位的结果相同，
+ * 直接执行32位的除法则会溢出，使宿主进程收到SIGFPE。两个版本以及寄存器式执行引擎都这样处理，安全版本也不报错。
+ */
+static std::int32_t divideI32(std::int32_t leftValue, std::int32_t rightValue) {
+    if (rightValue == -1) {
+        return static_cast<std::int32_t>(0u - static_cast<std::uint32_t>(leftValue));
+    }
+    return leftValue / rightValue;
+}
+
+static std::int32_t remainderI32(std::int32_t leftValue, std::int32_t rightValue) {
+    if (rightValue == -1) {
+        return 0;
+    }
+    return leftValue % rightValue;
+}
+
+#define VM_CHECK_OPERANDS(count) do { if constexpr (Policy::CHECKED) { if (sp - operandStackBegin < (count)) { reportOperandStackUnderflow(); goto LABEL_EXIT; } } } while (false)
+#define VM_CHECK_ADDRESS(address, byteCount) do { if constexpr (Policy::CHECKED) { if (dataArea.available(address) < (byteCount)) { reportInvalidAddress(address); goto LABEL_EXIT; } } } while (false)
+#define VM_CHECK_STRING(address) do { if constexpr (Policy::CHECKED) { if (dataArea.available(address) == 0 || std::memchr(&dataArea[address], 0, dataArea.available(address)) == nullptr) { reportInvalidAddress(address); goto LABEL_EXIT; } } } while (false)
+#define VM_CHECK_DIVISOR(value) do { if constexpr (Policy::CHECKED) { if ((value) == 0) { fail("division by zero"); goto LABEL_EXIT; } } } while (false)
+#define VM_CHECK_SIGNED_DIVISION(leftValue, rightValue) do { if constexpr (Policy::CHECKED) { if ((leftValue) == std::numeric_limits<decltype(leftValue)>::min() && (rightValue) == -1) { fail("integer overflow in division"); goto LABEL_EXIT; } } } while (false)
+#define VM_CHECK_JUMP_TARGET(address) do { if constexpr (Policy::CHECKED) { if ((address) % 10 != 0 || (address) / 10 >= instructionList->size()) { reportInvalidJumpTarget(address); goto LABEL_EXIT; } } } while (false)
+
+/*
+ * 内存块操作的范围检查。
+ * 块的长度由程序在运行时给出，一次越界就可能覆盖保护区之外的任意宿主内存，因此两个版本以及寄存器式执行引擎都检查，
+ * 与复制本身相比检查的开销可以忽略。
+ */
+#define VM_REQUIRE_RANGE(address, byteCount) do { if (dataArea.available(address) < (byteCount)) { reportInvalidAddress(address); goto LABEL_EXIT; } } while (false)
+
+/*
+ * 燃料计量。
+ * 不往后跳转也不调用函数的指令序列总会执行完，因此只在往后跳转和函数调用时消耗燃料，
+ * 回跳消耗所跨越的指令数，调用消耗被调用函数的静态指令数，燃料因此是一个抽象的计量单位，而不是实际执行的指令数。
+ * 燃料按片发放，当前片用完时才检查总的燃料和执行时间，燃料不足时停止执行，
+ * 此时pc指向尚未执行的跳转或调用指令，其他状态也都已保存，可以从该指令继续执行。
+ */
+#define VM_CHARGE_FUEL(cost) do { if constexpr (Policy::METERED) { if (fuel < (cost)) { this->fuel = fuel; bool refueled = refuel(cost); fuel = this->fuel; if (!refueled) { pc = instruction - base; goto LABEL_EXIT; } } fuel -= (cost); } } while (false)
+#define VM_BACKWARD_JUMP_COST(address) ((address) / 10 <= static_cast<std::uint64_t>(instruction - base) ? static_cast<std::uint64_t>(instruction - base) - (address) / 10 + 1 : 0)
+
+#define VM_PROFILE() do { if constexpr (Policy::PROFILED) { opcodeProfiler->record(instruction->opcode); } } while (false)
+
+#if VM_COMPUTED_GOTO
+#define VM_CASE(name) LABEL_##name:
+#define VM_REGISTER_CASE(name) LABEL_##name:
+#define VM_DISPATCH() do { instruction = next++; VM_PROFILE(); goto *instruction->handler; } while (false)
+#define VM_REGISTER_DISPATCH() do { instruction = next++; goto *instruction->handler; } while (false)
+#else
+#define VM_CASE(name) case Opcode::name:
+#define VM_REGISTER_CASE(name) case RegisterOpcode::name:
+#define VM_DISPATCH() continue
+#define VM_REGISTER_DISPATCH() continue
+#endif
+
+VirtualMachine::VirtualMachine(std::shared_ptr<const ProgramImage> programImage, std::istream &input, std::ostream &output)
+        : image(std::move(programImage)), functionTable(image->getFunctionTable()), functionFuelCostList(image->getFunctionFuelCostList()),
+          instructionList(&image->getInstructionList()), registerCode(image->getRegisterCode()), pc(0), bp(0), sp(0), callDepth(0),
+          fuelLimit(image->getConfig().fuel), fuel(0), fuelSliceSize(0), timeLimit(image->getConfig().timeLimit), variant(image->getConfig().variant),
+          inputReader(input), outputBuffer(output, image->getConfig().lineBufferedOutput), finished(false) {
+    const auto &config = image->getConfig();
+    if (!image->getErrorMessage().empty()) {
+        fail(image->getErrorMessage());
+        return;
+    }
+    // 被调用函数的bp等于调用者的bp加上调用者的内存使用大小，两个栈帧都可能越过数据区末尾，保护区至少要容纳两个最大的栈帧
+    std::string errorMessage;
+    if (!dataArea.allocate(image->getInitialData(), config.memorySize, 2 * image->getMaxFrameSize(), config.heapSize, errorMessage)) {
+        fail(errorMessage);
+        return;
+    }
+    heap.initialize(dataArea.getHeapBegin(), dataArea.getHeapSize());
+    if (!operandStack.allocate(config.operandStackCapacity) || !callFrameStack.allocate(config.maxCallDepth + 1)) {
+        fail("failed to allocate the operand stack and the call stack");
+        return;
+    }
+#if VM_COMPUTED_GOTO && VM_JIT_SUPPORTED
+    if (image->isJitEnabled()) {
+        jitInstructionList = image->getInstructionList();
+        instructionList = &jitInstructionList;
+        jitCompiler = std::make_unique<JitCompiler>(jitInstructionList, functionTable, config.jitThreshold);
+    }
+#endif
+    if (config.opcodeProfile) {
+        opcodeProfiler = std::make_unique<OpcodeProfiler>();
+    }
+    if (registerCode != nullptr) {
+        registerFile.resize(registerCode->registerCount, OperandStackUnit(static_cast<std::uint64_t>(0)));
+        for (std::uint64_t i = 0; i < registerCode->constantList.size(); i++) {
+            registerFile[i] = OperandStackUnit(static_cast<std::uint64_t>(registerCode->constantList[i]));
+        }
+    }
+}
+
+void VirtualMachine::fail(const std::string &message) {
+    exitStatus.reason = ExitReason::ERROR;
+    exitStatus.errorMessage = message;
+    finished = true;
+}
+
+void VirtualMachine::reportOperandStackOverflow() {
+    fail("operand stack overflow, capacity: " + std::to_string(operandStack.size()));
+}
+
+void VirtualMachine::reportOperandStackUnderflow() {
+    fail("operand stack underflow");
+}
+
+void VirtualMachine::reportInvalidAddress(std::uint64_t address) {
+    fail("invalid memory address: " + std::to_string(address) + ", memory size: " + std::to_string(dataArea.size()));
+}
+
+void VirtualMachine::reportInvalidHeapAddress(std::uint64_t address) {
+    fail("invalid heap block address: " + std::to_string(address));
+}
+
+void VirtualMachine::reportInvalidFunctionAddress(std::uint64_t address) {
+    fail("invalid function address: " + std::to_string(address));
 }
 
-void VirtualMachine::run() {
+void VirtualMachine::reportInvalidJumpTarget(std::uint64_t address) {
+    fail("invalid jump target: " + std::to_string(address));
+}
+
+void VirtualMachine::reportCallStackOverflow() {
+    fail("stack overflow at depth " + std::to_string(callFrameStack.size() - 1));
+}
+
+std::uint32_t VirtualMachine::registerEntryIndex(std::uint64_t address) {
+    if (address % 10 != 0 || address / 10 >= registerCode->entryIndexList.size()) {
+        return RegisterCode::INVALID_ENTRY;
+    }
+    return registerCode->entryIndexList[address / 10];
+}
+
+bool VirtualMachine::refuel(std::uint64_t cost) {
+    exitStatus.fuelUsed += fuelSliceSize - fuel;
+    fuelSliceSize = 0;
+    fuel = 0;
+    if (timeLimit != 0 && std::chrono::steady_clock::now() >= deadline) {
+        exitStatus.reason = ExitReason::DEADLINE_EXCEEDED;
+        return false;
+    }
+    std::uint64_t remaining = fuelLimit == 0 ? UINT64_MAX : fuelLimit - exitStatus.fuelUsed;
+    if (remaining < cost) {
+        exitStatus.reason = ExitReason::FUEL_EXHAUSTED;
+        return false;
+    }
+    fuelSliceSize = std::min(remaining, std::max(FUEL_SLICE_SIZE, cost));
+    fuel = fuelSliceSize;
+    return true;
+}
+
+template<typename Policy>
+void VirtualMachine::interpret() {
+    const DecodedInstruction *base = instructionList->data();
+    const DecodedInstruction *next = base + pc;
+    const DecodedInstruction *instruction;
+    OperandStackUnit *operandStackBegin = operandStack.data();
+    OperandStackUnit *sp = operandStack.data() + this->sp; // 指向栈顶元素的下一个位置
+    OperandStackUnit *operandStackEnd = operandStack.data() + operandStack.size();
+    CallFrame *frame = callFrameStack.data() + callDepth; // 指向当前栈帧
+    CallFrame *callFrameStackEnd = callFrameStack.data() + callFrameStack.size();
+    std::uint64_t fuel = this->fuel; // 当前燃料片中剩余的燃料
+#if VM_COMPUTED_GOTO
+    // 处理代码的地址只能在本函数内获取，因此在第一次运行时将其填入预解码的指令的副本中，由同一个映像创建的实例对每个实例化只填写一次
+    static const void *const handlerTable[] = {
+                &&LABEL_INVALID,
+                &&LABEL_ADD_I64,
+                &&LABEL_ADD_U64,
+                &&LABEL_ADD_F64,
+                &&LABEL_SUB_I64,
+                &&LABEL_SUB_U64,
+                &&LABEL_SUB_F64,
+                &&LABEL_MUL_I64,
+                &&LABEL_MUL_U64,
+                &&LABEL_MUL_F64,
+                &&LABEL_DIV_I64,
+                &&LABEL_DIV_U64,
+                &&LABEL_DIV_F64,
+                &&LABEL_MOD_I64,
+                &&LABEL_MOD_U64,
+                &&LABEL_NEG_I64,
+                &&LABEL_NEG_F64,
+                &&LABEL_SL_I64,
+                &&LABEL_SL_U64,
+                &&LABEL_SR_I64,
+                &&LABEL_SR_U64,
+                &&LABEL_AND_64,
+                &&LABEL_OR_64,
+                &&LABEL_NOT_64,
+                &&LABEL_XOR_64,
+                &&LABEL_TB_64,
+                &&LABEL_GT_I64,
+                &&LABEL_GT_U64,
+                &&LABEL_GT_F64,
+                &&LABEL_LT_I64,
+                &&LABEL_LT_U64,
+                &&LABEL_LT_F64,
+                &&LABEL_EQ_I64,
+                &&LABEL_EQ_U64,
+                &&LABEL_EQ_F64,
+                &&LABEL_CAST_I64_U64,
+                &&LABEL_CAST_I64_F64,
+                &&LABEL_CAST_U64_I64,
+                &&LABEL_CAST_U64_F64,
+                &&LABEL_CAST_F64_I64,
+                &&LABEL_CAST_F64_U64,
+                &&LABEL_JMP,
+                &&LABEL_JZ_64,
+                &&LABEL_JNZ_64,
+                &&LABEL_LOAD_I8,
+                &&LABEL_LOAD_I16,
+                &&LABEL_LOAD_I32,
+                &&LABEL_LOAD_I64,
+                &&LABEL_LOAD_U8,
+                &&LABEL_LOAD_U16,
+                &&LABEL_LOAD_U32,
+                &&LABEL_LOAD_U64,
+                &&LABEL_LOAD_F32,
+                &&LABEL_LOAD_F64,
+                &&LABEL_STORE_I8,
+                &&LABEL_STORE_I16,
+                &&LABEL_STORE_I32,
+                &&LABEL_STORE_I64,
+                &&LABEL_STORE_U8,
+                &&LABEL_STORE_U16,
+                &&LABEL_STORE_U32,
+                &&LABEL_STORE_U64,
+                &&LABEL_STORE_F32,
+                &&LABEL_STORE_F64,
+                &&LABEL_IN_I64,
+                &&LABEL_IN_U64,
+                &&LABEL_IN_F64,
+                &&LABEL_IN_S,
+                &&LABEL_OUT_I64,
+                &&LABEL_OUT_U64,
+                &&LABEL_OUT_F64,
+                &&LABEL_OUT_S,
+                &&LABEL_CALL,
+                &&LABEL_RET,
+                &&LABEL_PUSH_64,
+                &&LABEL_POP_64,
+                &&LABEL_COPY_64,
+                &&LABEL_SWAP_64,
+                &&LABEL_FBP,
+                &&LABEL_HLT,
+                &&LABEL_JMP_IMM,
+                &&LABEL_JZ_64_IMM,
+                &&LABEL_JNZ_64_IMM,
+                &&LABEL_CALL_IMM,
+                &&LABEL_MEMCPY,
+                &&LABEL_MEMSET,
+                &&LABEL_MEMCMP,
+                &&LABEL_SQRT_F64,
+                &&LABEL_FABS_F64,
+                &&LABEL_FLOOR_F64,
+                &&LABEL_CEIL_F64,
+                &&LABEL_POW_F64,
+                &&LABEL_EXP_F64,
+                &&LABEL_LOG_F64,
+                &&LABEL_SIN_F64,
+                &&LABEL_COS_F64,
+                &&LABEL_MALLOC,
+                &&LABEL_FREE,
+                &&LABEL_REALLOC,
+                &&LABEL_ADD_I64_IMM,
+                &&LABEL_ADD_U64_IMM,
+                &&LABEL_ADD_F64_IMM,
+                &&LABEL_SUB_I64_IMM,
+                &&LABEL_SUB_U64_IMM,
+                &&LABEL_SUB_F64_IMM,
+                &&LABEL_MUL_I64_IMM,
+                &&LABEL_MUL_U64_IMM,
+                &&LABEL_MUL_F64_IMM,
+                &&LABEL_DIV_I64_IMM,
+                &&LABEL_DIV_U64_IMM,
+                &&LABEL_DIV_F64_IMM,
+                &&LABEL_MOD_I64_IMM,
+                &&LABEL_MOD_U64_IMM,
+                &&LABEL_SL_I64_IMM,
+                &&LABEL_SL_U64_IMM,
+                &&LABEL_SR_I64_IMM,
+                &&LABEL_SR_U64_IMM,
+                &&LABEL_AND_64_IMM,
+                &&LABEL_OR_64_IMM,
+                &&LABEL_XOR_64_IMM,
+                &&LABEL_GT_I64_IMM,
+                &&LABEL_GT_U64_IMM,
+                &&LABEL_GT_F64_IMM,
+                &&LABEL_LT_I64_IMM,
+                &&LABEL_LT_U64_IMM,
+                &&LABEL_LT_F64_IMM,
+                &&LABEL_EQ_I64_IMM,
+                &&LABEL_EQ_U64_IMM,
+                &&LABEL_EQ_F64_IMM,
+                &&LABEL_BLT_I64,
+                &&LABEL_BLT_U64,
+                &&LABEL_BLT_F64,
+                &&LABEL_BGT_I64,
+                &&LABEL_BGT_U64,
+                &&LABEL_BGT_F64,
+                &&LABEL_BEQ_I64,
+                &&LABEL_BEQ_U64,
+                &&LABEL_BEQ_F64,
+                &&LABEL_BGE_I64,
+                &&LABEL_BGE_U64,
+                &&LABEL_BGE_F64,
+                &&LABEL_BLE_I64,
+                &&LABEL_BLE_U64,
+                &&LABEL_BLE_F64,
+                &&LABEL_BNE_I64,
+                &&LABEL_BNE_U64,
+                &&LABEL_BNE_F64,
+                &&LABEL_ADD_I32,
+                &&LABEL_ADD_U32,
+                &&LABEL_ADD_F32,
+                &&LABEL_SUB_I32,
+                &&LABEL_SUB_U32,
+                &&LABEL_SUB_F32,
+                &&LABEL_MUL_I32,
+                &&LABEL_MUL_U32,
+                &&LABEL_MUL_F32,
+                &&LABEL_DIV_I32,
+                &&LABEL_DIV_U32,
+                &&LABEL_DIV_F32,
+                &&LABEL_MOD_I32,
+                &&LABEL_MOD_U32,
+                &&LABEL_NEG_I32,
+                &&LABEL_NEG_F32,
+                &&LABEL_SL_I32,
+                &&LABEL_SL_U32,
+                &&LABEL_SR_I32,
+                &&LABEL_SR_U32,
+                &&LABEL_ADD_I32_IMM,
+                &&LABEL_ADD_U32_IMM,
+                &&LABEL_ADD_F32_IMM,
+                &&LABEL_SUB_I32_IMM,
+                &&LABEL_SUB_U32_IMM,
+                &&LABEL_SUB_F32_IMM,
+                &&LABEL_MUL_I32_IMM,
+                &&LABEL_MUL_U32_IMM,
+                &&LABEL_MUL_F32_IMM,
+                &&LABEL_DIV_I32_IMM,
+                &&LABEL_DIV_U32_IMM,
+                &&LABEL_DIV_F32_IMM,
+                &&LABEL_MOD_I32_IMM,
+                &&LABEL_MOD_U32_IMM,
+                &&LABEL_SL_I32_IMM,
+                &&LABEL_SL_U32_IMM,
+                &&LABEL_SR_I32_IMM,
+                &&LABEL_SR_U32_IMM,
+                &&LABEL_LOCAL_ADDRESS,
+                &&LABEL_LOAD_LOCAL_I32,
+                &&LABEL_LOAD_LOCAL_I64,
+                &&LABEL_LOAD_LOCAL_U64,
+                &&LABEL_LOAD_LOCAL_F64,
+                &&LABEL_STORE_LOCAL_I32,
+                &&LABEL_STORE_LOCAL_I64,
+                &&LABEL_STORE_POP_I32,
+                &&LABEL_STORE_POP_I64,
+                &&LABEL_CMP_BRANCH_GT_I64,
+                &&LABEL_CMP_BRANCH_LT_I64,
+                &&LABEL_CMP_BRANCH_EQ_I64,
+                &&LABEL_POP_PUSH,
+                &&LABEL_PUSH_BLT_I64,
+                &&LABEL_PUSH_BGT_I64,
+                &&LABEL_PUSH_BEQ_I64,
+                &&LABEL_PUSH_BGE_I64,
+                &&LABEL_PUSH_BLE_I64,
+                &&LABEL_PUSH_BNE_I64,
+    };
+    static_assert(sizeof(handlerTable) / sizeof(handlerTable[0]) == static_cast<std::size_t>(Opcode::PUSH_BNE_I64) + 1);
+    const void *invalidHandler = &&LABEL_INVALID;
+    auto bindHandlers = [invalidHandler](std::vector<DecodedInstruction> &instructionList) {
+        for (auto &decodedInstruction : instructionList) {
+            auto opcodeValue = static_cast<std::size_t>(decodedInstruction.opcode);
+            decodedInstruction.handler = opcodeValue < sizeof(handlerTable) / sizeof(handlerTable[0]) ? handlerTable[opcodeValue] : invalidHandler;
+        }
+    };
+    if (jitCompiler == nullptr) {
+        instructionList = &image->bindHandlers(handlerTable, bindHandlers);
+        base = instructionList->data();
+        next = base + pc;
+    } else if (!jitInstructionList.empty() && jitInstructionList.front().handler == nullptr) {
+        // 启用JIT时每个实例使用自己的指令副本，计数点的处理代码替换为计数代码
+        bindHandlers(jitInstructionList);
+        for (auto index : jitCompiler->createCountPointList()) {
+            jitInstructionList[index].handler = &&LABEL_JIT_COUNT;
+        }
+    }
+    VM_DISPATCH();
+#else
     while (true) {
-        Instruction instruction(Opcode::HLT);
-        std::memcpy(&(instruction.opcode), &codeArea[pc], sizeof(instruction.opcode));
-        std::memcpy(&(instruction.operand), &codeArea[pc + 2], sizeof(instruction.operand));
-        pc += 10;
-        switch (instruction.opcode) {
-            case Opcode::ADD_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue + rightValue));
-                break;
-            }
-            case Opcode::ADD_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue + rightValue));
-                break;
-            }
-            case Opcode::ADD_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(leftValue + rightValue));
-                break;
-            }
-            case Opcode::SUB_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue - rightValue));
-                break;
-            }
-            case Opcode::SUB_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue - rightValue));
-                break;
-            }
-            case Opcode::SUB_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(leftValue - rightValue));
-                break;
-            }
-            case Opcode::MUL_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue * rightValue));
-                break;
-            }
-            case Opcode::MUL_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue * rightValue));
-                break;
-            }
-            case Opcode::MUL_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(leftValue * rightValue));
-                break;
-            }
-            case Opcode::DIV_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue / rightValue));
-                break;
-            }
-            case Opcode::DIV_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue / rightValue));
-                break;
-            }
-            case Opcode::DIV_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(leftValue / rightValue));
-                break;
-            }
-            case Opcode::MOD_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue % rightValue));
-                break;
-            }
-            case Opcode::MOD_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue % rightValue));
-                break;
-            }
-            case Opcode::NEG_I64: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(-value));
-                break;
-            }
-            case Opcode::NEG_F64: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(-value));
-                break;
-            }
-            case Opcode::SL_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue << rightValue));
-                break;
-            }
-            case Opcode::SL_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue << rightValue));
-                break;
-            }
-            case Opcode::SR_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(leftValue >> rightValue));
-                break;
-            }
-            case Opcode::SR_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue >> rightValue));
-                break;
-            }
-            case Opcode::AND_64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue & rightValue));
-                break;
-            }
-            case Opcode::OR_64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue | rightValue));
-                break;
-            }
-            case Opcode::NOT_64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(~value));
-                break;
-            }
-            case Opcode::XOR_64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue ^ rightValue));
-                break;
-            }
-            case Opcode::TB_64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(value != static_cast<std::uint64_t>(0)));
-                break;
-            }
-            case Opcode::GT_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue > rightValue));
-                break;
-            }
-            case Opcode::GT_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue > rightValue));
-                break;
-            }
-            case Opcode::GT_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue > rightValue));
-                break;
-            }
-            case Opcode::LT_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue < rightValue));
-                break;
-            }
-            case Opcode::LT_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue < rightValue));
-                break;
-            }
-            case Opcode::LT_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue < rightValue));
-                break;
-            }
-            case Opcode::EQ_I64: {
-                auto rightValue = operandStack.top().i64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue == rightValue));
-                break;
-            }
-            case Opcode::EQ_U64: {
-                auto rightValue = operandStack.top().u64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue == rightValue));
-                break;
-            }
-            case Opcode::EQ_F64: {
-                auto rightValue = operandStack.top().f64;
-                operandStack.pop();
-                auto leftValue = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(leftValue == rightValue));
-                break;
-            }
-            case Opcode::CAST_I64_U64: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(value));
-                break;
-            }
-            case Opcode::CAST_I64_F64: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(value));
-                break;
-            }
-            case Opcode::CAST_U64_I64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(value));
-                break;
-            }
-            case Opcode::CAST_U64_F64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<double>(value));
-                break;
-            }
-            case Opcode::CAST_F64_I64: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::int64_t>(value));
-                break;
-            }
-            case Opcode::CAST_F64_U64: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(value));
-                break;
-            }
-            case Opcode::JMP: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                pc = address;
-                break;
-            }
-            case Opcode::JZ_64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                auto value = operandStack.top().u64;
-                operandStack.pop();
+        instruction = next++;
+        VM_PROFILE();
+        switch (instruction->opcode) {
+#endif
+            VM_CASE(ADD_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                VM_CHECK_SIGNED_DIVISION(leftValue, rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                VM_CHECK_SIGNED_DIVISION(leftValue, rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue % rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue % rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(NEG_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(-value));
+                VM_DISPATCH();
+            }
+            VM_CASE(NEG_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(-value));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue << rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue << rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(leftValue >> rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue >> rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(AND_64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue & rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(OR_64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue | rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(NOT_64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(~value));
+                VM_DISPATCH();
+            }
+            VM_CASE(XOR_64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue ^ rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(TB_64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value != static_cast<std::uint64_t>(0)));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                sp--;
+                auto leftValue = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                sp--;
+                auto leftValue = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_I64_U64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_I64_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].i64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_U64_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_U64_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_F64_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(CAST_F64_U64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(JMP) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                VM_CHECK_JUMP_TARGET(address);
+                VM_CHARGE_FUEL(VM_BACKWARD_JUMP_COST(address));
+                sp--;
+                next = base + address / 10;
+                VM_DISPATCH();
+            }
+            VM_CASE(JZ_64) {
+                VM_CHECK_OPERANDS(2);
+                auto address = sp[-1].u64;
+                auto value = sp[-2].u64;
+                VM_CHECK_JUMP_TARGET(address);
                 if (value == static_cast<std::uint64_t>(0)) {
-                    pc = address;
+                    VM_CHARGE_FUEL(VM_BACKWARD_JUMP_COST(address));
+                    next = base + address / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(JNZ_64) {
+                VM_CHECK_OPERANDS(2);
+                auto address = sp[-1].u64;
+                auto value = sp[-2].u64;
+                VM_CHECK_JUMP_TARGET(address);
+                if (value != static_cast<std::uint64_t>(0)) {
+                    VM_CHARGE_FUEL(VM_BACKWARD_JUMP_COST(address));
+                    next = base + address / 10;
                 }
-                break;
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(JMP_IMM) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHARGE_FUEL(instruction->fuelCost);
+                next = base + instruction->operand / 10;
+                VM_DISPATCH();
+            }
+            VM_CASE(JZ_64_IMM) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                if (value == static_cast<std::uint64_t>(0)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp--;
+                VM_DISPATCH();
             }
-            case Opcode::JNZ_64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                auto value = operandStack.top().u64;
-                operandStack.pop();
+            VM_CASE(JNZ_64_IMM) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
                 if (value != static_cast<std::uint64_t>(0)) {
-                    pc = address;
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_I8) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::int8_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_I16) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::int16_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_I32) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::int32_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::int64_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_U8) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::uint8_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_U16) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::uint16_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_U32) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::uint32_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_U64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                std::uint64_t loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_F32) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                float loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<double>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                double loadValue;
+                VM_CHECK_ADDRESS(address, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<double>(loadValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_I8) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int8_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_I16) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int16_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int32_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_I64) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int64_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_U8) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].u64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::uint8_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_U16) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].u64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::uint16_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].u64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::uint32_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_U64) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].u64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::uint64_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_F32) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].f64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<float>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto value = sp[-1].f64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<double>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(IN_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                outputBuffer.flush();
+                auto input = inputReader.readI64();
+                VM_CHECK_ADDRESS(address, sizeof(input));
+                std::memcpy(&dataArea[address], &input, sizeof(input));
+                VM_DISPATCH();
+            }
+            VM_CASE(IN_U64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                outputBuffer.flush();
+                auto input = inputReader.readU64();
+                VM_CHECK_ADDRESS(address, sizeof(input));
+                std::memcpy(&dataArea[address], &input, sizeof(input));
+                VM_DISPATCH();
+            }
+            VM_CASE(IN_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                outputBuffer.flush();
+                auto input = inputReader.readF64();
+                VM_CHECK_ADDRESS(address, sizeof(input));
+                std::memcpy(&dataArea[address], &input, sizeof(input));
+                VM_DISPATCH();
+            }
+            VM_CASE(IN_S) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                VM_CHECK_ADDRESS(address, 1);
+                outputBuffer.flush();
+                inputReader.readLine(reinterpret_cast<char *>(&dataArea[address]), dataArea.available(address));
+                VM_DISPATCH();
+            }
+            VM_CASE(OUT_I64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].i64;
+                sp--;
+                outputBuffer.writeI64(value);
+                VM_DISPATCH();
+            }
+            VM_CASE(OUT_U64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].u64;
+                sp--;
+                outputBuffer.writeU64(value);
+                VM_DISPATCH();
+            }
+            VM_CASE(OUT_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                outputBuffer.writeF64(value);
+                VM_DISPATCH();
+            }
+            VM_CASE(OUT_S) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                sp--;
+                VM_CHECK_STRING(address);
+                outputBuffer.writeString(reinterpret_cast<const char *>(&dataArea[address]));
+                VM_DISPATCH();
+            }
+            VM_CASE(CALL) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                if (frame + 1 == callFrameStackEnd) {
+                    reportCallStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                auto calleeIndex = image->functionIndex(address);
+                if (calleeIndex == INVALID_FUNCTION_INDEX) {
+                    reportInvalidFunctionAddress(address);
+                    goto LABEL_EXIT;
+                }
+                VM_CHARGE_FUEL(functionFuelCostList[calleeIndex]);
+                sp--;
+                auto callerFrameSize = functionTable[frame->functionIndex].frameSize;
+                frame++;
+                *frame = {static_cast<std::uint64_t>(next - base), bp, calleeIndex};
+                bp += callerFrameSize;
+                next = base + address / 10;
+                VM_DISPATCH();
+            }
+            VM_CASE(CALL_IMM) {
+                if (frame + 1 == callFrameStackEnd) {
+                    reportCallStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                auto calleeIndex = instruction->functionIndex;
+                VM_CHARGE_FUEL(functionFuelCostList[calleeIndex]);
+                auto callerFrameSize = functionTable[frame->functionIndex].frameSize;
+                frame++;
+                *frame = {static_cast<std::uint64_t>(next - base), bp, calleeIndex};
+                bp += callerFrameSize;
+                next = base + functionTable[calleeIndex].address / 10;
+                VM_DISPATCH();
+            }
+            VM_CASE(MEMCPY) {
+                VM_CHECK_OPERANDS(3);
+                auto size = sp[-1].u64;
+                auto source = sp[-2].u64;
+                auto destination = sp[-3].u64;
+                VM_REQUIRE_RANGE(source, size);
+                VM_REQUIRE_RANGE(destination, size);
+                VM_CHARGE_FUEL(size / BLOCK_FUEL_BYTES);
+                sp -= 3;
+                std::memmove(&dataArea[destination], &dataArea[source], size);
+                VM_DISPATCH();
+            }
+            VM_CASE(MEMSET) {
+                VM_CHECK_OPERANDS(3);
+                auto size = sp[-1].u64;
+                auto value = sp[-2].u64;
+                auto destination = sp[-3].u64;
+                VM_REQUIRE_RANGE(destination, size);
+                VM_CHARGE_FUEL(size / BLOCK_FUEL_BYTES);
+                sp -= 3;
+                std::memset(&dataArea[destination], static_cast<unsigned char>(value), size);
+                VM_DISPATCH();
+            }
+            VM_CASE(MEMCMP) {
+                VM_CHECK_OPERANDS(3);
+                auto size = sp[-1].u64;
+                auto rightAddress = sp[-2].u64;
+                auto leftAddress = sp[-3].u64;
+                VM_REQUIRE_RANGE(leftAddress, size);
+                VM_REQUIRE_RANGE(rightAddress, size);
+                VM_CHARGE_FUEL(size / BLOCK_FUEL_BYTES);
+                sp -= 2;
+                auto result = size == 0 ? 0 : std::memcmp(&dataArea[leftAddress], &dataArea[rightAddress], size);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>((result > 0) - (result < 0)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SQRT_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::sqrt(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(FABS_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::fabs(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(FLOOR_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::floor(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(CEIL_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::ceil(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(POW_F64) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                sp--;
+                auto leftValue = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::pow(leftValue, rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(EXP_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::exp(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOG_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::log(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SIN_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::sin(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(COS_F64) {
+                VM_CHECK_OPERANDS(1);
+                auto value = sp[-1].f64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(std::cos(value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MALLOC) {
+                VM_CHECK_OPERANDS(1);
+                auto size = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(heap.allocate(size)));
+                VM_DISPATCH();
+            }
+            VM_CASE(FREE) {
+                VM_CHECK_OPERANDS(1);
+                auto address = sp[-1].u64;
+                if (!heap.release(address)) {
+                    reportInvalidHeapAddress(address);
+                    goto LABEL_EXIT;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(REALLOC) {
+                VM_CHECK_OPERANDS(2);
+                auto size = sp[-1].u64;
+                auto address = sp[-2].u64;
+                VM_CHARGE_FUEL(size / BLOCK_FUEL_BYTES);
+                std::uint64_t result;
+                if (!heap.reallocate(address, size, dataArea.data(), result)) {
+                    reportInvalidHeapAddress(address);
+                    goto LABEL_EXIT;
+                }
+                sp--;
+                sp[-1] = OperandStackUnit(result);
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                VM_CHECK_DIVISOR(rightValue);
+                VM_CHECK_SIGNED_DIVISION(leftValue, rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                VM_CHECK_DIVISOR(rightValue);
+                VM_CHECK_SIGNED_DIVISION(leftValue, rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue % rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue % rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue << rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue << rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(leftValue >> rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue >> rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(AND_64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue & rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(OR_64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue | rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(XOR_64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue ^ rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(GT_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(LT_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_I64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_U64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand;
+                auto leftValue = sp[-1].u64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(EQ_F64_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = std::bit_cast<double>(instruction->operand);
+                auto leftValue = sp[-1].f64;
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(BLT_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue < rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BLT_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (leftValue < rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BLT_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (leftValue < rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGT_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue > rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGT_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (leftValue > rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGT_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (leftValue > rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BEQ_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue == rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BEQ_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (leftValue == rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BEQ_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (leftValue == rightValue) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (!(leftValue < rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGE_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (!(leftValue < rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BGE_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (!(leftValue < rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BLE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (!(leftValue > rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BLE_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (!(leftValue > rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BLE_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (!(leftValue > rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BNE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (!(leftValue == rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BNE_U64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64;
+                auto leftValue = sp[-2].u64;
+                if (!(leftValue == rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(BNE_F64) {
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].f64;
+                auto leftValue = sp[-2].f64;
+                if (!(leftValue == rightValue)) {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue + rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue + rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_F32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue - rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue - rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_F32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue * rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue * rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_F32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp--;
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(divideI32(leftValue, rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue / rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_F32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp--;
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(remainderI32(leftValue, rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                VM_CHECK_DIVISOR(rightValue);
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue % rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(NEG_I32) {
+                VM_CHECK_OPERANDS(1);
+                auto value = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(-value)));
+                VM_DISPATCH();
+            }
+            VM_CASE(NEG_F32) {
+                VM_CHECK_OPERANDS(1);
+                auto value = static_cast<float>(sp[-1].f64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<double>(-value));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64 & 31;
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue << rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64 & 31;
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue << rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_I32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64 & 31;
+                sp--;
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue >> rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_U32) {
+                VM_CHECK_OPERANDS(2);
+                auto rightValue = sp[-1].u64 & 31;
+                sp--;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue >> rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue + rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue + rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(ADD_F32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<float>(std::bit_cast<double>(instruction->operand));
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue - rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue - rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SUB_F32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<float>(std::bit_cast<double>(instruction->operand));
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue * rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue * rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MUL_F32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<float>(std::bit_cast<double>(instruction->operand));
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int32_t>(instruction->operand);
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(divideI32(leftValue, rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue / rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(DIV_F32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<float>(std::bit_cast<double>(instruction->operand));
+                auto leftValue = static_cast<float>(sp[-1].f64);
+                sp[-1] = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int32_t>(instruction->operand);
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(remainderI32(leftValue, rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(MOD_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::uint32_t>(instruction->operand);
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                VM_CHECK_DIVISOR(rightValue);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue % rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand & 31;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue << rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SL_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand & 31;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue << rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_I32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand & 31;
+                auto leftValue = static_cast<std::int32_t>(sp[-1].i64);
+                sp[-1] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue >> rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(SR_U32_IMM) {
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = instruction->operand & 31;
+                auto leftValue = static_cast<std::uint32_t>(sp[-1].u64);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue >> rightValue)));
+                VM_DISPATCH();
+            }
+            VM_CASE(RET) {
+                if constexpr (Policy::CHECKED) {
+                    if (frame == callFrameStack.data()) {
+                        fail("return without a matching call");
+                        goto LABEL_EXIT;
+                    }
+                }
+                next = base + frame->returnIndex;
+                bp = frame->savedBp;
+                frame--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_64) {
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(instruction->operand));
+                VM_DISPATCH();
+            }
+            VM_CASE(POP_64) {
+                VM_CHECK_OPERANDS(1);
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(COPY_64) {
+                VM_CHECK_OPERANDS(1);
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                auto value = sp[-1].u64;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value));
+                VM_DISPATCH();
+            }
+            VM_CASE(SWAP_64) {
+                VM_CHECK_OPERANDS(2);
+                auto value1 = sp[-1].u64;
+                sp--;
+                auto value2 = sp[-1].u64;
+                sp--;
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value1));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(value2));
+                VM_DISPATCH();
+            }
+            VM_CASE(FBP) {
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(bp));
+                VM_DISPATCH();
+            }
+            VM_CASE(LOCAL_ADDRESS) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(instruction->operand + bp));
+                next += 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_LOCAL_I32) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                std::int32_t loadValue;
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[instruction->operand + bp], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                next += 3;
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_LOCAL_I64) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                std::int64_t loadValue;
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[instruction->operand + bp], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                next += 3;
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_LOCAL_U64) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                std::uint64_t loadValue;
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[instruction->operand + bp], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                next += 3;
+                VM_DISPATCH();
+            }
+            VM_CASE(LOAD_LOCAL_F64) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                double loadValue;
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(loadValue));
+                std::memcpy(&loadValue, &dataArea[instruction->operand + bp], sizeof(loadValue));
+                *sp++ = OperandStackUnit(static_cast<double>(loadValue));
+                next += 3;
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_LOCAL_I32) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                // 要存储的常量是序列中第二条push_64指令的操作数
+                auto storeValue = static_cast<std::int32_t>(static_cast<std::int64_t>(instruction[3].operand));
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(storeValue));
+                std::memcpy(&dataArea[instruction->operand + bp], &storeValue, sizeof(storeValue));
+                next += 4;
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_LOCAL_I64) {
+                if (operandStackEnd - sp < 2) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                // 要存储的常量是序列中第二条push_64指令的操作数
+                auto storeValue = static_cast<std::int64_t>(static_cast<std::int64_t>(instruction[3].operand));
+                VM_CHECK_ADDRESS(instruction->operand + bp, sizeof(storeValue));
+                std::memcpy(&dataArea[instruction->operand + bp], &storeValue, sizeof(storeValue));
+                next += 4;
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_POP_I32) {
+                VM_CHECK_OPERANDS(3);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int32_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                sp--;
+                next += 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(STORE_POP_I64) {
+                VM_CHECK_OPERANDS(3);
+                auto value = sp[-1].i64;
+                sp--;
+                auto address = sp[-1].u64;
+                sp--;
+                auto storeValue = static_cast<std::int64_t>(value);
+                VM_CHECK_ADDRESS(address, sizeof(storeValue));
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                sp--;
+                next += 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(CMP_BRANCH_GT_I64) {
+                VM_CHECK_OPERANDS(2);
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue > rightValue) {
+                    next += 1;
+                } else {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(CMP_BRANCH_LT_I64) {
+                VM_CHECK_OPERANDS(2);
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue < rightValue) {
+                    next += 1;
+                } else {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
                 }
-                break;
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(CMP_BRANCH_EQ_I64) {
+                VM_CHECK_OPERANDS(2);
+                VM_CHECK_JUMP_TARGET(instruction->operand);
+                auto rightValue = sp[-1].i64;
+                auto leftValue = sp[-2].i64;
+                if (leftValue == rightValue) {
+                    next += 1;
+                } else {
+                    VM_CHARGE_FUEL(instruction->fuelCost);
+                    next = base + instruction->operand / 10;
+                }
+                sp -= 2;
+                VM_DISPATCH();
+            }
+            VM_CASE(POP_PUSH) {
+                VM_CHECK_OPERANDS(1);
+                sp[-1] = OperandStackUnit(static_cast<std::uint64_t>(instruction->operand));
+                next += 1;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BLT_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (leftValue < rightValue) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BGT_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (leftValue > rightValue) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BEQ_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (leftValue == rightValue) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BGE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (!(leftValue < rightValue)) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BLE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (!(leftValue > rightValue)) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(PUSH_BNE_I64) {
+                VM_CHECK_JUMP_TARGET(instruction[1].operand);
+                VM_CHECK_OPERANDS(1);
+                auto rightValue = static_cast<std::int64_t>(instruction->operand);
+                auto leftValue = sp[-1].i64;
+                if (!(leftValue == rightValue)) {
+                    VM_CHARGE_FUEL(instruction[1].fuelCost);
+                    next = base + instruction[1].operand / 10;
+                } else {
+                    next += 1;
+                }
+                sp--;
+                VM_DISPATCH();
+            }
+            VM_CASE(HLT) {
+                pc = next - base;
+                goto LABEL_EXIT;
+            }
+#if VM_COMPUTED_GOTO
+            LABEL_JIT_COUNT:
+            {
+                auto index = static_cast<std::uint64_t>(instruction - base);
+                if (jitCompiler->count(index)) {
+                    for (auto entryIndex : jitCompiler->compile(index)) {
+                        jitInstructionList[entryIndex].handler = &&LABEL_JIT_ENTER;
+                    }
+                    if (instruction->handler == &&LABEL_JIT_ENTER) {
+                        goto LABEL_JIT_ENTER;
+                    }
+                    // 编译失败或者不是入口时恢复原来的处理代码，不再计数
+                    auto opcodeValue = static_cast<std::size_t>(instruction->opcode);
+                    jitInstructionList[index].handler = opcodeValue < sizeof(handlerTable) / sizeof(handlerTable[0]) ? handlerTable[opcodeValue] : &&LABEL_INVALID;
+                }
+                auto opcodeValue = static_cast<std::size_t>(instruction->opcode);
+                goto *(opcodeValue < sizeof(handlerTable) / sizeof(handlerTable[0]) ? handlerTable[opcodeValue] : &&LABEL_INVALID);
+            }
+            LABEL_JIT_ENTER:
+            {
+                JitState state{reinterpret_cast<std::uint64_t *>(sp), reinterpret_cast<std::uint64_t *>(operandStackEnd), dataArea.data(), bp, 0, frame, callFrameStackEnd - 1, 0};
+                auto status = jitCompiler->enter(static_cast<std::uint64_t>(instruction - base), &state);
+                sp = reinterpret_cast<OperandStackUnit *>(state.sp);
+                bp = state.bp;
+                frame = static_cast<CallFrame *>(state.frame);
+                if (status == JitExitStatus::OPERAND_STACK_OVERFLOW) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                instruction = base + state.nextIndex;
+                next = instruction + 1;
+                if (status == JitExitStatus::RETURN && instruction->handler == &&LABEL_JIT_ENTER) {
+                    goto LABEL_JIT_ENTER;
+                }
+                // 本地代码不支持的指令由解释器直接执行原来的处理代码，即使该指令本身也是本地代码的入口
+                auto opcodeValue = static_cast<std::size_t>(instruction->opcode);
+                goto *(opcodeValue < sizeof(handlerTable) / sizeof(handlerTable[0]) ? handlerTable[opcodeValue] : &&LABEL_INVALID);
+            }
+            LABEL_INVALID:
+#else
+            default:
+#endif
+            {
+                fail("invalid instruction opcode: " + std::to_string(static_cast<short>(instruction->opcode)));
+                goto LABEL_EXIT;
+            }
+#if !VM_COMPUTED_GOTO
+        }
+    }
+#endif
+    // 停止执行、燃料耗尽和出错时都从这里退出，将局部变量中的栈顶、调用深度和剩余燃料写回，出错时执行的指令数才能按燃料正确累计
+    LABEL_EXIT:
+    this->sp = sp - operandStack.data();
+    callDepth = frame - callFrameStack.data();
+    this->fuel = fuel;
+}
+
+void VirtualMachine::runRegister() {
+    const RegisterInstruction *base = registerCode->instructionList.data();
+    const RegisterInstruction *next = base;
+    const RegisterInstruction *instruction;
+    OperandStackUnit *registers = registerFile.data();
+    OperandStackUnit *sp = operandStack.data() + this->sp; // 指向栈顶元素的下一个位置
+    OperandStackUnit *operandStackEnd = operandStack.data() + operandStack.size();
+    CallFrame *frame = callFrameStack.data() + callDepth; // 指向当前栈帧
+    CallFrame *callFrameStackEnd = callFrameStack.data() + callFrameStack.size();
+#if VM_COMPUTED_GOTO
+    static const void *const handlerTable[] = {
+                &&LABEL_ADD_I64,
+                &&LABEL_ADD_U64,
+                &&LABEL_ADD_F64,
+                &&LABEL_SUB_I64,
+                &&LABEL_SUB_U64,
+                &&LABEL_SUB_F64,
+                &&LABEL_MUL_I64,
+                &&LABEL_MUL_U64,
+                &&LABEL_MUL_F64,
+                &&LABEL_DIV_I64,
+                &&LABEL_DIV_U64,
+                &&LABEL_DIV_F64,
+                &&LABEL_MOD_I64,
+                &&LABEL_MOD_U64,
+                &&LABEL_NEG_I64,
+                &&LABEL_NEG_F64,
+                &&LABEL_SL_I64,
+                &&LABEL_SL_U64,
+                &&LABEL_SR_I64,
+                &&LABEL_SR_U64,
+                &&LABEL_ADD_I32,
+                &&LABEL_ADD_U32,
+                &&LABEL_ADD_F32,
+                &&LABEL_SUB_I32,
+                &&LABEL_SUB_U32,
+                &&LABEL_SUB_F32,
+                &&LABEL_MUL_I32,
+                &&LABEL_MUL_U32,
+                &&LABEL_MUL_F32,
+                &&LABEL_DIV_I32,
+                &&LABEL_DIV_U32,
+                &&LABEL_DIV_F32,
+                &&LABEL_MOD_I32,
+                &&LABEL_MOD_U32,
+                &&LABEL_NEG_I32,
+                &&LABEL_NEG_F32,
+                &&LABEL_SL_I32,
+                &&LABEL_SL_U32,
+                &&LABEL_SR_I32,
+                &&LABEL_SR_U32,
+                &&LABEL_AND_64,
+                &&LABEL_OR_64,
+                &&LABEL_NOT_64,
+                &&LABEL_XOR_64,
+                &&LABEL_TB_64,
+                &&LABEL_GT_I64,
+                &&LABEL_GT_U64,
+                &&LABEL_GT_F64,
+                &&LABEL_LT_I64,
+                &&LABEL_LT_U64,
+                &&LABEL_LT_F64,
+                &&LABEL_EQ_I64,
+                &&LABEL_EQ_U64,
+                &&LABEL_EQ_F64,
+                &&LABEL_CAST_I64_U64,
+                &&LABEL_CAST_I64_F64,
+                &&LABEL_CAST_U64_I64,
+                &&LABEL_CAST_U64_F64,
+                &&LABEL_CAST_F64_I64,
+                &&LABEL_CAST_F64_U64,
+                &&LABEL_LEA_BP,
+                &&LABEL_LOAD_I8,
+                &&LABEL_LOAD_I16,
+                &&LABEL_LOAD_I32,
+                &&LABEL_LOAD_I64,
+                &&LABEL_LOAD_U8,
+                &&LABEL_LOAD_U16,
+                &&LABEL_LOAD_U32,
+                &&LABEL_LOAD_U64,
+                &&LABEL_LOAD_F32,
+                &&LABEL_LOAD_F64,
+                &&LABEL_LOAD_BP_I8,
+                &&LABEL_LOAD_BP_I16,
+                &&LABEL_LOAD_BP_I32,
+                &&LABEL_LOAD_BP_I64,
+                &&LABEL_LOAD_BP_U8,
+                &&LABEL_LOAD_BP_U16,
+                &&LABEL_LOAD_BP_U32,
+                &&LABEL_LOAD_BP_U64,
+                &&LABEL_LOAD_BP_F32,
+                &&LABEL_LOAD_BP_F64,
+                &&LABEL_STORE_I8,
+                &&LABEL_STORE_I16,
+                &&LABEL_STORE_I32,
+                &&LABEL_STORE_I64,
+                &&LABEL_STORE_U8,
+                &&LABEL_STORE_U16,
+                &&LABEL_STORE_U32,
+                &&LABEL_STORE_U64,
+                &&LABEL_STORE_F32,
+                &&LABEL_STORE_F64,
+                &&LABEL_STORE_BP_I8,
+                &&LABEL_STORE_BP_I16,
+                &&LABEL_STORE_BP_I32,
+                &&LABEL_STORE_BP_I64,
+                &&LABEL_STORE_BP_U8,
+                &&LABEL_STORE_BP_U16,
+                &&LABEL_STORE_BP_U32,
+                &&LABEL_STORE_BP_U64,
+                &&LABEL_STORE_BP_F32,
+                &&LABEL_STORE_BP_F64,
+                &&LABEL_IN_I64,
+                &&LABEL_IN_U64,
+                &&LABEL_IN_F64,
+                &&LABEL_IN_S,
+                &&LABEL_OUT_I64,
+                &&LABEL_OUT_U64,
+                &&LABEL_OUT_F64,
+                &&LABEL_OUT_S,
+                &&LABEL_MEMCPY,
+                &&LABEL_MEMSET,
+                &&LABEL_MEMCMP,
+                &&LABEL_SQRT_F64,
+                &&LABEL_FABS_F64,
+                &&LABEL_FLOOR_F64,
+                &&LABEL_CEIL_F64,
+                &&LABEL_POW_F64,
+                &&LABEL_EXP_F64,
+                &&LABEL_LOG_F64,
+                &&LABEL_SIN_F64,
+                &&LABEL_COS_F64,
+                &&LABEL_MALLOC,
+                &&LABEL_FREE,
+                &&LABEL_REALLOC,
+                &&LABEL_POP,
+                &&LABEL_DROP,
+                &&LABEL_PUSH,
+                &&LABEL_PUSH_IMM,
+                &&LABEL_PUSH_BP,
+                &&LABEL_JMP,
+                &&LABEL_JMP_INDIRECT,
+                &&LABEL_JZ,
+                &&LABEL_JZ_INDIRECT,
+                &&LABEL_JNZ,
+                &&LABEL_JNZ_INDIRECT,
+                &&LABEL_CALL,
+                &&LABEL_CALL_INDIRECT,
+                &&LABEL_RET,
+                &&LABEL_HLT,
+    };
+    static_assert(sizeof(handlerTable) / sizeof(handlerTable[0]) == static_cast<std::size_t>(RegisterOpcode::HLT) + 1);
+    image->bindRegisterHandlers([](RegisterCode &registerCode) {
+        for (auto &registerInstruction : registerCode.instructionList) {
+            registerInstruction.handler = handlerTable[static_cast<std::size_t>(registerInstruction.opcode)];
+        }
+    });
+    VM_REGISTER_DISPATCH();
+#else
+    while (true) {
+        instruction = next++;
+        switch (instruction->opcode) {
+#endif
+            VM_REGISTER_CASE(ADD_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue + rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(ADD_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue + rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(ADD_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue - rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue - rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue * rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue * rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue / rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue / rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MOD_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue % rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MOD_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue % rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(NEG_I64) {
+                auto value = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(-value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(NEG_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(-value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SL_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue << rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SL_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue << rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SR_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(leftValue >> rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SR_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue >> rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(ADD_I32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue + rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(ADD_U32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue + rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(ADD_F32) {
+                auto rightValue = static_cast<float>(registers[instruction->source2].f64);
+                auto leftValue = static_cast<float>(registers[instruction->source1].f64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue + rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_I32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue - rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_U32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue - rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SUB_F32) {
+                auto rightValue = static_cast<float>(registers[instruction->source2].f64);
+                auto leftValue = static_cast<float>(registers[instruction->source1].f64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue - rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_I32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue * rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_U32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue * rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MUL_F32) {
+                auto rightValue = static_cast<float>(registers[instruction->source2].f64);
+                auto leftValue = static_cast<float>(registers[instruction->source1].f64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue * rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_I32) {
+                auto rightValue = static_cast<std::int32_t>(registers[instruction->source2].i64);
+                auto leftValue = static_cast<std::int32_t>(registers[instruction->source1].i64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(divideI32(leftValue, rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_U32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue / rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DIV_F32) {
+                auto rightValue = static_cast<float>(registers[instruction->source2].f64);
+                auto leftValue = static_cast<float>(registers[instruction->source1].f64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(leftValue / rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MOD_I32) {
+                auto rightValue = static_cast<std::int32_t>(registers[instruction->source2].i64);
+                auto leftValue = static_cast<std::int32_t>(registers[instruction->source1].i64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(remainderI32(leftValue, rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MOD_U32) {
+                auto rightValue = static_cast<std::uint32_t>(registers[instruction->source2].u64);
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue % rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(NEG_I32) {
+                auto value = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(-value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(NEG_F32) {
+                auto value = static_cast<float>(registers[instruction->source1].f64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(-value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SL_I32) {
+                auto rightValue = registers[instruction->source2].u64 & 31;
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue << rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SL_U32) {
+                auto rightValue = registers[instruction->source2].u64 & 31;
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue << rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SR_I32) {
+                auto rightValue = registers[instruction->source2].u64 & 31;
+                auto leftValue = static_cast<std::int32_t>(registers[instruction->source1].i64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(static_cast<std::int32_t>(leftValue >> rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SR_U32) {
+                auto rightValue = registers[instruction->source2].u64 & 31;
+                auto leftValue = static_cast<std::uint32_t>(registers[instruction->source1].u64);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(static_cast<std::uint32_t>(leftValue >> rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(AND_64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue & rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(OR_64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue | rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(NOT_64) {
+                auto value = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(~value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(XOR_64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue ^ rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(TB_64) {
+                auto value = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(value != static_cast<std::uint64_t>(0)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(GT_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(GT_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(GT_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue > rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LT_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LT_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LT_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue < rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(EQ_I64) {
+                auto rightValue = registers[instruction->source2].i64;
+                auto leftValue = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(EQ_U64) {
+                auto rightValue = registers[instruction->source2].u64;
+                auto leftValue = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(EQ_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(leftValue == rightValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_I64_U64) {
+                auto value = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_I64_F64) {
+                auto value = registers[instruction->source1].i64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_U64_I64) {
+                auto value = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_U64_F64) {
+                auto value = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_F64_I64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CAST_F64_U64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(value));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LEA_BP) {
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(bp + instruction->immediate));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_I8) {
+                auto address = registers[instruction->source1].u64;
+                std::int8_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_I8: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_I8) {
+                auto address = bp + instruction->immediate;
                 std::int8_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::int64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_I16: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_I16) {
+                auto address = registers[instruction->source1].u64;
                 std::int16_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::int64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_I32: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_I16) {
+                auto address = bp + instruction->immediate;
+                std::int16_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_I32) {
+                auto address = registers[instruction->source1].u64;
                 std::int32_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::int64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_I64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_I32) {
+                auto address = bp + instruction->immediate;
+                std::int32_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_I64) {
+                auto address = registers[instruction->source1].u64;
                 std::int64_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::int64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_U8: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_I64) {
+                auto address = bp + instruction->immediate;
+                std::int64_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_U8) {
+                auto address = registers[instruction->source1].u64;
+                std::uint8_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_BP_U8) {
+                auto address = bp + instruction->immediate;
                 std::uint8_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::uint64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_U16: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_U16) {
+                auto address = registers[instruction->source1].u64;
                 std::uint16_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::uint64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_U32: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_U16) {
+                auto address = bp + instruction->immediate;
+                std::uint16_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_U32) {
+                auto address = registers[instruction->source1].u64;
                 std::uint32_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::uint64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_U64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_U32) {
+                auto address = bp + instruction->immediate;
+                std::uint32_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_U64) {
+                auto address = registers[instruction->source1].u64;
+                std::uint64_t loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_BP_U64) {
+                auto address = bp + instruction->immediate;
                 std::uint64_t loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<std::uint64_t>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_F32) {
+                auto address = registers[instruction->source1].u64;
+                float loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_F32: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_BP_F32) {
+                auto address = bp + instruction->immediate;
                 float loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<double>(loadValue));
-                break;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(loadValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::LOAD_F64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(LOAD_F64) {
+                auto address = registers[instruction->source1].u64;
                 double loadValue;
                 std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
-                operandStack.emplace(static_cast<double>(loadValue));
-                break;
-            }
-            case Opcode::STORE_I8: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOAD_BP_F64) {
+                auto address = bp + instruction->immediate;
+                double loadValue;
+                std::memcpy(&loadValue, &dataArea[address], sizeof(loadValue));
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(loadValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_I8) {
+                auto value = registers[instruction->source2].i64;
+                auto address = registers[instruction->source1].u64;
                 auto storeValue = static_cast<std::int8_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_I16: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_I8) {
+                auto value = registers[instruction->source2].i64;
+                auto address = bp + instruction->immediate;
+                auto storeValue = static_cast<std::int8_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_I16) {
+                auto value = registers[instruction->source2].i64;
+                auto address = registers[instruction->source1].u64;
                 auto storeValue = static_cast<std::int16_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_I32: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_I16) {
+                auto value = registers[instruction->source2].i64;
+                auto address = bp + instruction->immediate;
+                auto storeValue = static_cast<std::int16_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_I32) {
+                auto value = registers[instruction->source2].i64;
+                auto address = registers[instruction->source1].u64;
+                auto storeValue = static_cast<std::int32_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_BP_I32) {
+                auto value = registers[instruction->source2].i64;
+                auto address = bp + instruction->immediate;
                 auto storeValue = static_cast<std::int32_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_I64: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_I64) {
+                auto value = registers[instruction->source2].i64;
+                auto address = registers[instruction->source1].u64;
                 auto storeValue = static_cast<std::int64_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_U8: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_I64) {
+                auto value = registers[instruction->source2].i64;
+                auto address = bp + instruction->immediate;
+                auto storeValue = static_cast<std::int64_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_U8) {
+                auto value = registers[instruction->source2].u64;
+                auto address = registers[instruction->source1].u64;
                 auto storeValue = static_cast<std::uint8_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_U16: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_U8) {
+                auto value = registers[instruction->source2].u64;
+                auto address = bp + instruction->immediate;
+                auto storeValue = static_cast<std::uint8_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_U16) {
+                auto value = registers[instruction->source2].u64;
+                auto address = registers[instruction->source1].u64;
+                auto storeValue = static_cast<std::uint16_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_BP_U16) {
+                auto value = registers[instruction->source2].u64;
+                auto address = bp + instruction->immediate;
                 auto storeValue = static_cast<std::uint16_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_U32) {
+                auto value = registers[instruction->source2].u64;
+                auto address = registers[instruction->source1].u64;
+                auto storeValue = static_cast<std::uint32_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_U32: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_U32) {
+                auto value = registers[instruction->source2].u64;
+                auto address = bp + instruction->immediate;
                 auto storeValue = static_cast<std::uint32_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_U64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_U64) {
+                auto value = registers[instruction->source2].u64;
+                auto address = registers[instruction->source1].u64;
                 auto storeValue = static_cast<std::uint64_t>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_F32: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_U64) {
+                auto value = registers[instruction->source2].u64;
+                auto address = bp + instruction->immediate;
+                auto storeValue = static_cast<std::uint64_t>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_F32) {
+                auto value = registers[instruction->source2].f64;
+                auto address = registers[instruction->source1].u64;
+                auto storeValue = static_cast<float>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_BP_F32) {
+                auto value = registers[instruction->source2].f64;
+                auto address = bp + instruction->immediate;
                 auto storeValue = static_cast<float>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(STORE_F64) {
+                auto value = registers[instruction->source2].f64;
+                auto address = registers[instruction->source1].u64;
+                auto storeValue = static_cast<double>(value);
+                std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::STORE_F64: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                auto address = operandStack.top().u64;
-                operandStack.pop();
+            VM_REGISTER_CASE(STORE_BP_F64) {
+                auto value = registers[instruction->source2].f64;
+                auto address = bp + instruction->immediate;
                 auto storeValue = static_cast<double>(value);
                 std::memcpy(&dataArea[address], &storeValue, sizeof(storeValue));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::IN_I64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                std::int64_t input;
-                std::cin >> input;
+            VM_REGISTER_CASE(IN_I64) {
+                auto address = registers[instruction->source1].u64;
+                outputBuffer.flush();
+                auto input = inputReader.readI64();
                 std::memcpy(&dataArea[address], &input, sizeof(input));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::IN_U64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                std::uint64_t input;
-                std::cin >> input;
+            VM_REGISTER_CASE(IN_U64) {
+                auto address = registers[instruction->source1].u64;
+                outputBuffer.flush();
+                auto input = inputReader.readU64();
                 std::memcpy(&dataArea[address], &input, sizeof(input));
-                break;
+                VM_REGISTER_DISPATCH();
             }
-            case Opcode::IN_F64: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                double input;
-                std::cin >> input;
+            VM_REGISTER_CASE(IN_F64) {
+                auto address = registers[instruction->source1].u64;
+                outputBuffer.flush();
+                auto input = inputReader.readF64();
                 std::memcpy(&dataArea[address], &input, sizeof(input));
-                break;
-            }
-            case Opcode::IN_S: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                std::cin.getline(reinterpret_cast<char *>(&dataArea[address]), (std::streamsize)(dataArea.size() - address));
-                break;
-            }
-            case Opcode::OUT_I64: {
-                auto value = operandStack.top().i64;
-                operandStack.pop();
-                std::cout << value;
-                break;
-            }
-            case Opcode::OUT_U64: {
-                auto value = operandStack.top().u64;
-                operandStack.pop();
-                std::cout << value;
-                break;
-            }
-            case Opcode::OUT_F64: {
-                auto value = operandStack.top().f64;
-                operandStack.pop();
-                std::cout << value;
-                break;
-            }
-            case Opcode::OUT_S: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                std::cout << reinterpret_cast<const char *>(&dataArea[address]);
-                break;
-            }
-            case Opcode::CALL: {
-                auto address = operandStack.top().u64;
-                operandStack.pop();
-                bp += memoryUseMap[callAddressStack.top()];
-                returnAddressStack.push(pc);
-                pc = address;
-                callAddressStack.push(pc);
-                break;
-            }
-            case Opcode::RET: {
-                callAddressStack.pop();
-                pc = returnAddressStack.top();
-                returnAddressStack.pop();
-                bp -= memoryUseMap[callAddressStack.top()];
-                break;
-            }
-            case Opcode::PUSH_64: {
-                operandStack.emplace(static_cast<std::uint64_t>(instruction.operand.u64));
-                break;
-            }
-            case Opcode::POP_64: {
-                operandStack.pop();
-                break;
-            }
-            case Opcode::COPY_64: {
-                auto value = operandStack.top().u64;
-                operandStack.emplace(static_cast<std::uint64_t>(value));
-                break;
-            }
-            case Opcode::SWAP_64: {
-                auto value1 = operandStack.top().u64;
-                operandStack.pop();
-                auto value2 = operandStack.top().u64;
-                operandStack.pop();
-                operandStack.emplace(static_cast<std::uint64_t>(value1));
-                operandStack.emplace(static_cast<std::uint64_t>(value2));
-                break;
-            }
-            case Opcode::FBP: {
-                operandStack.emplace(static_cast<std::uint64_t>(bp));
-                break;
-            }
-            case Opcode::HLT: {
-                return;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(IN_S) {
+                auto address = registers[instruction->source1].u64;
+                outputBuffer.flush();
+                inputReader.readLine(reinterpret_cast<char *>(&dataArea[address]), dataArea.available(address));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(OUT_I64) {
+                auto value = registers[instruction->source1].i64;
+                outputBuffer.writeI64(value);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(OUT_U64) {
+                auto value = registers[instruction->source1].u64;
+                outputBuffer.writeU64(value);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(OUT_F64) {
+                auto value = registers[instruction->source1].f64;
+                outputBuffer.writeF64(value);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(OUT_S) {
+                auto address = registers[instruction->source1].u64;
+                outputBuffer.writeString(reinterpret_cast<const char *>(&dataArea[address]));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MEMCPY) {
+                auto destination = registers[instruction->source1].u64;
+                auto source = registers[instruction->source2].u64;
+                auto size = registers[instruction->immediate].u64;
+                VM_REQUIRE_RANGE(source, size);
+                VM_REQUIRE_RANGE(destination, size);
+                std::memmove(&dataArea[destination], &dataArea[source], size);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MEMSET) {
+                auto destination = registers[instruction->source1].u64;
+                auto value = registers[instruction->source2].u64;
+                auto size = registers[instruction->immediate].u64;
+                VM_REQUIRE_RANGE(destination, size);
+                std::memset(&dataArea[destination], static_cast<unsigned char>(value), size);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MEMCMP) {
+                auto leftAddress = registers[instruction->source1].u64;
+                auto rightAddress = registers[instruction->source2].u64;
+                auto size = registers[instruction->immediate].u64;
+                VM_REQUIRE_RANGE(leftAddress, size);
+                VM_REQUIRE_RANGE(rightAddress, size);
+                auto result = size == 0 ? 0 : std::memcmp(&dataArea[leftAddress], &dataArea[rightAddress], size);
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::int64_t>((result > 0) - (result < 0)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SQRT_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::sqrt(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(FABS_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::fabs(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(FLOOR_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::floor(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CEIL_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::ceil(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(POW_F64) {
+                auto rightValue = registers[instruction->source2].f64;
+                auto leftValue = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::pow(leftValue, rightValue)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(EXP_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::exp(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(LOG_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::log(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(SIN_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::sin(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(COS_F64) {
+                auto value = registers[instruction->source1].f64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<double>(std::cos(value)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(MALLOC) {
+                auto size = registers[instruction->source1].u64;
+                registers[instruction->destination] = OperandStackUnit(static_cast<std::uint64_t>(heap.allocate(size)));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(FREE) {
+                auto address = registers[instruction->source1].u64;
+                if (!heap.release(address)) {
+                    reportInvalidHeapAddress(address);
+                    goto LABEL_EXIT;
+                }
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(REALLOC) {
+                auto address = registers[instruction->source1].u64;
+                auto size = registers[instruction->source2].u64;
+                std::uint64_t result;
+                if (!heap.reallocate(address, size, dataArea.data(), result)) {
+                    reportInvalidHeapAddress(address);
+                    goto LABEL_EXIT;
+                }
+                registers[instruction->destination] = OperandStackUnit(result);
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(POP) {
+                sp--;
+                registers[instruction->destination] = sp[0];
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(DROP) {
+                sp--;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(PUSH) {
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = registers[instruction->source1];
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(PUSH_IMM) {
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(instruction->immediate));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(PUSH_BP) {
+                if (sp == operandStackEnd) {
+                    reportOperandStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                *sp++ = OperandStackUnit(static_cast<std::uint64_t>(bp + instruction->immediate));
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(JMP) {
+                next = base + instruction->immediate;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(JMP_INDIRECT) {
+                auto address = registers[instruction->source1].u64;
+                auto entryIndex = registerEntryIndex(address);
+                if (entryIndex == RegisterCode::INVALID_ENTRY) {
+                    reportInvalidJumpTarget(address);
+                    goto LABEL_EXIT;
+                }
+                next = base + entryIndex;
+                VM_REGISTER_DISPATCH();
             }
+            VM_REGISTER_CASE(JZ) {
+                auto value = registers[instruction->source1].u64;
+                if (value == static_cast<std::uint64_t>(0)) {
+                    next = base + instruction->immediate;
+                }
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(JZ_INDIRECT) {
+                auto value = registers[instruction->source1].u64;
+                auto address = registers[instruction->source2].u64;
+                if (value == static_cast<std::uint64_t>(0)) {
+                    auto entryIndex = registerEntryIndex(address);
+                    if (entryIndex == RegisterCode::INVALID_ENTRY) {
+                        reportInvalidJumpTarget(address);
+                        goto LABEL_EXIT;
+                    }
+                    next = base + entryIndex;
+                }
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(JNZ) {
+                auto value = registers[instruction->source1].u64;
+                if (value != static_cast<std::uint64_t>(0)) {
+                    next = base + instruction->immediate;
+                }
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(JNZ_INDIRECT) {
+                auto value = registers[instruction->source1].u64;
+                auto address = registers[instruction->source2].u64;
+                if (value != static_cast<std::uint64_t>(0)) {
+                    auto entryIndex = registerEntryIndex(address);
+                    if (entryIndex == RegisterCode::INVALID_ENTRY) {
+                        reportInvalidJumpTarget(address);
+                        goto LABEL_EXIT;
+                    }
+                    next = base + entryIndex;
+                }
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CALL) {
+                if (frame + 1 == callFrameStackEnd) {
+                    reportCallStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                auto calleeIndex = instruction->immediate;
+                auto callerFrameSize = functionTable[frame->functionIndex].frameSize;
+                frame++;
+                *frame = {static_cast<std::uint64_t>(next - base), bp, calleeIndex};
+                bp += callerFrameSize;
+                next = base + registerCode->functionEntryIndexList[calleeIndex];
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(CALL_INDIRECT) {
+                auto address = registers[instruction->source1].u64;
+                if (frame + 1 == callFrameStackEnd) {
+                    reportCallStackOverflow();
+                    goto LABEL_EXIT;
+                }
+                auto calleeIndex = image->functionIndex(address);
+                if (calleeIndex == INVALID_FUNCTION_INDEX) {
+                    reportInvalidFunctionAddress(address);
+                    goto LABEL_EXIT;
+                }
+                auto callerFrameSize = functionTable[frame->functionIndex].frameSize;
+                frame++;
+                *frame = {static_cast<std::uint64_t>(next - base), bp, calleeIndex};
+                bp += callerFrameSize;
+                next = base + registerCode->functionEntryIndexList[calleeIndex];
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(RET) {
+                next = base + frame->returnIndex;
+                bp = frame->savedBp;
+                frame--;
+                VM_REGISTER_DISPATCH();
+            }
+            VM_REGISTER_CASE(HLT) {
+                goto LABEL_EXIT;
+            }
+#if !VM_COMPUTED_GOTO
             default: {
-                ErrorHandler::error("invalid instruction opcode: " + std::to_string(static_cast<short>(instruction.opcode)));
-                return;
+                fail("invalid register instruction opcode: " + std::to_string(static_cast<short>(instruction->opcode)));
+                goto LABEL_EXIT;
             }
         }
     }
+#endif
+    LABEL_EXIT:
+    this->sp = sp - operandStack.data();
+    callDepth = frame - callFrameStack.data();
 }
 
-void VirtualMachine::run(Bytecode *bytecode) {
-    VirtualMachine virtualMachine(bytecode);
-    virtualMachine.run();
+ExitStatus VirtualMachine::run() {
+    if (finished) {
+        return exitStatus;
+    }
+    exitStatus.reason = ExitReason::HALTED;
+    if (timeLimit != 0) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimit);
+    }
+    std::uint64_t faultAddress = 0;
+    bool completed = dataArea.guard([this] {
+        // 翻译失败时退回到栈式执行引擎
+        if (registerCode != nullptr) {
+            runRegister();
+        } else if (variant == InterpreterVariant::SAFE) {
+            if (opcodeProfiler != nullptr) {
+                interpret<ProfilingPolicy<SafePolicy>>();
+            } else if (fuelLimit != 0 || timeLimit != 0) {
+                interpret<MeteredPolicy<SafePolicy>>();
+            } else {
+                interpret<SafePolicy>();
+            }
+        } else {
+            if (opcodeProfiler != nullptr) {
+                interpret<ProfilingPolicy<FastPolicy>>();
+            } else if (fuelLimit != 0 || timeLimit != 0) {
+                interpret<MeteredPolicy<FastPolicy>>();
+            } else {
+                interpret<FastPolicy>();
+            }
+        }
+    }, faultAddress);
+    // 无论因为什么原因停止，已经执行的OUT_*指令的输出都要写入输出流
+    outputBuffer.flush();
+    if (!completed) {
+        fail("guest memory overflow at address " + std::to_string(faultAddress) + ", memory size: " + std::to_string(dataArea.size()));
+    }
+    // 当前燃料片中已消耗的部分还没有计入执行的指令数
+    exitStatus.fuelUsed += fuelSliceSize - fuel;
+    fuelSliceSize = fuel;
+    exitStatus.heapStatistics = heap.getStatistics();
+    if (exitStatus.reason == ExitReason::HALTED) {
+        finished = true;
+    }
+    return exitStatus;
+}
+
+void VirtualMachine::addFuel(std::uint64_t amount) {
+    if (fuelLimit != 0) {
+        fuelLimit += amount;
+    }
+}
+
+const OpcodeProfiler *VirtualMachine::getOpcodeProfiler() const {
+    return opcodeProfiler.get();
+}
+
+ExitStatus VirtualMachine::run(Bytecode *bytecode, const VirtualMachineConfig &config) {
+    // 字节码由调用者负责释放
+    auto image = ProgramImage::load(std::shared_ptr<const Bytecode>(bytecode, [](const Bytecode *) {}), config);
+    VirtualMachine virtualMachine(image, std::cin, std::cout);
+    auto exitStatus = virtualMachine.run();
+    if (config.heapStatistics) {
+        const auto &statistics = exitStatus.heapStatistics;
+        std::cout << std::flush;
+        std::cerr << "[HEAP] allocations: " << statistics.allocationCount << ", frees: " << statistics.freeCount << ", failed: " << statistics.failedCount
+                  << ", live bytes: " << statistics.liveBytes << ", peak live bytes: " << statistics.peakLiveBytes << ", peak heap bytes: " << statistics.peakHeapBytes << std::endl;
+        // 只输出使用过的size class，run的字节数与存活的字节数之差就是这个size class占用但没有使用的空间
+        for (std::uint32_t i = 0; i < HeapStatistics::SIZE_CLASS_COUNT; i++) {
+            const auto &classStatistics = statistics.sizeClassList[i];
+            if (classStatistics.peakReservedBytes != 0) {
+                std::cerr << "[HEAP] size class " << GuestHeap::sizeOfClass(i) << ": live bytes: " << classStatistics.liveBytes << ", run bytes: " << classStatistics.reservedBytes
+                          << ", peak live bytes: " << classStatistics.peakLiveBytes << ", peak run bytes: " << classStatistics.peakReservedBytes << std::endl;
+            }
+        }
+    }
+    if (virtualMachine.getOpcodeProfiler() != nullptr) {
+        std::cout << std::flush;
+        virtualMachine.getOpcodeProfiler()->print(std::cerr);
+    }
+    return exitStatus;
 }
@@ -1,11 +1,24 @@
 #pragma once
 
-#include <map>
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <vector>
-#include <stack>
 #include <string>
 #include "../bytecode/Bytecode.h"
 #include "../instruction/Instruction.h"
+#include "DecodedInstruction.h"
+#include "RegisterTranslator.h"
+#include "../jit/JitCompiler.h"
+#include "GuestHeap.h"
+#include "GuestMemory.h"
+#include "InputReader.h"
+#include "LazyArray.h"
+#include "OpcodeProfiler.h"
+#include "OutputBuffer.h"
+#include "ProgramImage.h"
+#include "VirtualMachineConfig.h"
 
 /**
  * 操作数栈的元素。
@@ -22,22 +35,119 @@ union OperandStackUnit {
     explicit OperandStackUnit(double f64) : f64(f64) {}
 };
 
+/**
+ * 调用栈帧。
+ */
+struct CallFrame {
+    std::uint64_t returnIndex; // 函数返回后继续执行的指令的索引
+    std::uint64_t savedBp; // 调用者的bp，函数返回时直接恢复
+    std::uint64_t functionIndex; // 被调用函数的编号
+};
+
+static_assert(sizeof(CallFrame) == 24, "JIT生成的本地代码按固定的布局读写调用栈帧");
+
+/**
+ * 虚拟机停止执行的原因。
+ */
+enum class ExitReason {
+    HALTED, // 执行了hlt指令
+    FUEL_EXHAUSTED, // 消耗的燃料达到上限
+    DEADLINE_EXCEEDED, // 执行时间达到上限
+    ERROR, // 加载或执行时出错
+};
 
+/**
+ * 虚拟机停止执行时的状态。
+ */
+struct ExitStatus {
+    ExitReason reason = ExitReason::HALTED;
+    std::uint64_t fuelUsed = 0; // 消耗的燃料，是抽象的计量单位，不是执行的指令数
+    std::string errorMessage; // 出错时的错误信息
+    HeapStatistics heapStatistics; // 堆的分配统计
+};
+
+/**
+ * 虚拟机。
+ * 代码、函数表和数据区的初始内容都保存在共享的只读程序映像中，每个实例只拥有自己的数据区、操作数栈、调用栈和输入输出流，
+ * 因此可以由同一个映像创建多个实例，并在不同的线程中同时执行，但同一个实例同时只能在一个线程中执行。
+ * 数据区、操作数栈和调用栈都只在访问到时才分配物理内存，数据区中的初始内容以写时复制的方式与映像共享。
+ * 加载和执行时的错误都通过返回的ExitStatus报告，不会终止进程。
+ */
 class VirtualMachine {
 private:
-    std::map<std::uint64_t, std::uint64_t> memoryUseMap;
-    std::vector<std::uint8_t> codeArea;
-    std::vector<std::uint8_t> dataArea;
-    std::uint64_t pc; // 下一条指令的地址
+    static constexpr std::uint64_t FUEL_SLICE_SIZE = 64 * 1024; // 每次发放的燃料，即两次检查执行时间之间消耗的燃料
+    static constexpr std::uint64_t BLOCK_FUEL_BYTES = 64; // 内存块操作每处理多少字节消耗一个燃料
+
+    std::shared_ptr<const ProgramImage> image;
+    const std::vector<FunctionTableEntry> &functionTable;
+    const std::vector<std::uint32_t> &functionFuelCostList; // 调用每个函数时消耗的燃料
+    const std::vector<DecodedInstruction> *instructionList; // 预解码后的代码区，启用JIT时指向jitInstructionList，否则指向映像中为当前解释循环绑定的共享副本
+    const RegisterCode *registerCode; // 映像中的寄存器式代码，仅在使用寄存器式执行引擎且翻译成功时非空
+    GuestMemory dataArea;
+    GuestHeap heap; // 管理数据区中堆区的分配器
+    std::uint64_t pc; // 下一条指令在instructionList中的索引
     std::uint64_t bp; // 当前基地址
-    std::stack<OperandStackUnit> operandStack;
-    std::stack<std::uint64_t> callAddressStack;
-    std::stack<std::uint64_t> returnAddressStack;
+    LazyArray<OperandStackUnit> operandStack; // 预先分配好容量的连续操作数栈
+    std::uint64_t sp; // 栈顶元素的下一个位置在operandStack中的索引
+    LazyArray<CallFrame> callFrameStack; // 预先分配好容量的连续调用栈，第0个栈帧对应全局区
+    std::uint64_t callDepth; // 当前栈帧在callFrameStack中的索引
+    std::vector<OperandStackUnit> registerFile;
+    std::vector<DecodedInstruction> jitInstructionList; // 启用JIT时实例私有的指令副本，计数点和本地代码入口的处理代码会被替换
+    std::unique_ptr<JitCompiler> jitCompiler; // JIT编译器，仅在启用JIT且平台支持时非空
+    std::uint64_t fuelLimit; // 最多消耗的燃料，0表示不限制
+    std::uint64_t fuel; // 当前燃料片中剩余的燃料
+    std::uint64_t fuelSliceSize; // 当前燃料片的大小
+    std::uint64_t timeLimit; // 每次执行的最长时间，单位为毫秒，0表示不限制
+    std::chrono::steady_clock::time_point deadline;
+    InterpreterVariant variant;
+    InputReader inputReader; // IN_*指令的输入读取器，成块地读取输入流
+    OutputBuffer outputBuffer; // OUT_*指令的输出缓冲区，执行停止或者读取输入之前写入输出流
+    std::unique_ptr<OpcodeProfiler> opcodeProfiler; // 操作码统计，仅在开启-prof-ops时非空
+    bool finished; // 是否已经执行了hlt指令或者出错，此后不能继续执行
+    ExitStatus exitStatus;
 
 private:
-    explicit VirtualMachine(Bytecode *bytecode);
-    void run();
+    void fail(const std::string &message);
+    void reportOperandStackOverflow();
+    void reportCallStackOverflow();
+    void reportOperandStackUnderflow();
+    void reportInvalidAddress(std::uint64_t address);
+    void reportInvalidHeapAddress(std::uint64_t address);
+    void reportInvalidFunctionAddress(std::uint64_t address);
+    void reportInvalidJumpTarget(std::uint64_t address);
+    std::uint32_t registerEntryIndex(std::uint64_t address);
+    bool refuel(std::uint64_t cost);
+    template<typename Policy>
+    void interpret();
+    void runRegister();
 
 public:
-    static void run(Bytecode *bytecode);
+    /**
+     * 由程序映像创建虚拟机，运行参数为加载映像时的参数，IN_*指令从input读取，OUT_*指令写入output。
+     * 输入输出流在虚拟机的生命周期内必须有效，输入流由虚拟机成块读取，其他代码不能再从中读取。加载和创建时的错误在第一次调用run时返回。
+     */
+    VirtualMachine(std::shared_ptr<const ProgramImage> programImage, std::istream &input, std::ostream &output);
+    VirtualMachine(const VirtualMachine &) = delete;
+    VirtualMachine &operator=(const VirtualMachine &) = delete;
+
+    /**
+     * 执行字节码直到hlt指令、燃料耗尽、超时或者出错，返回停止的原因和累计执行的指令数。
+     * 因燃料耗尽或超时而停止后可以再次调用，从停止的位置继续执行，燃料的上限对所有调用累计，执行时间的上限对每次调用单独计算。
+     */
+    ExitStatus run();
+
+    /**
+     * 增加燃料的上限，用于燃料耗尽后继续执行。
+     */
+    void addFuel(std::uint64_t amount);
+
+    /**
+     * 操作码统计，没有开启时为空。
+     */
+    [[nodiscard]] const OpcodeProfiler *getOpcodeProfiler() const;
+
+    /**
+     * 使用标准输入输出执行字节码，出错时错误信息在返回的ExitStatus中，由调用者报告。
+     */
+    static ExitStatus run(Bytecode *bytecode, const VirtualMachineConfig &config);
 };
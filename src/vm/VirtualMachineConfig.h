@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * 虚拟机的执行引擎。
+ */
+enum class ExecutionEngine {
+    STACK, // 直接解释执行栈式指令
+    REGISTER, // 先将栈式指令翻译为寄存器式指令再解释执行
+};
+
+/**
+ * 栈式执行引擎的解释器版本。
+ */
+enum class InterpreterVariant {
+    FAST, // 不做任何运行时检查
+    SAFE, // 检查操作数栈下溢、内存越界、除数为0和非法跳转目标，总是使用栈式执行引擎且不启用JIT
+};
+
+/**
+ * 虚拟机的运行参数。
+ */
+struct VirtualMachineConfig {
+    std::uint64_t operandStackCapacity = 1024 * 1024; // 操作数栈的容量，单位为栈元素个数
+    std::uint64_t maxCallDepth = 1024 * 1024; // 调用栈的最大深度，调用栈只在访问到时才分配物理内存，上限只用于及时发现无穷递归
+    std::uint64_t memorySize = 64 * 1024 * 1024; // 数据区的大小，单位为字节，包括全局区和所有函数的栈帧
+    std::uint64_t heapSize = 64 * 1024 * 1024; // 堆区的大小，单位为字节，由malloc、free和realloc管理
+    ExecutionEngine engine = ExecutionEngine::STACK; // 执行引擎
+    InterpreterVariant variant = InterpreterVariant::FAST; // 解释器版本
+    bool jit = false; // 是否将热点函数编译为本地代码，启用时总是使用栈式执行引擎
+    std::uint64_t jitThreshold = 100; // 函数入口或循环回跳目标执行多少次后编译所在的函数
+    bool superinstructions = true; // 是否在加载时融合超级指令，只对栈式执行引擎的解释器有效
+    std::uint64_t fuel = 0; // 最多消耗的燃料，0表示不限制，设置时总是使用栈式执行引擎且不启用JIT
+    std::uint64_t timeLimit = 0; // 最长执行时间，单位为毫秒，0表示不限制，设置时总是使用栈式执行引擎且不启用JIT
+    bool lineBufferedOutput = false; // 是否在输出换行后立即刷新输出，用于交互式执行，默认只在缓冲区写满、执行停止或者读取输入之前刷新
+    bool heapStatistics = false; // 是否在执行结束后输出堆的分配统计
+    bool opcodeProfile = false; // 是否统计每种操作码的执行次数和抽样耗时并在执行结束后输出，设置时总是使用栈式执行引擎且不启用JIT
+};
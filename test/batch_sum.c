@@ -0,0 +1,13 @@
+int main() {
+    long long n = 0;
+    scan_i64(&n);
+    long long sum = 0;
+    for (long long i = 1; i <= n; i++) {
+        sum = sum + i * i;
+    }
+    print_i64(n);
+    print_s(" ");
+    print_i64(sum);
+    print_s("\n");
+    return 0;
+}
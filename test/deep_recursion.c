@@ -0,0 +1,12 @@
+int depth(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return depth(n - 1) + 1;
+}
+
+int main() {
+    print_i64(depth(100000));
+    print_s("\n");
+    return 0;
+}
@@ -0,0 +1,95 @@
+char *blocks[128];
+char *smallBlocks[65536];
+
+long long fillHeap(long long size) {
+    long long count = 0;
+    while (count < 128) {
+        char *block = (char *) malloc(size);
+        if (block == 0) {
+            return count;
+        }
+        block[0] = (char) count;
+        block[size - 1] = (char) count;
+        blocks[count] = block;
+        count++;
+    }
+    return count;
+}
+
+void freeBlocks(long long count) {
+    for (long long i = 0; i < count; i++) {
+        free(blocks[i]);
+    }
+}
+
+long long checksum(char *p, long long n) {
+    long long sum = 0;
+    for (long long i = 0; i < n; i++) {
+        sum = sum + p[i];
+    }
+    return sum;
+}
+
+int main() {
+    // 小块在size class内原地缩小，增长到大块时移动内容
+    char *p = (char *) malloc(100);
+    for (long long i = 0; i < 100; i++) {
+        p[i] = (char) i;
+    }
+    char *q = (char *) realloc(p, 60);
+    print_i64(q == p);
+    print_s(" ");
+    print_i64(checksum(q, 60));
+    print_s("\n");
+    p = (char *) realloc(q, 20000);
+    print_i64(checksum(p, 60));
+    print_s("\n");
+    // 大块向后面的空闲页扩展，然后在原地缩小
+    for (long long i = 60; i < 20000; i++) {
+        p[i] = (char) (i % 7);
+    }
+    q = (char *) realloc(p, 100000);
+    print_i64(q == p);
+    print_s(" ");
+    print_i64(checksum(q, 20000));
+    print_s("\n");
+    p = (char *) realloc(q, 30000);
+    print_i64(q == p);
+    print_s(" ");
+    print_i64(checksum(p, 20000));
+    print_s("\n");
+    // realloc(0, n)等同于malloc，realloc(p, 0)和free(0)
+    q = (char *) realloc(0, 16);
+    q[15] = (char) 42;
+    print_i64(q[15]);
+    print_s("\n");
+    print_i64(realloc(q, 0) == 0);
+    print_s("\n");
+    free(p);
+    free(0);
+    // 堆区为64 MiB，超过堆区的请求和堆区耗尽后的请求都返回0，原来的块保持不变
+    print_i64(malloc(100000000) == 0);
+    print_s("\n");
+    long long count = fillHeap(1048576);
+    print_i64(count);
+    print_s(" ");
+    print_i64(malloc(1048576) == 0);
+    print_s(" ");
+    print_i64(realloc(blocks[0], 2097152) == 0);
+    print_s(" ");
+    print_i64(blocks[0][0] + blocks[count - 1][1048575]);
+    print_s("\n");
+    freeBlocks(count);
+    // 64个run中的小块全部释放后，除了当前正在切分的run都归还给页分配器
+    for (long long i = 0; i < 65536; i++) {
+        smallBlocks[i] = (char *) malloc(64);
+    }
+    for (long long i = 0; i < 65536; i++) {
+        free(smallBlocks[i]);
+    }
+    count = fillHeap(1048576);
+    print_i64(count);
+    print_s("\n");
+    freeBlocks(count);
+    return 0;
+}
@@ -0,0 +1,39 @@
+int divide_i32(int left, int right) {
+    return left / right;
+}
+
+int remainder_i32(int left, int right) {
+    return left % right;
+}
+
+int main() {
+    int minimum = -2147483647 - 1;
+    int divisor = -1;
+    for (int i = 0; i < 3; i++) {
+        print_i64(divide_i32(minimum, divisor));
+        print_s(" ");
+        print_i64(remainder_i32(minimum, divisor));
+        print_s("\n");
+    }
+    print_i64(minimum / divisor);
+    print_s(" ");
+    print_i64(minimum % divisor);
+    print_s("\n");
+    int quotient = minimum;
+    quotient /= divisor;
+    int remainder = minimum;
+    remainder %= divisor;
+    print_i64(quotient);
+    print_s(" ");
+    print_i64(remainder);
+    print_s("\n");
+    print_i64(divide_i32(7, -2));
+    print_s(" ");
+    print_i64(remainder_i32(-7, 2));
+    print_s(" ");
+    print_i64(divide_i32(minimum, 2));
+    print_s(" ");
+    print_i64(remainder_i32(minimum, 3));
+    print_s("\n");
+    return 0;
+}
@@ -0,0 +1,75 @@
+long long fib(long long n) {
+    if (n < 2) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+
+long long depth(long long n) {
+    if (n == 0) {
+        return 0;
+    }
+    return depth(n - 1) + 1;
+}
+
+long long twice(long long x) {
+    return x * 2;
+}
+
+long long argument = 0;
+
+long long doubled() {
+    return twice(argument) + fib(argument % 10);
+}
+
+long long squared() {
+    return argument * argument;
+}
+
+long long apply(long long (*function)(), long long x) {
+    argument = x;
+    return function();
+}
+
+long long countdown(long long n) {
+    if (n == 0) {
+        print_s("\n");
+        return 0;
+    }
+    print_i64(n);
+    print_s(" ");
+    return countdown(n - 1) + n;
+}
+
+long long mixed(long long a, long long b) {
+    long long local = a * 3;
+    return a * 1000 + fib(b) + depth(b) * 7 - twice(local) + local;
+}
+
+int main() {
+    long long total = 0;
+    for (long long i = 0; i < 25; i++) {
+        total = total + fib(i);
+    }
+    print_i64(total);
+    print_s("\n");
+    print_i64(fib(27));
+    print_s("\n");
+    print_i64(depth(300000));
+    print_s("\n");
+    long long (*functions[2])() = {doubled, squared};
+    long long sum = 0;
+    for (long long i = 0; i < 1000; i++) {
+        sum = sum + apply(functions[i % 2], i) + twice(i);
+    }
+    print_i64(sum);
+    print_s("\n");
+    print_i64(countdown(10));
+    print_s("\n");
+    for (long long i = 0; i < 5; i++) {
+        print_i64(mixed(i, i + 10));
+        print_s(" ");
+    }
+    print_s("\n");
+    return 0;
+}
@@ -0,0 +1,34 @@
+void printValue(double value) {
+    print_f64(value);
+    print_s("\n");
+}
+
+int main() {
+    printValue(sqrt(2.0));
+    printValue(sqrt(144.0));
+    printValue(fabs(0.0 - 3.5));
+    printValue(fabs(2.25));
+    printValue(floor(0.0 - 2.5));
+    printValue(floor(7.9));
+    printValue(ceil(0.0 - 2.5));
+    printValue(ceil(7.1));
+    printValue(pow(2.0, 10.0));
+    printValue(pow(9.0, 0.5));
+    printValue(exp(0.0));
+    printValue(exp(1.0));
+    printValue(log(1.0));
+    printValue(log(exp(2.0)));
+    printValue(sin(0.0));
+    printValue(cos(0.0));
+    printValue(sin(3.14159265358979 / 2));
+    // 整数参数按照调用约定隐式转换为double
+    long long n = 49;
+    printValue(sqrt(n));
+    printValue(pow(n, 2));
+    double sum = 0;
+    for (long long i = 1; i <= 1000; i++) {
+        sum = sum + sqrt(i) * fabs(sin(i)) + floor(i / 3.0) - ceil(i / 7.0);
+    }
+    printValue(sum);
+    return 0;
+}
@@ -0,0 +1,72 @@
+char bytes[64];
+int numbers[32];
+char left[16];
+char right[16];
+
+void printBytes(long long begin, long long end) {
+    for (long long i = begin; i < end; i++) {
+        print_i64(bytes[i]);
+        print_s(" ");
+    }
+    print_s("\n");
+}
+
+int main() {
+    for (long long i = 0; i < 64; i++) {
+        bytes[i] = (char) i;
+    }
+    // 目的在源之后的重叠复制，结果与先把源复制到临时缓冲区相同
+    mem_copy(bytes + 4, bytes, 16);
+    printBytes(0, 24);
+    // 目的在源之前的重叠复制
+    for (long long i = 0; i < 64; i++) {
+        bytes[i] = (char) i;
+    }
+    mem_copy(bytes, bytes + 4, 16);
+    printBytes(0, 24);
+    // 长度为0时什么也不做
+    mem_copy(bytes, bytes + 32, 0);
+    mem_set(bytes, 99, 0);
+    printBytes(0, 4);
+    mem_set(bytes + 8, 7, 10);
+    printBytes(6, 20);
+    for (long long i = 0; i < 32; i++) {
+        numbers[i] = (int) (i * 1000);
+    }
+    mem_copy(numbers + 1, numbers, 31 * 4);
+    print_i64(numbers[0]);
+    print_s(" ");
+    print_i64(numbers[1]);
+    print_s(" ");
+    print_i64(numbers[31]);
+    print_s("\n");
+    mem_set(numbers, 255, 8);
+    print_i64(numbers[0]);
+    print_s(" ");
+    print_i64(numbers[1]);
+    print_s(" ");
+    print_i64(numbers[2]);
+    print_s("\n");
+    // mem_cmp的结果只有-1、0和1，按无符号字节比较
+    for (long long i = 0; i < 16; i++) {
+        left[i] = (char) i;
+        right[i] = (char) i;
+    }
+    print_i64(mem_cmp(left, right, 16));
+    print_s(" ");
+    right[10] = (char) 100;
+    print_i64(mem_cmp(left, right, 16));
+    print_s(" ");
+    print_i64(mem_cmp(right, left, 16));
+    print_s(" ");
+    print_i64(mem_cmp(left, right, 10));
+    print_s(" ");
+    left[3] = (char) 200;
+    print_i64(mem_cmp(left, right, 16));
+    print_s(" ");
+    print_i64(mem_cmp(right, left, 16));
+    print_s(" ");
+    print_i64(mem_cmp(left, right, 0));
+    print_s("\n");
+    return 0;
+}
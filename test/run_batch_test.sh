@@ -0,0 +1,38 @@
+#!/bin/sh
+# 用法：run_batch_test.sh <cc> <test> [vm_options]
+# 编译<test>.c，以多个只有扩展名不同的输入文件批量执行，检查每个输出文件都与单独执行该输入时的标准输出相同，标准输出中没有汇总信息
+cc=$1
+test=$2
+shift 2
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+"$cc" -cl "$test.c" -o "$work/test.bin" || exit 1
+mkdir "$work/inputs"
+count=0
+for name in 1 1.in 1.txt 2.in 2.txt 3 10.in 100.txt 1000 12345.in; do
+    echo "${name%%.*}" > "$work/inputs/$name"
+    count=$((count + 1))
+done
+"$cc" -vm "$work/test.bin" -batch "$work/inputs" -j 4 "$@" > "$work/stdout" 2> "$work/stderr"
+status=$?
+if [ $status -ne 0 ]; then
+    cat "$work/stderr"
+    echo "exit status: $status"
+    exit 1
+fi
+if [ -s "$work/stdout" ]; then
+    echo "unexpected output on stdout:"
+    cat "$work/stdout"
+    exit 1
+fi
+grep -q "^inputs: $count," "$work/stderr" || { cat "$work/stderr"; exit 1; }
+if [ "$(ls "$work/inputs.out" | wc -l)" -ne $count ]; then
+    echo "expected $count output files:"
+    ls "$work/inputs.out"
+    exit 1
+fi
+for input in "$work"/inputs/*; do
+    name=$(basename "$input")
+    "$cc" -vm "$work/test.bin" "$@" < "$input" > "$work/expected" || exit 1
+    diff "$work/expected" "$work/inputs.out/$name.out" || { echo "output of $name differs"; exit 1; }
+done
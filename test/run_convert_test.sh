@@ -0,0 +1,26 @@
+#!/bin/sh
+# 用法：run_convert_test.sh <cc> <test> [vm_options]
+# 将版本1的<test>.bin转换为版本2，再次转换得到的文件必须逐字节相同，转换前后执行的标准输出都与<test>.out相同
+cc=$1
+test=$2
+shift 2
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+"$cc" -convert "$test.bin" "$work/v2.bin" > "$work/convert.log" || exit 1
+if ! grep -q "(version 1, .*(version 2, " "$work/convert.log"; then
+    cat "$work/convert.log"
+    echo "not converted from version 1 to version 2"
+    exit 1
+fi
+"$cc" -convert "$work/v2.bin" "$work/v2_again.bin" > /dev/null || exit 1
+cmp "$work/v2.bin" "$work/v2_again.bin" || exit 1
+for bytecode in "$test.bin" "$work/v2.bin"; do
+    "$cc" -vm "$bytecode" "$@" < /dev/null > "$work/output"
+    status=$?
+    if [ $status -ne 0 ]; then
+        cat "$work/output"
+        echo "exit status: $status"
+        exit 1
+    fi
+    diff "$test.out" "$work/output" || exit 1
+done
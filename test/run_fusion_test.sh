@@ -0,0 +1,33 @@
+#!/bin/sh
+# 用法：run_fusion_test.sh <cc> <test> [vm_options]
+# 编译<test>.c，分别在融合与不融合超级指令时使用-prof-ops执行，两次的标准输出都与<test>.out相同，且融合后执行的指令数更少并出现超级指令
+cc=$1
+test=$2
+shift 2
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+"$cc" -cl "$test.c" -o "$work/test.bin" || exit 1
+for mode in fused unfused; do
+    option=
+    if [ $mode = unfused ]; then
+        option=-no-superinstr
+    fi
+    "$cc" -vm "$work/test.bin" -prof-ops $option "$@" < /dev/null > "$work/$mode.stdout" 2> "$work/$mode.stderr"
+    status=$?
+    if [ $status -ne 0 ]; then
+        cat "$work/$mode.stdout"
+        echo "exit status: $status"
+        exit 1
+    fi
+    diff "$test.out" "$work/$mode.stdout" || exit 1
+done
+fused=$(sed -n 's/^\[PROF\] instructions: \([0-9]*\),.*/\1/p' "$work/fused.stderr")
+unfused=$(sed -n 's/^\[PROF\] instructions: \([0-9]*\),.*/\1/p' "$work/unfused.stderr")
+if [ -z "$fused" ] || [ -z "$unfused" ] || [ "$fused" -ge "$unfused" ]; then
+    echo "instructions: fused $fused, unfused $unfused"
+    exit 1
+fi
+if ! grep -q "^\[PROF\] load_local_i64 " "$work/fused.stderr" || grep -q "^\[PROF\] load_local_i64 " "$work/unfused.stderr"; then
+    echo "superinstructions not fused as expected"
+    exit 1
+fi
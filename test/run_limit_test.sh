@@ -0,0 +1,24 @@
+#!/bin/sh
+# 用法：run_limit_test.sh <cc> <test> <status> <reason> [vm_options]
+# 编译并执行<test>.c，检查退出码为<status>、标准错误中的停止原因为<reason>，并将停止前的标准输出与<test>.out比较
+cc=$1
+test=$2
+expected=$3
+reason=$4
+shift 4
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+"$cc" -cl "$test.c" -o "$work/test.bin" || exit 1
+"$cc" -vm "$work/test.bin" "$@" < /dev/null > "$work/stdout" 2> "$work/stderr"
+status=$?
+if [ $status -ne "$expected" ]; then
+    cat "$work/stderr"
+    echo "exit status: $status, expected: $expected"
+    exit 1
+fi
+if ! grep -q "reason: $reason," "$work/stderr"; then
+    cat "$work/stderr"
+    echo "missing reason: $reason"
+    exit 1
+fi
+diff "$test.out" "$work/stdout"
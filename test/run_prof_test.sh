@@ -0,0 +1,33 @@
+#!/bin/sh
+# 用法：run_prof_test.sh <cc> <test> [vm_options]
+# 编译并使用-prof-ops执行<test>.c，标准输出与<test>.out相同，标准错误中的直方图各操作码的次数之和等于总指令数，且hlt恰好执行一次
+cc=$1
+test=$2
+shift 2
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+"$cc" -cl "$test.c" -o "$work/test.bin" || exit 1
+input=/dev/null
+if [ -f "$test.in" ]; then
+    input=$test.in
+fi
+"$cc" -vm "$work/test.bin" -prof-ops "$@" < "$input" > "$work/stdout" 2> "$work/stderr"
+status=$?
+if [ $status -ne 0 ]; then
+    cat "$work/stdout"
+    echo "exit status: $status"
+    exit 1
+fi
+diff "$test.out" "$work/stdout" || exit 1
+total=$(sed -n 's/^\[PROF\] instructions: \([0-9]*\),.*/\1/p' "$work/stderr")
+sum=$(awk '$1 == "[PROF]" && $3 ~ /^[0-9]+$/ { sum += $3 } END { print sum + 0 }' "$work/stderr")
+if [ -z "$total" ] || [ "$total" -eq 0 ] || [ "$total" -ne "$sum" ]; then
+    cat "$work/stderr"
+    echo "instructions: $total, sum of counts: $sum"
+    exit 1
+fi
+if ! grep -q "^\[PROF\] opcode " "$work/stderr" || ! grep -Eq "^\[PROF\] hlt +1 " "$work/stderr"; then
+    cat "$work/stderr"
+    echo "malformed histogram"
+    exit 1
+fi
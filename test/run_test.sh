@@ -0,0 +1,26 @@
+#!/bin/sh
+# 用法：run_test.sh <cc> <test> [vm_options]
+# 编译并执行<test>.c，没有源文件时直接执行预先编译好的<test>.bin，标准输入为<test>.in（不存在时为空），将标准输出与<test>.out比较
+cc=$1
+test=$2
+shift 2
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+if [ -f "$test.c" ]; then
+    "$cc" -cl "$test.c" -o "$work/test.bin" || exit 1
+    bytecode=$work/test.bin
+else
+    bytecode=$test.bin
+fi
+input=/dev/null
+if [ -f "$test.in" ]; then
+    input=$test.in
+fi
+"$cc" -vm "$bytecode" "$@" < "$input" > "$work/output"
+status=$?
+if [ $status -ne 0 ]; then
+    cat "$work/output"
+    echo "exit status: $status"
+    exit 1
+fi
+diff "$test.out" "$work/output"
@@ -0,0 +1,12 @@
+long long step(long long x) {
+    return x * 3 + 1;
+}
+
+int main() {
+    print_s("started\n");
+    long long x = 0;
+    while (1) {
+        x = step(x) % 1000003;
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+long long weights[16];
+
+long long score(long long n) {
+    long long total = 0;
+    int count = 0;
+    for (long long i = 0; i < n; i++) {
+        if (i % 3 == 0) {
+            count = count + 1;
+        }
+        if (i > 5 && i < n - 5) {
+            total = total + weights[i % 16] * i;
+        }
+        weights[i % 16] = weights[i % 16] + count;
+    }
+    return total + count;
+}
+
+int main() {
+    print_i64(score(100000));
+    print_s("\n");
+    double sum = 0;
+    for (int i = 0; i < 1000; i++) {
+        sum = sum + (double) i / 2;
+    }
+    print_f64(sum);
+    print_s("\n");
+    return 0;
+}